@@ -0,0 +1,71 @@
+# all.tcl --
+#
+# This file contains a top-level script to run all of the [incr Tcl]
+# micro benchmarks.  Each *.bench file in this directory registers its
+# benchmarks with the "bench" command below.  Execute it with
+# "make bench" or "tclsh all.tcl ?-match pattern? ?-iterations n?".
+#
+# See the file "license.terms" for information on usage and redistribution
+# of this file, and for a DISCLAIMER OF ALL WARRANTIES.
+
+package prefer latest
+
+package require Tcl 8.6
+
+namespace eval ::itclbench {
+    variable match *
+    variable iterations 100000
+    variable load {}
+}
+
+foreach {option value} $argv {
+    switch -- $option {
+        -match      { set ::itclbench::match $value }
+        -iterations { set ::itclbench::iterations $value }
+        -load       { set ::itclbench::load $value }
+        default     { return -code error "unknown option \"$option\"" }
+    }
+}
+uplevel #0 $::itclbench::load
+package require itcl
+
+# ----------------------------------------------------------------------
+#  bench name ?-iterations n? ?-setup script? ?-cleanup script? body
+#
+#  Runs "body" n times in the global namespace and reports the mean
+#  time per iteration in microseconds.
+# ----------------------------------------------------------------------
+proc ::itclbench::bench {name args} {
+    variable match
+    variable iterations
+
+    set body [lindex $args end]
+    set opts [dict merge [list -iterations $iterations -setup {} \
+	    -cleanup {}] [lrange $args 0 end-1]]
+    if {![string match $match $name]} {
+        return
+    }
+    uplevel #0 [dict get $opts -setup]
+    # warm up caches and byte code before timing
+    uplevel #0 [list time $body 10]
+    set usec [lindex [uplevel #0 \
+	    [list time $body [dict get $opts -iterations]]] 0]
+    uplevel #0 [dict get $opts -cleanup]
+    puts [format "%-48s %12.3f us" $name $usec]
+}
+
+# ----------------------------------------------------------------------
+#  report label value
+#
+#  Prints an additional figure that is not a timing, e.g. a size.
+# ----------------------------------------------------------------------
+proc ::itclbench::report {label value} {
+    puts [format "%-48s %12s" $label $value]
+}
+
+puts "\[incr Tcl\] [package present itcl] benchmarks, Tcl [info patchlevel]"
+foreach file [lsort [glob -directory [file dirname [info script]] *.bench]] {
+    puts "\n[file tail $file]"
+    namespace eval ::itclbench [list source $file]
+}
+return
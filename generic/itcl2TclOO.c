@@ -28,6 +28,15 @@ Itcl_NRRunCallbacks(
     return TclNRRunCallbacks(interp, TCL_OK, rootPtr);
 }
 
+int
+Itcl_NRRunCallbacksResult(
+    Tcl_Interp *interp,
+    int result,
+    void *rootPtr)
+{
+    return TclNRRunCallbacks(interp, result, rootPtr);
+}
+
 static int
 CallFinalizePMCall(
     ClientData data[],
@@ -391,3 +400,31 @@ Itcl_IncrObjectRefCount(Tcl_Object ptr) {
   Object * oPtr = (Object *) ptr;
   oPtr->refCount++;
 }
+
+/* storage of a TclOO object, its namespace and commands, for itcl::memory */
+size_t
+Itcl_TclOOObjectSize(
+    Tcl_Object object)
+{
+    Object *oPtr = (Object *)object;
+    size_t size;
+
+    size = sizeof(Object);
+    if (oPtr->methodsPtr != NULL) {
+        size += sizeof(Tcl_HashTable) + Itcl_HashTableSize(oPtr->methodsPtr)
+	        + oPtr->methodsPtr->numEntries * sizeof(Method);
+    }
+    if (oPtr->metadataPtr != NULL) {
+        size += sizeof(Tcl_HashTable) + Itcl_HashTableSize(oPtr->metadataPtr);
+    }
+    if (oPtr->chainCache != NULL) {
+        size += sizeof(Tcl_HashTable) + Itcl_HashTableSize(oPtr->chainCache);
+    }
+    if (oPtr->namespacePtr != NULL) {
+        size += Itcl_NamespaceSize(oPtr->namespacePtr);
+    }
+    if (oPtr->command != NULL) {
+        size += sizeof(Command);
+    }
+    return size;
+}
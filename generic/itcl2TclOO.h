@@ -11,6 +11,8 @@ typedef int (TclOO_PostCallProc)(ClientData clientData, Tcl_Interp *interp,
 #endif
 
 MODULE_SCOPE int Itcl_NRRunCallbacks(Tcl_Interp *interp, void *rootPtr);
+MODULE_SCOPE int Itcl_NRRunCallbacksResult(Tcl_Interp *interp, int result,
+        void *rootPtr);
 MODULE_SCOPE void * Itcl_GetCurrentCallbackPtr(Tcl_Interp *interp);
 MODULE_SCOPE Tcl_Method Itcl_NewProcClassMethod(Tcl_Interp *interp, Tcl_Class clsPtr,
         TclOO_PreCallProc *preCallPtr, TclOO_PostCallProc *postCallPtr,
@@ -32,3 +34,4 @@ MODULE_SCOPE int Itcl_InvokeEnsembleMethod(Tcl_Interp *interp, Tcl_Namespace *ns
 MODULE_SCOPE int Itcl_InvokeProcedureMethod(ClientData clientData, Tcl_Interp *interp,
 	int objc, Tcl_Obj *const *objv);
 MODULE_SCOPE void Itcl_IncrObjectRefCount(Tcl_Object ptr);
+MODULE_SCOPE size_t Itcl_TclOOObjectSize(Tcl_Object object);
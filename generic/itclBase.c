@@ -112,6 +112,8 @@ static ItclCmdsInfo itclCmds [] = {
     { "::itcl::find", ITCL_IS_ENSEMBLE},
     { "::itcl::delete", ITCL_IS_ENSEMBLE},
     { "::itcl::is", ITCL_IS_ENSEMBLE},
+    { "::itcl::deferred", ITCL_IS_ENSEMBLE},
+    { "::itcl::memory", ITCL_IS_ENSEMBLE},
     { "::itcl::filter", ITCL_IS_ENSEMBLE},
     { "::itcl::forward", ITCL_IS_ENSEMBLE},
     { "::itcl::import::stub", ITCL_IS_ENSEMBLE},
@@ -136,7 +138,7 @@ static ItclCmdsInfo itclCmds [] = {
 extern void RegisterDebugCFunctions( Tcl_Interp * interp);
 #endif
 
-static const Tcl_ObjectMetadataType objMDT = {
+const Tcl_ObjectMetadataType itclObjectMetadataType = {
     TCL_OO_METADATA_VERSION_CURRENT,
     "ItclObject",
     ItclDeleteObjectMetadata,	/* Not really used yet */
@@ -162,7 +164,7 @@ RootCallProc(
     Tcl_Obj *const *objv)
 {
     Tcl_Object oPtr = Tcl_ObjectContextObject(context);
-    ItclObject *ioPtr = Tcl_ObjectGetMetadata(oPtr, &objMDT);
+    ItclObject *ioPtr = Tcl_ObjectGetMetadata(oPtr, &itclObjectMetadataType);
     ItclRootMethodProc *proc = (ItclRootMethodProc *)clientData;
 
     return (*proc)(ioPtr, interp, objc, objv);
@@ -212,6 +214,7 @@ Initialize (
     char *res_option;
     int opt;
     int isNew;
+    int i;
     Tcl_Object clazzObjectPtr, root;
     Tcl_Obj *objPtr, *resPtr;
 
@@ -271,7 +274,7 @@ Initialize (
     infoPtr->class_meta_type->deleteProc = ItclDeleteClassMetadata;
     infoPtr->class_meta_type->cloneProc = NULL;
 
-    infoPtr->object_meta_type = &objMDT;
+    infoPtr->object_meta_type = &itclObjectMetadataType;
 
     Tcl_InitHashTable(&infoPtr->objects, TCL_ONE_WORD_KEYS);
     Tcl_InitHashTable(&infoPtr->objectCmds, TCL_ONE_WORD_KEYS);
@@ -280,7 +283,6 @@ Initialize (
     Tcl_InitHashTable(&infoPtr->namespaceClasses, TCL_ONE_WORD_KEYS);
     Tcl_InitHashTable(&infoPtr->procMethods, TCL_ONE_WORD_KEYS);
     Tcl_InitHashTable(&infoPtr->instances, TCL_STRING_KEYS);
-    Tcl_InitHashTable(&infoPtr->frameContext, TCL_ONE_WORD_KEYS);
     Tcl_InitObjHashTable(&infoPtr->classTypes);
     infoPtr->ensembleInfo = (EnsembleInfo *)ckalloc(sizeof(EnsembleInfo));
     memset(infoPtr->ensembleInfo, 0, sizeof(EnsembleInfo));
@@ -292,21 +294,23 @@ Initialize (
     infoPtr->buildingWidget = 0;
     infoPtr->typeDestructorArgumentPtr = Tcl_NewStringObj("", -1);
     Tcl_IncrRefCount(infoPtr->typeDestructorArgumentPtr);
+    infoPtr->myPtr = Tcl_NewStringObj("my", 2);
+    Tcl_IncrRefCount(infoPtr->myPtr);
     infoPtr->lastIoPtr = NULL;
+    Itcl_InitList(&infoPtr->deferredObjects);
+    infoPtr->deferredBudget = ITCL_DEFERRED_BUDGET;
+    Tcl_InitObjHashTable(&infoPtr->emptyObjectTable);
 
-    Tcl_SetVar(interp, ITCL_NAMESPACE"::internal::dicts::classes", "", 0);
     Tcl_SetVar(interp, ITCL_NAMESPACE"::internal::dicts::objects", "", 0);
-    Tcl_SetVar(interp, ITCL_NAMESPACE"::internal::dicts::classOptions", "", 0);
-    Tcl_SetVar(interp,
-            ITCL_NAMESPACE"::internal::dicts::classDelegatedOptions", "", 0);
-    Tcl_SetVar(interp,
-            ITCL_NAMESPACE"::internal::dicts::classComponents", "", 0);
-    Tcl_SetVar(interp,
-            ITCL_NAMESPACE"::internal::dicts::classVariables", "", 0);
-    Tcl_SetVar(interp,
-            ITCL_NAMESPACE"::internal::dicts::classFunctions", "", 0);
-    Tcl_SetVar(interp,
-            ITCL_NAMESPACE"::internal::dicts::classDelegatedFunctions", "", 0);
+    Tcl_TraceVar2(interp, ITCL_NAMESPACE"::internal::dicts::objects", NULL,
+            TCL_GLOBAL_ONLY|TCL_TRACE_READS|TCL_TRACE_WRITES,
+            ItclObjectsDictTrace, infoPtr);
+    for (i = ITCL_DICT_INFO_CLASS; i <= ITCL_DICT_INFO_DELEGATED_FUNCTION;
+            i++) {
+        Tcl_SetVar(interp, ItclDictInfoVarNames[i], "", 0);
+        Tcl_TraceVar2(interp, ItclDictInfoVarNames[i], NULL,
+                TCL_GLOBAL_ONLY|TCL_TRACE_READS, ItclClassDictsTrace, infoPtr);
+    }
 
     hPtr = Tcl_CreateHashEntry(&infoPtr->classTypes,
             (char *)Tcl_NewStringObj("class", -1), &isNew);
@@ -331,6 +335,10 @@ Initialize (
 	opt = atoi(res_option);
     }
     infoPtr->useOldResolvers = opt;
+    res_option = getenv("ITCL_LAZY_VARS");
+    if (res_option != NULL) {
+	infoPtr->lazyVars = atoi(res_option);
+    }
     Itcl_InitStack(&infoPtr->clsStack);
 
     Tcl_SetAssocData(interp, ITCL_INTERP_DATA, NULL, (ClientData)infoPtr);
@@ -638,6 +646,7 @@ ItclFinishCmd(
     if (infoPtr == NULL) {
         infoPtr = (ItclObjectInfo *)clientData;
     }
+    ItclCancelDeferredDeletions(infoPtr);
     checkMemoryLeaks = 0;
     if (objc > 1) {
         if (strcmp(Tcl_GetString(objv[1]), "checkmemoryleaks") == 0) {
@@ -687,6 +696,22 @@ ItclFinishCmd(
     }
     Tcl_DeleteHashTable(&infoPtr->instances);
 
+    Tcl_UntraceVar2(interp, ITCL_NAMESPACE"::internal::dicts::objects", NULL,
+            TCL_GLOBAL_ONLY|TCL_TRACE_READS|TCL_TRACE_WRITES,
+            ItclObjectsDictTrace, infoPtr);
+    for (i = ITCL_DICT_INFO_CLASS; i <= ITCL_DICT_INFO_DELEGATED_FUNCTION;
+            i++) {
+        Tcl_UntraceVar2(interp, ItclDictInfoVarNames[i], NULL,
+                TCL_GLOBAL_ONLY|TCL_TRACE_READS, ItclClassDictsTrace, infoPtr);
+    }
+    if (infoPtr->dictInfos != NULL) {
+        ckfree((char *)infoPtr->dictInfos);
+        infoPtr->dictInfos = NULL;
+        infoPtr->numDictInfos = 0;
+        infoPtr->maxDictInfos = 0;
+        infoPtr->numDeadDictInfos = 0;
+    }
+
     while (1) {
         hPtr = Tcl_FirstHashEntry(&infoPtr->classTypes, &place);
 	if (hPtr == NULL) {
@@ -702,6 +727,7 @@ ItclFinishCmd(
     Tcl_DeleteHashTable(&infoPtr->classes);
     Tcl_DeleteHashTable(&infoPtr->nameClasses);
     Tcl_DeleteHashTable(&infoPtr->namespaceClasses);
+    Tcl_DeleteHashTable(&infoPtr->emptyObjectTable);
 
     nsPtr = Tcl_FindNamespace(interp, "::itcl::parser", NULL, 0);
     if (nsPtr != NULL) {
@@ -745,6 +771,7 @@ ItclFinishCmd(
     }
 
     Tcl_DecrRefCount(infoPtr->typeDestructorArgumentPtr);
+    Tcl_DecrRefCount(infoPtr->myPtr);
 
     Tcl_EvalEx(infoPtr->interp,
             "::oo::define ::itcl::clazz deletemethod unknown", -1, 0);
@@ -769,6 +796,7 @@ ItclFinishCmd(
     if (nsPtr != NULL) {
         Tcl_DeleteNamespace(nsPtr);
     }
+    ItclFinishBuiltinAliases(infoPtr->interp, infoPtr);
     nsPtr = Tcl_FindNamespace(infoPtr->interp, "::itcl", NULL, 0);
     if (nsPtr != NULL) {
         Tcl_DeleteNamespace(nsPtr);
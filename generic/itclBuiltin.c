@@ -103,6 +103,8 @@ static Tcl_ObjCmdProc Itcl_BiInitOptionsCmd;
  */
 static Tcl_Obj* ItclReportPublicOpt(Tcl_Interp *interp,
     ItclVariable *ivPtr, ItclObject *contextIoPtr);
+static ItclVarLookup* ItclFindPublicOpt(ItclClass *iclsPtr,
+    const char *token);
 
 static Tcl_ObjCmdProc ItclBiClassUnknownCmd;
 /*
@@ -259,6 +261,43 @@ static const BiMethod BiMethodList[] = {
 };
 static int BiMethodListLen = sizeof(BiMethodList)/sizeof(BiMethod);
 
+/*
+ *  Commands standing for the "@itcl-builtin-*" names used in the
+ *  bodies of builtin methods, see ItclFindBuiltinAlias().
+ *  "@itcl-builtin-setget" also covers all names it is a prefix of.
+ */
+static const struct {
+    const char *alias;
+    const char *commandName;
+} BiAliasList[] = {
+    { "@itcl-builtin-cget", "::itcl::builtin::cget" },
+    { "@itcl-builtin-configure", "::itcl::builtin::configure" },
+    { "@itcl-builtin-destroy", "::itcl::builtin::destroy" },
+    { "@itcl-builtin-setget", "::itcl::builtin::setget" },
+    { "@itcl-builtin-isa", "::itcl::builtin::isa" },
+    { "@itcl-builtin-createhull", "::itcl::builtin::createhull" },
+    { "@itcl-builtin-keepcomponentoption",
+            "::itcl::builtin::keepcomponentoption" },
+    { "@itcl-builtin-ignorecomponentoption",
+            "::itcl::builtin::removecomponentoption" },
+    { "@itcl-builtin-irgnorecomponentoption",
+            "::itcl::builtin::ignorecomponentoption" },
+    { "@itcl-builtin-setupcomponent", "::itcl::builtin::setupcomponent" },
+    { "@itcl-builtin-initoptions", "::itcl::builtin::initoptions" },
+    { "@itcl-builtin-mytypemethod", "::itcl::builtin::mytypemethod" },
+    { "@itcl-builtin-mymethod", "::itcl::builtin::mymethod" },
+    { "@itcl-builtin-myproc", "::itcl::builtin::myproc" },
+    { "@itcl-builtin-mytypevar", "::itcl::builtin::mytypevar" },
+    { "@itcl-builtin-myvar", "::itcl::builtin::myvar" },
+    { "@itcl-builtin-itcl_hull", "::itcl::builtin::itcl_hull" },
+    { "@itcl-builtin-callinstance", "::itcl::builtin::callinstance" },
+    { "@itcl-builtin-getinstancevar", "::itcl::builtin::getinstancevar" },
+    { "@itcl-builtin-classunknown", "::itcl::builtin::classunknown" },
+    { NULL, NULL }
+};
+
+static Tcl_CommandTraceProc BuiltinAliasTraceProc;
+
 
 /*
  * ------------------------------------------------------------------------
@@ -289,6 +328,22 @@ Itcl_BiInit(
      *  These commands are imported into each class
      *  just before the class definition is parsed.
      */
+    Tcl_InitHashTable(&infoPtr->builtinAliases, TCL_STRING_KEYS);
+    for (i=0; BiAliasList[i].alias != NULL; i++) {
+        ItclBuiltinAlias *aliasPtr;
+        Tcl_HashEntry *hPtr;
+        int isNew;
+
+        aliasPtr = (ItclBuiltinAlias *)ckalloc(sizeof(ItclBuiltinAlias));
+        aliasPtr->commandName = BiAliasList[i].commandName;
+        aliasPtr->cmd = NULL;
+        aliasPtr->infoPtr = infoPtr;
+        hPtr = Tcl_CreateHashEntry(&infoPtr->builtinAliases,
+                BiAliasList[i].alias, &isNew);
+        Tcl_SetHashValue(hPtr, aliasPtr);
+    }
+    infoPtr->builtinAliasesInitted = 1;
+
     Tcl_DStringInit(&buffer);
     for (i=0; i < BiMethodListLen; i++) {
 	Tcl_DStringSetLength(&buffer, 0);
@@ -348,6 +403,116 @@ Itcl_BiInit(
     return TCL_OK;
 }
 
+/*
+ * ------------------------------------------------------------------------
+ *  ItclFindBuiltinAlias()
+ *
+ *  Returns the command standing for an "@itcl-builtin-*" name, or
+ *  NULL if "cmdName" is no such name or the command does not exist.
+ *  The token is cached until the command is renamed or deleted, so
+ *  this costs at most one hash lookup.
+ * ------------------------------------------------------------------------
+ */
+Tcl_Command
+ItclFindBuiltinAlias(
+    Tcl_Interp *interp,         /* current interpreter */
+    ItclObjectInfo *infoPtr,    /* info for all known objects */
+    const char *cmdName)        /* command name being resolved */
+{
+    Tcl_HashEntry *hPtr;
+    ItclBuiltinAlias *aliasPtr;
+
+    if ((*cmdName != '@') || !infoPtr->builtinAliasesInitted) {
+        return NULL;
+    }
+    hPtr = Tcl_FindHashEntry(&infoPtr->builtinAliases, cmdName);
+    if (hPtr == NULL) {
+        if (strncmp(cmdName, "@itcl-builtin-setget", 20) != 0) {
+            return NULL;
+        }
+        hPtr = Tcl_FindHashEntry(&infoPtr->builtinAliases,
+                "@itcl-builtin-setget");
+    }
+    aliasPtr = (ItclBuiltinAlias *)Tcl_GetHashValue(hPtr);
+    if (aliasPtr->cmd == NULL) {
+        aliasPtr->cmd = Tcl_FindCommand(interp, aliasPtr->commandName,
+                NULL, 0);
+        if (aliasPtr->cmd != NULL) {
+            Tcl_TraceCommand(interp, aliasPtr->commandName,
+                    TCL_TRACE_RENAME|TCL_TRACE_DELETE,
+                    BuiltinAliasTraceProc, aliasPtr);
+        }
+    }
+    return aliasPtr->cmd;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  BuiltinAliasTraceProc()
+ *
+ *  Invoked when the command cached for a builtin alias is renamed or
+ *  deleted.  Drops the cached token, so that the next lookup finds
+ *  whatever command has the name by then.
+ * ------------------------------------------------------------------------
+ */
+static void
+BuiltinAliasTraceProc(
+    ClientData clientData,      /* the ItclBuiltinAlias */
+    Tcl_Interp *interp,         /* current interpreter */
+    const char *oldName,        /* command name before the change */
+    const char *newName,        /* new name, or NULL/"" if deleted */
+    int flags)                  /* TCL_TRACE_RENAME or TCL_TRACE_DELETE */
+{
+    ItclBuiltinAlias *aliasPtr = (ItclBuiltinAlias *)clientData;
+
+    aliasPtr->cmd = NULL;
+    if ((flags & TCL_TRACE_RENAME) && (newName != NULL) && (*newName)) {
+        Tcl_UntraceCommand(interp, newName,
+                TCL_TRACE_RENAME|TCL_TRACE_DELETE,
+                BuiltinAliasTraceProc, aliasPtr);
+    }
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclFinishBuiltinAliases()
+ *
+ *  Removes the traces of all cached builtin alias commands and frees
+ *  the alias table.  Called when [incr Tcl] is torn down.
+ * ------------------------------------------------------------------------
+ */
+void
+ItclFinishBuiltinAliases(
+    Tcl_Interp *interp,         /* current interpreter */
+    ItclObjectInfo *infoPtr)    /* info for all known objects */
+{
+    Tcl_HashEntry *hPtr;
+    Tcl_HashSearch place;
+    ItclBuiltinAlias *aliasPtr;
+    Tcl_Obj *namePtr;
+
+    if (!infoPtr->builtinAliasesInitted) {
+        return;
+    }
+    infoPtr->builtinAliasesInitted = 0;
+    hPtr = Tcl_FirstHashEntry(&infoPtr->builtinAliases, &place);
+    while (hPtr != NULL) {
+        aliasPtr = (ItclBuiltinAlias *)Tcl_GetHashValue(hPtr);
+        if (aliasPtr->cmd != NULL) {
+            namePtr = Tcl_NewObj();
+            Tcl_IncrRefCount(namePtr);
+            Tcl_GetCommandFullName(interp, aliasPtr->cmd, namePtr);
+            Tcl_UntraceCommand(interp, Tcl_GetString(namePtr),
+                    TCL_TRACE_RENAME|TCL_TRACE_DELETE,
+                    BuiltinAliasTraceProc, aliasPtr);
+            Tcl_DecrRefCount(namePtr);
+        }
+        ckfree((char *)aliasPtr);
+        hPtr = Tcl_NextHashEntry(&place);
+    }
+    Tcl_DeleteHashTable(&infoPtr->builtinAliases);
+}
+
 
 /*
  * ------------------------------------------------------------------------
@@ -371,7 +536,7 @@ Itcl_InstallBiMethods(
     int result = TCL_OK;
 
     int i;
-    ItclHierIter hier;
+    int hierIdx;
     ItclClass *superPtr;
 
     /*
@@ -387,17 +552,14 @@ Itcl_InstallBiMethods(
     for (i=0; i < BiMethodListLen; i++) {
 	Tcl_HashEntry *hPtr = NULL;
 
-        Itcl_InitHierIter(&hier, iclsPtr);
 	Tcl_SetStringObj(objPtr, BiMethodList[i].name, -1);
-        superPtr = Itcl_AdvanceHierIter(&hier);
-        while (superPtr) {
+        for (hierIdx = 0; hierIdx < iclsPtr->numHierarchy; hierIdx++) {
+            superPtr = iclsPtr->hierarchy[hierIdx];
             hPtr = Tcl_FindHashEntry(&superPtr->functions, (char *)objPtr);
             if (hPtr) {
                 break;
             }
-            superPtr = Itcl_AdvanceHierIter(&hier);
         }
-        Itcl_DeleteHierIter(&hier);
 
         if (!hPtr) {
 	    if (iclsPtr->flags & BiMethodList[i].flags) {
@@ -533,8 +695,6 @@ Itcl_BiConfigureCmd(
 
     Tcl_Obj *resultPtr;
     Tcl_Obj *objPtr;
-    Tcl_DString buffer;
-    Tcl_DString buffer2;
     Tcl_HashSearch place;
     Tcl_HashEntry *hPtr;
     Tcl_Namespace *saveNsPtr;
@@ -543,11 +703,11 @@ Itcl_BiConfigureCmd(
     ItclVariable *ivPtr;
     ItclVarLookup *vlookup;
     ItclMemberCode *mcode;
-    ItclHierIter hier;
+    int hierIdx;
     ItclObjectInfo *infoPtr;
-    const char *lastval;
+    Tcl_Obj *valuePtr;
+    Tcl_Obj *lastvalPtr;
     const char *token;
-    char *varName;
     int i;
     int unparsedObjc;
     int result;
@@ -556,10 +716,9 @@ Itcl_BiConfigureCmd(
     vlookup = NULL;
     token = NULL;
     hPtr = NULL;
+    lastvalPtr = NULL;
     unparsedObjc = objc;
     unparsedObjv = objv;
-    Tcl_DStringInit(&buffer);
-    Tcl_DStringInit(&buffer2);
 
     /*
      *  Make sure that this command is being invoked in the proper
@@ -609,8 +768,8 @@ Itcl_BiConfigureCmd(
     if (unparsedObjc == 1) {
         resultPtr = Tcl_NewListObj(0, (Tcl_Obj**)NULL);
 
-        Itcl_InitHierIter(&hier, contextIclsPtr);
-        while ((iclsPtr=Itcl_AdvanceHierIter(&hier)) != NULL) {
+        for (hierIdx = 0; hierIdx < contextIclsPtr->numHierarchy; hierIdx++) {
+            iclsPtr = contextIclsPtr->hierarchy[hierIdx];
             hPtr = Tcl_FirstHashEntry(&iclsPtr->variables, &place);
             while (hPtr) {
                 ivPtr = (ItclVariable*)Tcl_GetHashValue(hPtr);
@@ -623,7 +782,6 @@ Itcl_BiConfigureCmd(
                 hPtr = Tcl_NextHashEntry(&place);
             }
         }
-        Itcl_DeleteHierIter(&hier);
 
         Tcl_SetObjResult(interp, resultPtr);
         return TCL_OK;
@@ -642,15 +800,7 @@ Itcl_BiConfigureCmd(
                 return TCL_ERROR;
             }
 
-            vlookup = NULL;
-            hPtr = Tcl_FindHashEntry(&contextIclsPtr->resolveVars, token+1);
-            if (hPtr) {
-                vlookup = (ItclVarLookup*)Tcl_GetHashValue(hPtr);
-
-                if (vlookup->ivPtr->protection != ITCL_PUBLIC) {
-                    vlookup = NULL;
-                }
-            }
+            vlookup = ItclFindPublicOpt(contextIclsPtr, token);
             if (!vlookup) {
                 Tcl_AppendStringsToObj(Tcl_GetObjResult(interp),
                     "unknown option \"", token, "\"",
@@ -684,16 +834,10 @@ Itcl_BiConfigureCmd(
         vlookup = NULL;
         token = Tcl_GetString(unparsedObjv[i]);
         if (*token == '-') {
-            hPtr = Tcl_FindHashEntry(&contextIclsPtr->resolveVars, token+1);
-            if (hPtr == NULL) {
-                hPtr = Tcl_FindHashEntry(&contextIclsPtr->resolveVars, token);
-	    }
-            if (hPtr) {
-                vlookup = (ItclVarLookup*)Tcl_GetHashValue(hPtr);
-            }
+            vlookup = ItclFindPublicOpt(contextIclsPtr, token);
         }
 
-        if (!vlookup || (vlookup->ivPtr->protection != ITCL_PUBLIC)) {
+        if (!vlookup) {
             Tcl_AppendResult(interp, "unknown option \"", token, "\"",
                 (char*)NULL);
             result = TCL_ERROR;
@@ -706,25 +850,25 @@ Itcl_BiConfigureCmd(
             goto configureDone;
         }
 
+        /*
+         *  Keep the old value, to restore it if the "config" code
+         *  fails.  The variable is accessed through the object's
+         *  handle for it, without building its name.
+         */
         ivPtr = vlookup->ivPtr;
-        Tcl_DStringSetLength(&buffer2, 0);
-	if (!(ivPtr->flags & ITCL_COMMON)) {
-            Tcl_DStringAppend(&buffer2,
-	            Tcl_GetString(contextIoPtr->varNsNamePtr), -1);
-	}
-        Tcl_DStringAppend(&buffer2,
-	        Tcl_GetString(ivPtr->iclsPtr->fullNamePtr), -1);
-        Tcl_DStringAppend(&buffer2, "::", 2);
-        Tcl_DStringAppend(&buffer2,
-	        Tcl_GetString(ivPtr->namePtr), -1);
-	varName = Tcl_DStringValue(&buffer2);
-        lastval = Tcl_GetVar2(interp, varName, (char*)NULL, 0);
-        Tcl_DStringSetLength(&buffer, 0);
-        Tcl_DStringAppend(&buffer, (lastval) ? lastval : "", -1);
-
-        token = Tcl_GetString(unparsedObjv[i+1]);
-        if (Tcl_SetVar2(interp, varName, (char*)NULL, token,
-                TCL_LEAVE_ERR_MSG) == NULL) {
+        if (lastvalPtr != NULL) {
+            Tcl_DecrRefCount(lastvalPtr);
+        }
+        lastvalPtr = ItclGetObjectVarValue(interp, contextIoPtr, ivPtr,
+                NULL, 0);
+        if (lastvalPtr == NULL) {
+            lastvalPtr = Tcl_NewObj();
+        }
+        Tcl_IncrRefCount(lastvalPtr);
+
+        valuePtr = ItclSetObjectVarValue(interp, contextIoPtr, ivPtr,
+                NULL, unparsedObjv[i+1], TCL_LEAVE_ERR_MSG);
+        if (valuePtr == NULL) {
     	    Tcl_AppendObjToErrorInfo(interp, Tcl_ObjPrintf(
     		    "\n    (error in configuration of public variable \"%s\")",
     		    Tcl_GetString(ivPtr->fullNamePtr)));
@@ -755,9 +899,8 @@ Itcl_BiConfigureCmd(
         	    Tcl_AppendObjToErrorInfo(interp, Tcl_ObjPrintf(
         		    "\n    (error in configuration of public variable \"%s\")",
         		    Tcl_GetString(ivPtr->fullNamePtr)));
-                Tcl_SetVar2(interp, varName,(char*)NULL,
-                    Tcl_DStringValue(&buffer), 0);
-
+		ItclSetObjectVarValue(interp, contextIoPtr, ivPtr, NULL,
+		        lastvalPtr, 0);
                 goto configureDone;
             }
         }
@@ -769,8 +912,9 @@ configureDone:
         infoPtr->unparsedObjv = NULL;
         infoPtr->unparsedObjc = 0;
     }
-    Tcl_DStringFree(&buffer2);
-    Tcl_DStringFree(&buffer);
+    if (lastvalPtr != NULL) {
+        Tcl_DecrRefCount(lastvalPtr);
+    }
 
     return result;
 }
@@ -802,10 +946,9 @@ Itcl_BiCgetCmd(
     ItclClass *contextIclsPtr;
     ItclObject *contextIoPtr;
 
-    Tcl_HashEntry *hPtr;
     ItclVarLookup *vlookup;
+    Tcl_Obj *valuePtr;
     const char *name;
-    const char *val;
     int result;
 
     ItclShowArgs(1,"Itcl_BiCgetCmd", objc, objv);
@@ -839,25 +982,18 @@ Itcl_BiCgetCmd(
     }
     name = Tcl_GetString(objv[1]);
 
-    vlookup = NULL;
-    hPtr = Tcl_FindHashEntry(&contextIclsPtr->resolveVars, name+1);
-    if (hPtr) {
-        vlookup = (ItclVarLookup*)Tcl_GetHashValue(hPtr);
-    }
-
-    if ((vlookup == NULL) || (vlookup->ivPtr->protection != ITCL_PUBLIC)) {
+    vlookup = ItclFindPublicOpt(contextIclsPtr, name);
+    if (vlookup == NULL) {
         Tcl_AppendStringsToObj(Tcl_GetObjResult(interp),
             "unknown option \"", name, "\"",
             (char*)NULL);
         return TCL_ERROR;
     }
 
-    val = Itcl_GetInstanceVar(interp,
-            Tcl_GetString(vlookup->ivPtr->namePtr),
-            contextIoPtr, vlookup->ivPtr->iclsPtr);
-
-    if (val) {
-        Tcl_SetObjResult(interp, Tcl_NewStringObj(val, -1));
+    valuePtr = ItclGetObjectVarValue(interp, contextIoPtr, vlookup->ivPtr,
+            NULL, 0);
+    if (valuePtr) {
+        Tcl_SetObjResult(interp, valuePtr);
     } else {
         Tcl_SetObjResult(interp, Tcl_NewStringObj("<undefined>", -1));
     }
@@ -884,7 +1020,6 @@ ItclReportPublicOpt(
     ItclVariable *ivPtr,     /* public variable to be reported */
     ItclObject *contextIoPtr) /* object containing this variable */
 {
-    const char *val;
     ItclClass *iclsPtr;
     Tcl_HashEntry *hPtr;
     ItclVarLookup *vlookup;
@@ -922,18 +1057,51 @@ ItclReportPublicOpt(
     }
     Tcl_ListObjAppendElement((Tcl_Interp*)NULL, listPtr, objPtr);
 
-    val = Itcl_GetInstanceVar(interp, Tcl_GetString(ivPtr->namePtr),
-            contextIoPtr, ivPtr->iclsPtr);
-
-    if (val) {
-        objPtr = Tcl_NewStringObj((const char *)val, -1);
-    } else {
+    objPtr = ItclGetObjectVarValue(interp, contextIoPtr, ivPtr, NULL, 0);
+    if (objPtr == NULL) {
         objPtr = Tcl_NewStringObj("<undefined>", -1);
     }
     Tcl_ListObjAppendElement((Tcl_Interp*)NULL, listPtr, objPtr);
 
     return listPtr;
 }
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclFindPublicOpt()
+ *
+ *  Looks up a configuration option "-<varName>" of a class in its
+ *  table of public variables.  Returns the lookup record of the
+ *  variable, or NULL if the class has no such public variable.
+ * ------------------------------------------------------------------------
+ */
+static ItclVarLookup*
+ItclFindPublicOpt(
+    ItclClass *iclsPtr,      /* most-specific class of the object */
+    const char *token)       /* option name, including the "-" */
+{
+    Tcl_HashEntry *hPtr;
+    ItclVarLookup *vlookup;
+
+    hPtr = Tcl_FindHashEntry(&iclsPtr->publicOptions, token);
+    if (hPtr != NULL) {
+        return (ItclVarLookup*)Tcl_GetHashValue(hPtr);
+    }
+
+    /*
+     *  A variable whose name starts with "-" can also be given
+     *  without another "-".
+     */
+    hPtr = Tcl_FindHashEntry(&iclsPtr->resolveVars, token);
+    if (hPtr == NULL) {
+        return NULL;
+    }
+    vlookup = (ItclVarLookup*)Tcl_GetHashValue(hPtr);
+    if (vlookup->ivPtr->protection != ITCL_PUBLIC) {
+        return NULL;
+    }
+    return vlookup;
+}
 
 /*
  * ------------------------------------------------------------------------
@@ -957,7 +1125,6 @@ ItclReportOption(
     Tcl_Obj *listPtr;
     Tcl_Obj *objPtr;
     ItclDelegatedOption *idoPtr;
-    const char *val;
 
     listPtr = Tcl_NewListObj(0, (Tcl_Obj**)NULL);
     idoPtr = ioptPtr->iclsPtr->infoPtr->currIdoPtr;
@@ -992,12 +1159,10 @@ ItclReportOption(
         objPtr = Tcl_NewStringObj("<undefined>", -1);
     }
     Tcl_ListObjAppendElement((Tcl_Interp*)NULL, listPtr, objPtr);
-    val = ItclGetInstanceVar(interp, "itcl_options",
+    objPtr = ItclGetInstanceVarObj(interp, "itcl_options",
             Tcl_GetString(ioptPtr->namePtr),
             contextIoPtr, ioptPtr->iclsPtr);
-    if (val) {
-        objPtr = Tcl_NewStringObj((const char *)val, -1);
-    } else {
+    if (objPtr == NULL) {
         objPtr = Tcl_NewStringObj("<undefined>", -1);
     }
     Tcl_ListObjAppendElement((Tcl_Interp*)NULL, listPtr, objPtr);
@@ -1041,7 +1206,8 @@ NRBiChainCmd(
     char *cmd1;
     const char *head;
     ItclClass *iclsPtr;
-    ItclHierIter hier;
+    ItclClass *hierClsPtr;
+    int hierIdx;
     Tcl_HashEntry *hPtr;
     ItclMemberFunc *imPtr;
     Tcl_DString buffer;
@@ -1104,16 +1270,17 @@ NRBiChainCmd(
      *  class context.
      */
     if (contextIoPtr != NULL) {
-        Itcl_InitHierIter(&hier, contextIoPtr->iclsPtr);
-        while ((iclsPtr = Itcl_AdvanceHierIter(&hier)) != NULL) {
-            if (iclsPtr == contextIclsPtr) {
+        hierClsPtr = contextIoPtr->iclsPtr;
+        for (hierIdx = 0; hierIdx < hierClsPtr->numHierarchy; hierIdx++) {
+            if (hierClsPtr->hierarchy[hierIdx] == contextIclsPtr) {
                 break;
             }
         }
     } else {
-        Itcl_InitHierIter(&hier, contextIclsPtr);
-        Itcl_AdvanceHierIter(&hier);    /* skip the current class */
+        hierClsPtr = contextIclsPtr;
+        hierIdx = 0;
     }
+    hierIdx++;                          /* skip the current class */
 
     /*
      *  Now search up the class hierarchy for the next implementation.
@@ -1122,7 +1289,8 @@ NRBiChainCmd(
     objPtr = Tcl_NewStringObj(cmd, -1);
     ckfree(cmd1);
     Tcl_IncrRefCount(objPtr);
-    while ((iclsPtr = Itcl_AdvanceHierIter(&hier)) != NULL) {
+    for ( ; hierIdx < hierClsPtr->numHierarchy; hierIdx++) {
+        iclsPtr = hierClsPtr->hierarchy[hierIdx];
         hPtr = Tcl_FindHashEntry(&iclsPtr->functions, (char *)objPtr);
         if (hPtr) {
 	    int my_objc;
@@ -1153,7 +1321,6 @@ NRBiChainCmd(
     Tcl_DecrRefCount(objPtr);
 
     Tcl_DStringFree(&buffer);
-    Itcl_DeleteHierIter(&hier);
     return result;
 }
 /* ARGSUSED */
@@ -1549,24 +1716,24 @@ ItclUnknownGuts(
 {
     FOREACH_HASH_DECLS;
     Tcl_HashEntry *hPtr2;
+    Tcl_Obj *newObjvStorage[8];
     Tcl_Obj **newObjv;
     Tcl_Obj **lObjv;
     Tcl_Obj *listPtr = NULL;
     Tcl_Obj *objPtr;
     Tcl_Obj *resPtr;
-    Tcl_DString buffer;
+    Tcl_Obj *componentPtr;
     ItclClass *iclsPtr;
     ItclComponent *icPtr;
     ItclDelegatedFunction *idmPtr;
     ItclDelegatedFunction *idmPtr2;
     const char *resStr;
-    const char *val;
     const char *funcName;
     int lObjc;
     int result;
     int offset;
     int useComponent;
-    int found;
+    int componentLen;
     int isItclHull;
     int isStar;
     int isTypeMethod;
@@ -1583,7 +1750,6 @@ ItclUnknownGuts(
     lObjc = 0;
     offset = 1;
     isStar = 0;
-    found = 0;
     isItclHull = 0;
     useComponent = 1;
     result = TCL_OK;
@@ -1594,15 +1760,18 @@ ItclUnknownGuts(
     }
     icPtr = NULL;
     if (!isItclHull) {
-        FOREACH_HASH_VALUE(icPtr, &ioPtr->objectComponents) {
+        FOREACH_HASH_VALUE(icPtr, ITCL_OBJECT_TABLE(ioPtr, objectComponents)) {
             if (icPtr->flags & ITCL_COMPONENT_INHERIT) {
-	        val = Itcl_GetInstanceVar(interp,
-	                Tcl_GetString(icPtr->namePtr), ioPtr,
-		        icPtr->ivPtr->iclsPtr);
-	        if ((val != NULL) && (strlen(val) > 0)) {
+	        componentPtr = ItclGetObjectVarValue(interp, ioPtr,
+		        icPtr->ivPtr, NULL, 0);
+	        componentLen = 0;
+	        if (componentPtr != NULL) {
+		    Tcl_GetStringFromObj(componentPtr, &componentLen);
+	        }
+	        if (componentLen > 0) {
                     newObjv = (Tcl_Obj **)ckalloc(sizeof(Tcl_Obj *) *
 		            (objc));
-		    newObjv[0] = Tcl_NewStringObj(val, -1);
+		    newObjv[0] = componentPtr;
 		    Tcl_IncrRefCount(newObjv[0]);
 		    memcpy(newObjv+1, objv+1, sizeof(Tcl_Obj *) * (objc-1));
                     result = Tcl_EvalObjv(interp, objc, newObjv, 0);
@@ -1613,46 +1782,13 @@ ItclUnknownGuts(
 	    }
         }
     }
-    isTypeMethod = 0;
-    found = 0;
-    FOREACH_HASH_VALUE(idmPtr, &iclsPtr->delegatedFunctions) {
-        if (strcmp(Tcl_GetString(idmPtr->namePtr), funcName) == 0) {
-            if (idmPtr->flags & ITCL_TYPE_METHOD) {
-	       isTypeMethod = 1;
-	    }
-	    found = 1;
-	    break;
-        }
-        if (strcmp(Tcl_GetString(idmPtr->namePtr), "*") == 0) {
-            if (idmPtr->flags & ITCL_TYPE_METHOD) {
-	       isTypeMethod = 1;
-	    }
-	    found = 1;
-	    break;
-	}
-    }
-    if (! found) {
-        idmPtr = NULL;
-    }
-    iclsPtr = ioPtr->iclsPtr;
-    found = 0;
     hPtr = Tcl_FindHashEntry(&iclsPtr->delegatedFunctions, (char *)objv[1]);
-    if (hPtr == NULL) {
-        objPtr = Tcl_NewStringObj("*", -1);
-        Tcl_IncrRefCount(objPtr);
-        hPtr = Tcl_FindHashEntry(&iclsPtr->delegatedFunctions,
-                (char *)objPtr);
-        Tcl_DecrRefCount(objPtr);
-	if (hPtr != NULL) {
-	    idmPtr = Tcl_GetHashValue(hPtr);
-            isStar = 1;
-	}
-    } else {
-        found = 1;
+    if (hPtr != NULL) {
 	idmPtr = Tcl_GetHashValue(hPtr);
-    }
-    if (isStar) {
-       /* check if the function is in the exceptions */
+    } else if (iclsPtr->delegateAllPtr != NULL) {
+	idmPtr = iclsPtr->delegateAllPtr;
+        isStar = 1;
+        /* check if the function is in the exceptions */
         hPtr2 = Tcl_FindHashEntry(&idmPtr->exceptions, (char *)objv[1]);
         if (hPtr2 != NULL) {
 	    const char *sep = "";
@@ -1674,33 +1810,19 @@ ItclUnknownGuts(
 	    return TCL_ERROR;
         }
     }
-    val = NULL;
+    isTypeMethod = 0;
+    if ((idmPtr != NULL) && (idmPtr->flags & ITCL_TYPE_METHOD)) {
+        isTypeMethod = 1;
+    }
+    componentPtr = NULL;
     if ((idmPtr != NULL) && (idmPtr->icPtr != NULL)) {
-        Tcl_Obj *objPtr;
         /* we cannot use Itcl_GetInstanceVar here as the object is not
-         * yet completely built. So use the varNsNamePtr
+         * yet completely built. So read the variable of the object
+         * directly.
          */
-        if (idmPtr->icPtr->ivPtr->flags & ITCL_COMMON) {
-            objPtr = Tcl_NewStringObj(ITCL_VARIABLES_NAMESPACE, -1);
-            Tcl_AppendToObj(objPtr,
-		    (Tcl_GetObjectNamespace(iclsPtr->oPtr))->fullName, -1);
-            Tcl_AppendToObj(objPtr, "::", -1);
-            Tcl_AppendToObj(objPtr,
-	            Tcl_GetString(idmPtr->icPtr->namePtr), -1);
-            val = Tcl_GetVar2(interp, Tcl_GetString(objPtr), NULL, 0);
-	    Tcl_DecrRefCount(objPtr);
-        } else {
-            Tcl_DStringInit(&buffer);
-            Tcl_DStringAppend(&buffer,
-                    Tcl_GetString(ioPtr->varNsNamePtr), -1);
-            Tcl_DStringAppend(&buffer,
-                    Tcl_GetString(idmPtr->icPtr->ivPtr->fullNamePtr), -1);
-            val = Tcl_GetVar2(interp, Tcl_DStringValue(&buffer),
-                    NULL, 0);
-	    Tcl_DStringFree(&buffer);
-        }
-
-        if (val == NULL) {
+        componentPtr = ItclGetObjectVarValue(interp, ioPtr,
+	        idmPtr->icPtr->ivPtr, NULL, 0);
+        if (componentPtr == NULL) {
             Tcl_AppendResult(interp, "ItclBiObjectUnknownCmd contents of ",
 	            "component == NULL\n", NULL);
             return TCL_ERROR;
@@ -1708,26 +1830,6 @@ ItclUnknownGuts(
     }
 
     offset = 1;
-    if (isStar) {
-        hPtr = Tcl_FindHashEntry(&idmPtr->exceptions, (char *)objv[1]);
-	/* we have no method name in that case in the caller */
-	if (hPtr != NULL) {
-	    const char *sep = "";
-	    objPtr = Tcl_NewStringObj("unknown subcommand \"", -1);
-	    Tcl_AppendToObj(objPtr, funcName, -1);
-	    Tcl_AppendToObj(objPtr, "\": must be ", -1);
-	    FOREACH_HASH_VALUE(idmPtr, &iclsPtr->delegatedFunctions) {
-		funcName = Tcl_GetString(idmPtr->namePtr);
-	        if (strcmp(funcName, "*") != 0) {
-		    if (strlen(sep) > 0) {
-	                Tcl_AppendToObj(objPtr, sep, -1);
-		    }
-	            Tcl_AppendToObj(objPtr, funcName, -1);
-		    sep = " or ";
-	        }
-	    }
-	}
-    }
     if (idmPtr == NULL) {
         Tcl_AppendResult(interp, "bad option \"", Tcl_GetString(objv[1]),
                 "\": should be one of...", (char*)NULL);
@@ -1756,17 +1858,25 @@ ItclUnknownGuts(
 	}
     }
     if (useComponent) {
-	if ((val == NULL) || (strlen(val) == 0)) {
+	componentLen = 0;
+	if (componentPtr != NULL) {
+	    Tcl_GetStringFromObj(componentPtr, &componentLen);
+	}
+	if (componentLen == 0) {
 	    Tcl_AppendResult(interp, "component \"",
 		    Tcl_GetString(idmPtr->icPtr->namePtr),
 		    "\" is not initialized", NULL);
 	    return TCL_ERROR;
         }
     }
-    newObjv = (Tcl_Obj **)ckalloc(sizeof(Tcl_Obj *) *
+    newObjv = newObjvStorage;
+    if (objc + lObjc - offset + useComponent >
+            (int)(sizeof(newObjvStorage)/sizeof(Tcl_Obj *))) {
+        newObjv = (Tcl_Obj **)ckalloc(sizeof(Tcl_Obj *) *
                 (objc + lObjc - offset + useComponent));
+    }
     if (useComponent) {
-        newObjv[0] = Tcl_NewStringObj(val, -1);
+        newObjv[0] = componentPtr;
         Tcl_IncrRefCount(newObjv[0]);
     }
     for (idx = 0; idx < lObjc; idx++) {
@@ -1796,30 +1906,36 @@ ItclUnknownGuts(
 		        &iclsPtr->delegatedFunctions, (char *)newObjv[1],
 			&isNew);
                 Tcl_SetHashValue(hPtr2, idmPtr2);
+		/* later calls go to the component without coming here */
+		if (!isTypeMethod && (idmPtr2->icPtr != NULL)) {
+		    result = ItclInstallDelegatedMethod(interp, iclsPtr,
+		            idmPtr2);
+		}
 	    }
 	}
     }
-    if (useComponent) {
-        Tcl_DecrRefCount(newObjv[0]);
-    }
     if (listPtr != NULL) {
         Tcl_DecrRefCount(listPtr);
     }
-    ckfree((char *)newObjv);
-    if (result == TCL_OK) {
-        return TCL_OK;
+    if ((result != TCL_OK) && useComponent) {
+        resStr = Tcl_GetStringResult(interp);
+        /* FIXME ugly hack at the moment !! */
+        if (strncmp(resStr, "wrong # args: should be ", 24) == 0) {
+            resPtr = Tcl_NewStringObj("", -1);
+	    Tcl_AppendToObj(resPtr, resStr, 25);
+            resStr += 25;
+	    Tcl_AppendToObj(resPtr, Tcl_GetString(iclsPtr->namePtr), -1);
+            resStr += strlen(Tcl_GetString(newObjv[0]));
+	    Tcl_AppendToObj(resPtr, resStr, -1);
+	    Tcl_ResetResult(interp);
+	    Tcl_SetObjResult(interp, resPtr);
+        }
     }
-    resStr = Tcl_GetStringResult(interp);
-    /* FIXME ugly hack at the moment !! */
-    if (strncmp(resStr, "wrong # args: should be ", 24) == 0) {
-        resPtr = Tcl_NewStringObj("", -1);
-	Tcl_AppendToObj(resPtr, resStr, 25);
-        resStr += 25;
-	Tcl_AppendToObj(resPtr, Tcl_GetString(iclsPtr->namePtr), -1);
-        resStr += strlen(val);
-	Tcl_AppendToObj(resPtr, resStr, -1);
-	Tcl_ResetResult(interp);
-	Tcl_SetObjResult(interp, resPtr);
+    if (useComponent) {
+        Tcl_DecrRefCount(newObjv[0]);
+    }
+    if (newObjv != newObjvStorage) {
+        ckfree((char *)newObjv);
     }
     return result;
 }
@@ -1909,7 +2025,8 @@ ItclExtendedConfigure(
     ItclComponent *icPtr;
     ItclOption *ioptPtr;
     ItclObjectInfo *infoPtr;
-    const char *val;
+    Tcl_Obj *valuePtr;
+    int valueLen;
     int lObjc;
     int lObjc2;
     int lObjc3;
@@ -1962,18 +2079,18 @@ ItclExtendedConfigure(
         hPtr = Tcl_FindHashEntry(&idmPtr->exceptions, (char *)methodNamePtr);
         if (hPtr == NULL) {
 	    icPtr = idmPtr->icPtr;
-	    val = ItclGetInstanceVar(interp, Tcl_GetString(icPtr->namePtr),
-	            NULL, contextIoPtr, contextIclsPtr);
-            if (val != NULL) {
+	    objPtr = ItclGetInstanceVarObj(interp,
+	            Tcl_GetString(icPtr->namePtr), NULL, contextIoPtr,
+		    contextIclsPtr);
+            if (objPtr != NULL) {
 	        newObjv = (Tcl_Obj **)ckalloc(sizeof(Tcl_Obj *)*(objc+5));
-	        newObjv[0] = Tcl_NewStringObj(val, -1);
+	        newObjv[0] = objPtr;
 	        Tcl_IncrRefCount(newObjv[0]);
 	        newObjv[1] = Tcl_NewStringObj("configure", -1);
 	        Tcl_IncrRefCount(newObjv[1]);
 	        for(i=1;i<objc;i++) {
 	            newObjv[i+1] = objv[i];
                 }
-		objPtr = Tcl_NewStringObj(val, -1);
 	        Tcl_IncrRefCount(objPtr);
 	        oPtr = Tcl_GetObjectFromObj(interp, objPtr);
 	        if (oPtr != NULL) {
@@ -2008,7 +2125,8 @@ ItclExtendedConfigure(
             result = Tcl_EvalEx(interp, "::itcl::builtin::getEclassOptions", -1, 0);
             return result;
 	}
-	FOREACH_HASH_VALUE(ioptPtr, &contextIoPtr->objectOptions) {
+	FOREACH_HASH_VALUE(ioptPtr,
+                ITCL_OBJECT_TABLE(contextIoPtr, objectOptions)) {
 	    hPtr2 = Tcl_CreateHashEntry(&unique,
 	            (char *)ioptPtr->namePtr, &isNew);
 	    if (!isNew) {
@@ -2029,26 +2147,31 @@ ItclExtendedConfigure(
 	        Tcl_ListObjAppendElement(interp, objPtr,
 		        Tcl_NewStringObj("", -1));
 	    }
-	    val = ItclGetInstanceVar(interp, "itcl_options",
+	    valuePtr = ItclGetInstanceVarObj(interp, "itcl_options",
 	            Tcl_GetString(ioptPtr->namePtr), contextIoPtr,
 		    contextIclsPtr);
-	    if (val == NULL) {
-		val = "<undefined>";
+	    if (valuePtr == NULL) {
+		valuePtr = Tcl_NewStringObj("<undefined>", -1);
 	    }
-	    Tcl_ListObjAppendElement(interp, objPtr,
-	            Tcl_NewStringObj(val, -1));
+	    Tcl_ListObjAppendElement(interp, objPtr, valuePtr);
 	    Tcl_ListObjAppendElement(interp, listPtr, objPtr);
 	}
 	/* now check for delegated options */
-	FOREACH_HASH_VALUE(idoPtr, &contextIoPtr->objectDelegatedOptions) {
+	FOREACH_HASH_VALUE(idoPtr,
+                ITCL_OBJECT_TABLE(contextIoPtr, objectDelegatedOptions)) {
 
             if (idoPtr->icPtr != NULL) {
                 icPtr = idoPtr->icPtr;
-                val = ItclGetInstanceVar(interp, Tcl_GetString(icPtr->namePtr),
-                    NULL, contextIoPtr, icPtr->ivPtr->iclsPtr);
-	        if ((val != NULL) && (strlen(val) != 0)) {
+                valuePtr = ItclGetInstanceVarObj(interp,
+		        Tcl_GetString(icPtr->namePtr), NULL, contextIoPtr,
+			icPtr->ivPtr->iclsPtr);
+		valueLen = 0;
+		if (valuePtr != NULL) {
+		    Tcl_GetStringFromObj(valuePtr, &valueLen);
+		}
+	        if (valueLen != 0) {
 
-		    objPtr = Tcl_NewStringObj(val, -1);
+		    objPtr = Tcl_DuplicateObj(valuePtr);
 		    Tcl_IncrRefCount(objPtr);
 		    Tcl_AppendToObj(objPtr, " configure ", -1);
 		    isOneOption = 0;
@@ -2158,14 +2281,16 @@ ItclExtendedConfigure(
     }
     hPtr2 = NULL;
     /* first handle delegated options */
-    hPtr = Tcl_FindHashEntry(&contextIoPtr->objectDelegatedOptions, (char *)
-            objv[1]);
+    hPtr = Tcl_FindHashEntry(
+            ITCL_OBJECT_TABLE(contextIoPtr, objectDelegatedOptions),
+            (char *)objv[1]);
     if (hPtr == NULL) {
 	Tcl_Obj *objPtr;
 	objPtr = Tcl_NewStringObj("*",1);
 	Tcl_IncrRefCount(objPtr);
         /* check if all options are delegated */
-        hPtr = Tcl_FindHashEntry(&contextIoPtr->objectDelegatedOptions,
+        hPtr = Tcl_FindHashEntry(
+                ITCL_OBJECT_TABLE(contextIoPtr, objectDelegatedOptions),
 	        (char *)objPtr);
 	Tcl_DecrRefCount(objPtr);
         if (hPtr != NULL) {
@@ -2181,7 +2306,7 @@ ItclExtendedConfigure(
     componentIcPtr = NULL;
     /* check if it is not a local option defined before delegate option "*"
      */
-    hPtr2 = Tcl_FindHashEntry(&contextIoPtr->objectOptions,
+    hPtr2 = Tcl_FindHashEntry(ITCL_OBJECT_TABLE(contextIoPtr, objectOptions),
             (char *)objv[1]);
     if (hPtr != NULL) {
         idoPtr = (ItclDelegatedOption *)Tcl_GetHashValue(hPtr);
@@ -2191,21 +2316,20 @@ ItclExtendedConfigure(
 	        hPtr3 = Tcl_FindHashEntry(&icPtr->keptOptions, (char *)objv[1]);
                 if (hPtr3 != NULL) {
 		    /* ignore if it is an object option only */
-		    ItclHierIter hier;
+		    int hierIdx;
 		    int found;
 
 		    found = 0;
-                    Itcl_InitHierIter(&hier, contextIoPtr->iclsPtr);
-		    iclsPtr2 = Itcl_AdvanceHierIter(&hier);
-		    while (iclsPtr2 != NULL) {
+		    for (hierIdx = 0;
+		            hierIdx < contextIoPtr->iclsPtr->numHierarchy;
+		            hierIdx++) {
+			iclsPtr2 = contextIoPtr->iclsPtr->hierarchy[hierIdx];
 			if (Tcl_FindHashEntry(&iclsPtr2->options,
 			        (char *)objv[1]) != NULL) {
                             found = 1;
 			    break;
 			}
-                        iclsPtr2 = Itcl_AdvanceHierIter(&hier);
 		    }
-		    Itcl_DeleteHierIter(&hier);
                     if (! found) {
 		        hPtr2 = NULL;
                         componentIcPtr = icPtr;
@@ -2222,15 +2346,19 @@ ItclExtendedConfigure(
 	} else {
             icPtr = idoPtr->icPtr;
 	}
-        val = ItclGetInstanceVar(interp,
+        valuePtr = ItclGetInstanceVarObj(interp,
 	        Tcl_GetString(icPtr->namePtr),
                 NULL, contextIoPtr, icPtr->ivPtr->iclsPtr);
-        if ((val != NULL) && (strlen(val) > 0)) {
+        valueLen = 0;
+        if (valuePtr != NULL) {
+            Tcl_GetStringFromObj(valuePtr, &valueLen);
+        }
+        if (valueLen > 0) {
 	    if (idoPtr->asPtr != NULL) {
                 icPtr->ivPtr->iclsPtr->infoPtr->currIdoPtr = idoPtr;
 	    }
 	    newObjv = (Tcl_Obj **)ckalloc(sizeof(Tcl_Obj *)*(objc+2));
-	    newObjv[0] = Tcl_NewStringObj(val, -1);
+	    newObjv[0] = valuePtr;
 	    Tcl_IncrRefCount(newObjv[0]);
 	    newObjv[1] = Tcl_NewStringObj("configure", 9);
 	    Tcl_IncrRefCount(newObjv[1]);
@@ -2243,15 +2371,12 @@ ItclExtendedConfigure(
 	    for(i=2;i<objc;i++) {
 	        newObjv[i+1] = objv[i];
             }
-	    objPtr = Tcl_NewStringObj(val, -1);
-	    Tcl_IncrRefCount(objPtr);
-	    oPtr = Tcl_GetObjectFromObj(interp, objPtr);
+	    oPtr = Tcl_GetObjectFromObj(interp, newObjv[0]);
 	    if (oPtr != NULL) {
                 ioPtr = (ItclObject *)Tcl_ObjectGetMetadata(oPtr,
                         infoPtr->object_meta_type);
 	        infoPtr->currContextIclsPtr = ioPtr->iclsPtr;
 	    }
-	    Tcl_DecrRefCount(objPtr);
             ItclShowArgs(1, "extended eval delegated option", objc + 1,
 	            newObjv);
             result = Tcl_EvalObjv(interp, objc+1, newObjv, TCL_EVAL_DIRECT);
@@ -2280,7 +2405,8 @@ ItclExtendedConfigure(
             hPtr2 = Tcl_FindHashEntry(&contextIclsPtr->options,
 	            (char *) objv[1]);
             if (hPtr2 == NULL) {
-                hPtr2 = Tcl_FindHashEntry(&contextIoPtr->objectOptions,
+                hPtr2 = Tcl_FindHashEntry(
+                        ITCL_OBJECT_TABLE(contextIoPtr, objectOptions),
 	                (char *) objv[1]);
 	    } else {
 	       infoPtr->currIdoPtr = NULL;
@@ -2323,7 +2449,7 @@ ItclExtendedConfigure(
 	    result = TCL_ERROR;
 	    break;
 	}
-        hPtr = Tcl_FindHashEntry(&contextIoPtr->objectOptions,
+        hPtr = Tcl_FindHashEntry(ITCL_OBJECT_TABLE(contextIoPtr, objectOptions),
 	        (char *) objv[i]);
         if (hPtr == NULL) {
             if (contextIclsPtr->flags & ITCL_ECLASS) {
@@ -2343,21 +2469,26 @@ ItclExtendedConfigure(
                   continue;
                 }
 	    }
-            hPtr = Tcl_FindHashEntry(&contextIoPtr->objectDelegatedOptions,
+            hPtr = Tcl_FindHashEntry(
+                    ITCL_OBJECT_TABLE(contextIoPtr, objectDelegatedOptions),
 	            (char *) objv[i]);
             if (hPtr != NULL) {
 	        /* the option is delegated */
                 idoPtr = (ItclDelegatedOption *)Tcl_GetHashValue(hPtr);
                 icPtr = idoPtr->icPtr;
-                val = ItclGetInstanceVar(interp,
+                valuePtr = ItclGetInstanceVarObj(interp,
 	                Tcl_GetString(icPtr->ivPtr->namePtr),
                         NULL, contextIoPtr, icPtr->ivPtr->iclsPtr);
-                if ((val != NULL) && (strlen(val) > 0)) {
+                valueLen = 0;
+                if (valuePtr != NULL) {
+                    Tcl_GetStringFromObj(valuePtr, &valueLen);
+                }
+                if (valueLen > 0) {
 	            if (idoPtr->asPtr != NULL) {
                         icPtr->ivPtr->iclsPtr->infoPtr->currIdoPtr = idoPtr;
 	            }
 	            newObjv = (Tcl_Obj **)ckalloc(sizeof(Tcl_Obj *)*(objc+2));
-	            newObjv[0] = Tcl_NewStringObj(val, -1);
+	            newObjv[0] = valuePtr;
 	            Tcl_IncrRefCount(newObjv[0]);
 	            newObjv[1] = Tcl_NewStringObj("configure", 9);
 	            Tcl_IncrRefCount(newObjv[1]);
@@ -2368,15 +2499,12 @@ ItclExtendedConfigure(
 	            }
 	            Tcl_IncrRefCount(newObjv[2]);
 	            newObjv[3] = objv[i+1];
-	            objPtr = Tcl_NewStringObj(val, -1);
-	            Tcl_IncrRefCount(objPtr);
-	            oPtr = Tcl_GetObjectFromObj(interp, objPtr);
+	            oPtr = Tcl_GetObjectFromObj(interp, newObjv[0]);
 	            if (oPtr != NULL) {
                         ioPtr = (ItclObject *)Tcl_ObjectGetMetadata(oPtr,
                                 infoPtr->object_meta_type);
 	                infoPtr->currContextIclsPtr = ioPtr->iclsPtr;
 	            }
-	            Tcl_DecrRefCount(objPtr);
                     ItclShowArgs(1, "extended eval delegated option", 4,
 		            newObjv);
                     result = Tcl_EvalObjv(interp, 4, newObjv, TCL_EVAL_DIRECT);
@@ -2454,20 +2582,18 @@ ItclExtendedConfigure(
 	    evalNsPtr = ioptPtr->iclsPtr->nsPtr;
 	}
 	if (ioptPtr->configureMethodVarPtr != NULL) {
-	    val = ItclGetInstanceVar(interp,
+	    objPtr = ItclGetInstanceVarObj(interp,
 	            Tcl_GetString(ioptPtr->configureMethodVarPtr), NULL,
 		    contextIoPtr, ioptPtr->iclsPtr);
-	    if (val == NULL) {
+	    if (objPtr == NULL) {
 	        Tcl_AppendResult(interp, "configure cannot get value for",
 		        " configuremethodvar \"",
 			Tcl_GetString(ioptPtr->configureMethodVarPtr),
 			"\"", NULL);
 		return TCL_ERROR;
 	    }
-	    objPtr = Tcl_NewStringObj(val, -1);
 	    hPtr = Tcl_FindHashEntry(&contextIoPtr->iclsPtr->resolveCmds,
 	        (char *)objPtr);
-	    Tcl_DecrRefCount(objPtr);
             if (hPtr != NULL) {
 		ItclMemberFunc *imPtr;
 		ItclCmdLookup *clookup;
@@ -2476,10 +2602,11 @@ ItclExtendedConfigure(
 	        evalNsPtr = imPtr->iclsPtr->nsPtr;
 	    } else {
 		Tcl_AppendResult(interp, "cannot find method \"",
-		        val, "\" found in configuremethodvar", NULL);
+		        Tcl_GetString(objPtr), "\" found in configuremethodvar",
+			NULL);
 		return TCL_ERROR;
 	    }
-	    configureMethodPtr = Tcl_NewStringObj(val, -1);
+	    configureMethodPtr = objPtr;
 	    Tcl_IncrRefCount(configureMethodPtr);
 	}
         if (configureMethodPtr != NULL) {
@@ -2550,7 +2677,6 @@ ItclExtendedCget(
     Tcl_HashEntry *hPtr2;
     Tcl_HashEntry *hPtr3;
     Tcl_Obj *objPtr2;
-    Tcl_Obj *objPtr;
     Tcl_Object oPtr;
     Tcl_Obj *methodNamePtr;
     Tcl_Obj **newObjv;
@@ -2562,7 +2688,8 @@ ItclExtendedCget(
     ItclObjectInfo *infoPtr;
     ItclOption *ioptPtr;
     ItclObject *ioPtr;
-    const char *val;
+    Tcl_Obj *valuePtr;
+    int valueLen;
     int i;
     int result;
 
@@ -2604,20 +2731,19 @@ ItclExtendedCget(
         hPtr = Tcl_FindHashEntry(&idmPtr->exceptions, (char *)methodNamePtr);
         if (hPtr == NULL) {
 	    icPtr = idmPtr->icPtr;
-	    val = ItclGetInstanceVar(interp, Tcl_GetString(icPtr->namePtr),
-	            NULL, contextIoPtr, contextIclsPtr);
-            if (val != NULL) {
+	    valuePtr = ItclGetInstanceVarObj(interp,
+	            Tcl_GetString(icPtr->namePtr), NULL, contextIoPtr,
+		    contextIclsPtr);
+            if (valuePtr != NULL) {
 	        newObjv = (Tcl_Obj **)ckalloc(sizeof(Tcl_Obj *)*(objc+1));
-	        newObjv[0] = Tcl_NewStringObj(val, -1);
+	        newObjv[0] = valuePtr;
 	        Tcl_IncrRefCount(newObjv[0]);
 	        newObjv[1] = Tcl_NewStringObj("cget", 4);
 	        Tcl_IncrRefCount(newObjv[1]);
 		for(i=1;i<objc;i++) {
 		    newObjv[i+1] = objv[i];
 		}
-		objPtr = Tcl_NewStringObj(val, -1);
-	        Tcl_IncrRefCount(objPtr);
-	        oPtr = Tcl_GetObjectFromObj(interp, objPtr);
+	        oPtr = Tcl_GetObjectFromObj(interp, newObjv[0]);
 	        if (oPtr != NULL) {
                     ioPtr = (ItclObject *)Tcl_ObjectGetMetadata(oPtr,
                             infoPtr->object_meta_type);
@@ -2627,7 +2753,7 @@ ItclExtendedCget(
                 result = Tcl_EvalObjv(interp, objc+1, newObjv, TCL_EVAL_DIRECT);
 	        Tcl_DecrRefCount(newObjv[0]);
 	        Tcl_DecrRefCount(newObjv[1]);
-	        Tcl_DecrRefCount(objPtr);
+	        ckfree((char *)newObjv);
 	        if (oPtr != NULL) {
 	            infoPtr->currContextIclsPtr = NULL;
 	        }
@@ -2643,19 +2769,22 @@ ItclExtendedCget(
     }
     /* now do the hard work */
     /* first handle delegated options */
-    hPtr = Tcl_FindHashEntry(&contextIoPtr->objectDelegatedOptions, (char *)
-            objv[1]);
-    hPtr3 = Tcl_FindHashEntry(&contextIoPtr->objectOptions, (char *)
-            objv[1]);
+    hPtr = Tcl_FindHashEntry(
+            ITCL_OBJECT_TABLE(contextIoPtr, objectDelegatedOptions),
+            (char *)objv[1]);
+    hPtr3 = Tcl_FindHashEntry(
+            ITCL_OBJECT_TABLE(contextIoPtr, objectOptions), (char *)objv[1]);
     hPtr2 = NULL;
     if (hPtr == NULL) {
 	objPtr2 = Tcl_NewStringObj("*", -1);
         /* check for "*" option delegated */
-        hPtr = Tcl_FindHashEntry(&contextIoPtr->objectDelegatedOptions, (char *)
-                objPtr2);
+        hPtr = Tcl_FindHashEntry(
+                ITCL_OBJECT_TABLE(contextIoPtr, objectDelegatedOptions),
+                (char *)objPtr2);
 	Tcl_DecrRefCount(objPtr2);
-        hPtr2 = Tcl_FindHashEntry(&contextIoPtr->objectOptions, (char *)
-                objv[1]);
+        hPtr2 = Tcl_FindHashEntry(
+                ITCL_OBJECT_TABLE(contextIoPtr, objectOptions),
+                (char *)objv[1]);
     }
     if ((hPtr != NULL) && (hPtr2 == NULL) && (hPtr3 == NULL)) {
 	/* the option is delegated */
@@ -2667,16 +2796,16 @@ ItclExtendedCget(
 	    return TCL_CONTINUE;
 	}
         icPtr = idoPtr->icPtr;
-	if (icPtr->ivPtr->flags & ITCL_COMMON) {
-            val = ItclGetInstanceVar(interp, Tcl_GetString(icPtr->namePtr),
-                    NULL, contextIoPtr, icPtr->ivPtr->iclsPtr);
-	} else {
-            val = ItclGetInstanceVar(interp, Tcl_GetString(icPtr->namePtr),
-                    NULL, contextIoPtr, icPtr->ivPtr->iclsPtr);
-	}
-        if ((val != NULL) && (strlen(val) > 0)) {
+        valuePtr = ItclGetInstanceVarObj(interp,
+	        Tcl_GetString(icPtr->namePtr), NULL, contextIoPtr,
+		icPtr->ivPtr->iclsPtr);
+        valueLen = 0;
+        if (valuePtr != NULL) {
+            Tcl_GetStringFromObj(valuePtr, &valueLen);
+        }
+        if (valueLen > 0) {
 	    newObjv = (Tcl_Obj **)ckalloc(sizeof(Tcl_Obj *)*(objc+1));
-	    newObjv[0] = Tcl_NewStringObj(val, -1);
+	    newObjv[0] = valuePtr;
 	    Tcl_IncrRefCount(newObjv[0]);
 	    newObjv[1] = Tcl_NewStringObj("cget", 4);
 	    Tcl_IncrRefCount(newObjv[1]);
@@ -2692,9 +2821,7 @@ ItclExtendedCget(
 	            newObjv[i+1] = objv[i];
 	        }
 	    }
-	    objPtr = Tcl_NewStringObj(val, -1);
-	    Tcl_IncrRefCount(objPtr);
-	    oPtr = Tcl_GetObjectFromObj(interp, objPtr);
+	    oPtr = Tcl_GetObjectFromObj(interp, newObjv[0]);
 	    if (oPtr != NULL) {
                 ioPtr = (ItclObject *)Tcl_ObjectGetMetadata(oPtr,
                         infoPtr->object_meta_type);
@@ -2704,7 +2831,6 @@ ItclExtendedCget(
             result = Tcl_EvalObjv(interp, objc+1, newObjv, TCL_EVAL_DIRECT);
 	    Tcl_DecrRefCount(newObjv[0]);
 	    Tcl_DecrRefCount(newObjv[1]);
-	    Tcl_DecrRefCount(objPtr);
 	    if (oPtr != NULL) {
 	        infoPtr->currContextIclsPtr = NULL;
 	    }
@@ -2744,11 +2870,11 @@ ItclExtendedCget(
 	Tcl_DecrRefCount(newObjv[0]);
         ckfree((char *)newObjv);
     } else {
-        val = ItclGetInstanceVar(interp, "itcl_options",
+        valuePtr = ItclGetInstanceVarObj(interp, "itcl_options",
                 Tcl_GetString(ioptPtr->namePtr),
 		contextIoPtr, ioptPtr->iclsPtr);
-        if (val) {
-            Tcl_SetObjResult(interp, Tcl_NewStringObj(val, -1));
+        if (valuePtr) {
+            Tcl_SetObjResult(interp, valuePtr);
         } else {
             Tcl_SetObjResult(interp, Tcl_NewStringObj("<undefined>", -1));
         }
@@ -2833,7 +2959,8 @@ ItclExtendedSetGet(
         return TCL_ERROR;
     }
     /* look if it is an methodvariable at all */
-    hPtr = Tcl_FindHashEntry(&contextIoPtr->objectMethodVariables,
+    hPtr = Tcl_FindHashEntry(
+            ITCL_OBJECT_TABLE(contextIoPtr, objectMethodVariables),
             (char *) objv[1]);
     if (hPtr == NULL) {
 	Tcl_AppendResult(interp, "no such methodvariable \"",
@@ -2957,7 +3084,8 @@ Itcl_BiInstallComponentCmd(
     hPtr = Tcl_FindHashEntry(&contextIclsPtr->components, (char *)objv[1]);
     if (hPtr == NULL) {
 	numOpts = 0;
-	FOREACH_HASH_VALUE(idoPtr, &contextIoPtr->objectDelegatedOptions) {
+	FOREACH_HASH_VALUE(idoPtr,
+                ITCL_OBJECT_TABLE(contextIoPtr, objectDelegatedOptions)) {
             if (idoPtr == NULL) {
                 /* FIXME need code here !! */
 	    }
@@ -3461,6 +3589,9 @@ Itcl_BiMyVarCmd(
         return TCL_ERROR;
     }
     if (contextIoPtr != NULL) {
+        if (ItclLinkObjectVarNamespaces(interp, contextIoPtr) != TCL_OK) {
+            return TCL_ERROR;
+        }
         resultPtr = Tcl_NewStringObj(Tcl_GetString(contextIoPtr->varNsNamePtr),
 	        -1);
 	Tcl_AppendToObj(resultPtr, "::", -1);
@@ -3627,10 +3758,11 @@ Itcl_BiInitOptionsCmd(
         return TCL_ERROR;
     }
     /* first handle delegated options */
-    FOREACH_HASH_VALUE(idoptPtr, &ioPtr->objectDelegatedOptions) {
+    FOREACH_HASH_VALUE(idoptPtr,
+            ITCL_OBJECT_TABLE(ioPtr, objectDelegatedOptions)) {
 fprintf(stderr, "delopt!%s!\n", Tcl_GetString(idoptPtr->namePtr));
     }
-    FOREACH_HASH_VALUE(ioptPtr, &ioPtr->objectOptions) {
+    FOREACH_HASH_VALUE(ioptPtr, ITCL_OBJECT_TABLE(ioPtr, objectOptions)) {
 fprintf(stderr, "opt!%s!\n", Tcl_GetString(ioptPtr->namePtr));
     }
     return result;
@@ -3722,7 +3854,8 @@ Itcl_BiIgnoreComponentOptionCmd(
         return TCL_ERROR;
     }
     if (ioPtr != NULL) {
-        hPtr = Tcl_FindHashEntry(&ioPtr->objectComponents, (char *)objv[1]);
+        hPtr = Tcl_FindHashEntry(
+                ITCL_OBJECT_TABLE(ioPtr, objectComponents), (char *)objv[1]);
         if (hPtr == NULL) {
 	    Tcl_AppendResult(interp,
 	            "ignorecomponentoption cannot find component \"",
@@ -3737,7 +3870,8 @@ Itcl_BiIgnoreComponentOptionCmd(
             if (isNew) {
 	        Tcl_SetHashValue(hPtr, objv[idx]);
 	    }
-	    hPtr2 = Tcl_CreateHashEntry(&ioPtr->objectDelegatedOptions,
+	    hPtr2 = Tcl_CreateHashEntry(
+                    ITCL_OBJECT_TABLE_FOR_WRITE(ioPtr, objectDelegatedOptions),
 	            (char *)objv[idx], &isNew);
 	    if (isNew) {
 		idoPtr = (ItclDelegatedOption *)ckalloc(sizeof(
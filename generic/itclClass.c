@@ -30,6 +30,7 @@
  * See the file "license.terms" for information on usage and redistribution
  * of this file, and for a DISCLAIMER OF ALL WARRANTIES.
  */
+#include <stdlib.h>
 #include "itclInt.h"
 
 static Tcl_NamespaceDeleteProc* _TclOONamespaceDeleteProc = NULL;
@@ -44,6 +45,19 @@ static void ItclDeleteFunction(ItclMemberFunc *imPtr);
 static void ItclDeleteComponent(ItclComponent *icPtr);
 static void ItclDeleteOption(char *cdata);
 
+/*
+ *  A classId and its position in a hierarchy, sorted by
+ *  ItclBuildHierarchy.  Hierarchies up to ITCL_HERITAGE_SPACE classes
+ *  are sorted on the stack.
+ */
+typedef struct HeritageEntry {
+    int classId;
+    int pos;
+} HeritageEntry;
+#define ITCL_HERITAGE_SPACE 32
+
+static int CompareHeritageEntries(const void *a, const void *b);
+
 void
 ItclPreserveClass(
     ItclClass *iclsPtr)
@@ -336,10 +350,19 @@ Itcl_CreateClass(
     Tcl_InitHashTable(&iclsPtr->classCommons, TCL_ONE_WORD_KEYS);
     Tcl_InitHashTable(&iclsPtr->resolveVars, TCL_ONE_WORD_KEYS);
     Tcl_InitHashTable(&iclsPtr->contextCache, TCL_ONE_WORD_KEYS);
+    Tcl_InitHashTable(&iclsPtr->publicOptions, TCL_STRING_KEYS);
 
     Itcl_InitList(&iclsPtr->bases);
     Itcl_InitList(&iclsPtr->derived);
 
+    /*
+     *  Initialize the heritage info--each class starts with its
+     *  own class definition in the heritage.  Base classes are
+     *  added to the heritage from the "inherit" statement.
+     */
+    iclsPtr->classId = infoPtr->classIdCounter++;
+    ItclBuildHierarchy(iclsPtr);
+
     resolveInfoPtr = (ItclResolveInfo *) ckalloc(sizeof(ItclResolveInfo));
     memset (resolveInfoPtr, 0, sizeof(ItclResolveInfo));
     resolveInfoPtr->flags = ITCL_RESOLVE_CLASS;
@@ -350,14 +373,6 @@ Itcl_CreateClass(
     iclsPtr->resolvePtr->clientData = resolveInfoPtr;
     iclsPtr->flags    = infoPtr->currClassFlags;
 
-    /*
-     *  Initialize the heritage info--each class starts with its
-     *  own class definition in the heritage.  Base classes are
-     *  added to the heritage from the "inherit" statement.
-     */
-    Tcl_InitHashTable(&iclsPtr->heritage, TCL_ONE_WORD_KEYS);
-    (void) Tcl_CreateHashEntry(&iclsPtr->heritage, (char*)iclsPtr, &newEntry);
-
     /*
      *  Create a namespace to represent the class.  Add the class
      *  definition info as client data for the namespace.  If the
@@ -468,6 +483,7 @@ Itcl_CreateClass(
     hPtr = Tcl_CreateHashEntry(&infoPtr->namespaceClasses, (char *)classNs,
             &newEntry);
     Tcl_SetHashValue(hPtr, (ClientData)iclsPtr);
+    infoPtr->classEpoch++;
   if (classNs != ooNs) {
     hPtr = Tcl_CreateHashEntry(&infoPtr->namespaceClasses, (char *)ooNs,
             &newEntry);
@@ -680,7 +696,6 @@ CallDeleteOneObject(
     int result)
 {
     Tcl_HashEntry *hPtr;
-    Tcl_HashSearch place;
     ItclClass *iclsPtr2 = NULL;
     ItclObject *contextIoPtr;
     ItclClass *iclsPtr = data[0];
@@ -700,34 +715,25 @@ CallDeleteOneObject(
         return result;
     }
     /*
-     * Fix 227804: Whenever an object to delete was found we
-     * have to reset the search to the beginning as the
-     * current entry in the search was deleted and accessing it
-     * is therefore not allowed anymore.
+     * Deleting an object takes it out of the instance list of the
+     * class, so always delete the first one still alive.
      */
 
-    hPtr = Tcl_FirstHashEntry(&infoPtr->objects, &place);
-    if (hPtr) {
-        contextIoPtr = (ItclObject*)Tcl_GetHashValue(hPtr);
-
-        while (contextIoPtr->iclsPtr != iclsPtr) {
-            hPtr = Tcl_NextHashEntry(&place);
-            if (hPtr == NULL) {
-                break;
-            }
-        }
-        if (hPtr) {
-	    callbackPtr = Itcl_GetCurrentCallbackPtr(interp);
-            if (Itcl_DeleteObject(interp, contextIoPtr) != TCL_OK) {
-                iclsPtr2 = iclsPtr;
-                goto deleteClassFail;
-            }
-
-            Tcl_NRAddCallback(interp, CallDeleteOneObject, iclsPtr,
-	            infoPtr, NULL, NULL);
-            return Itcl_NRRunCallbacks(interp, callbackPtr);
-        }
+    contextIoPtr = iclsPtr->firstInstancePtr;
+    while ((contextIoPtr != NULL) && ((contextIoPtr->accessCmd == NULL)
+            || (contextIoPtr->flags & ITCL_OBJECT_IS_DESTRUCTED))) {
+        contextIoPtr = contextIoPtr->nextInstancePtr;
+    }
+    if (contextIoPtr != NULL) {
+	callbackPtr = Itcl_GetCurrentCallbackPtr(interp);
+	if (Itcl_DeleteObject(interp, contextIoPtr) != TCL_OK) {
+	    iclsPtr2 = iclsPtr;
+	    goto deleteClassFail;
+	}
 
+	Tcl_NRAddCallback(interp, CallDeleteOneObject, iclsPtr,
+		infoPtr, NULL, NULL);
+	return Itcl_NRRunCallbacks(interp, callbackPtr);
     }
 
     return TCL_OK;
@@ -920,8 +926,6 @@ void
 ItclDestroyClassNamesp(
     ClientData cdata)  /* class definition to be destroyed */
 {
-    Tcl_HashEntry *hPtr;
-    Tcl_HashSearch place;
     Tcl_Command cmdPtr;
     ItclClass *iclsPtr;
     ItclObject *ioPtr;
@@ -964,28 +968,24 @@ ItclDestroyClassNamesp(
      *  Scan through and find all objects that belong to this class.
      *  Destroy them quietly by deleting their access command.
      */
-    hPtr = Tcl_FirstHashEntry(&iclsPtr->infoPtr->objects, &place);
-    while (hPtr) {
-        ioPtr = (ItclObject*)Tcl_GetHashValue(hPtr);
-        if (ioPtr->iclsPtr == iclsPtr) {
-	    if ((ioPtr->accessCmd != NULL) && (!(ioPtr->flags &
-	            (ITCL_OBJECT_IS_DESTRUCTED)))) {
-		ItclPreserveObject(ioPtr);
-                Tcl_DeleteCommandFromToken(iclsPtr->interp, ioPtr->accessCmd);
-	        ioPtr->accessCmd = NULL;
-		ItclReleaseObject(ioPtr);
-	        /*
-	         * Fix 227804: Whenever an object to delete was found we
-	         * have to reset the search to the beginning as the
-	         * current entry in the search was deleted and accessing it
-	         * is therefore not allowed anymore.
-	         */
-
-	        hPtr = Tcl_FirstHashEntry(&iclsPtr->infoPtr->objects, &place);
-	        continue;
-	    }
-        }
-        hPtr = Tcl_NextHashEntry(&place);
+    ioPtr = iclsPtr->firstInstancePtr;
+    while (ioPtr) {
+	if ((ioPtr->accessCmd != NULL) && (!(ioPtr->flags &
+		(ITCL_OBJECT_IS_DESTRUCTED)))) {
+	    ItclPreserveObject(ioPtr);
+	    Tcl_DeleteCommandFromToken(iclsPtr->interp, ioPtr->accessCmd);
+	    ioPtr->accessCmd = NULL;
+	    ItclRemoveInstance(ioPtr);
+	    ItclReleaseObject(ioPtr);
+	    /*
+	     * Fix 227804: Deleting the object may have deleted others
+	     * too, so restart at the beginning of the instance list.
+	     */
+
+	    ioPtr = iclsPtr->firstInstancePtr;
+	    continue;
+	}
+        ioPtr = ioPtr->nextInstancePtr;
     }
 
     /*
@@ -1091,6 +1091,7 @@ ItclFreeClass(
     }
 
     Tcl_DeleteHashTable(&iclsPtr->resolveVars);
+    Tcl_DeleteHashTable(&iclsPtr->publicOptions);
 
     /*
      *  Tear down the virtual method table...
@@ -1190,7 +1191,23 @@ ItclFreeClass(
         elem = Itcl_NextListElem(elem);
     }
     Itcl_DeleteList(&iclsPtr->bases);
-    Tcl_DeleteHashTable(&iclsPtr->heritage);
+    if (iclsPtr->hierarchy != NULL) {
+        ckfree((char *)iclsPtr->hierarchy);
+        iclsPtr->hierarchy = NULL;
+        iclsPtr->numHierarchy = 0;
+    }
+    if (iclsPtr->heritageIds != NULL) {
+        ckfree((char *)iclsPtr->heritageIds);
+        iclsPtr->heritageIds = NULL;
+        iclsPtr->numHeritageIds = 0;
+    }
+    if (iclsPtr->slotBases != NULL) {
+        ckfree((char *)iclsPtr->slotBases);
+        iclsPtr->slotBases = NULL;
+        iclsPtr->numSlotBases = 0;
+    }
+    ItclFreeMethodNameCache(iclsPtr);
+    ItclFreeInstancePlan(iclsPtr);
 
     /* remove owerself from the all classes entry */
     hPtr = Tcl_FindHashEntry(&iclsPtr->infoPtr->nameClasses,
@@ -1204,6 +1221,7 @@ ItclFreeClass(
             (char *)iclsPtr->nsPtr);
     if (hPtr != NULL) {
         Tcl_DeleteHashEntry(hPtr);
+        iclsPtr->infoPtr->classEpoch++;
     }
 
     /* remove owerself from the all classes entry */
@@ -1727,7 +1745,6 @@ Itcl_BuildVirtualTables(
     ItclVariable *ivPtr;
     ItclMemberFunc *imPtr;
     ItclDelegatedFunction *idmPtr;
-    ItclHierIter hier;
     ItclClass *iclsPtr2;
     ItclCmdLookup *clookupPtr;
 #ifdef NEW_PROTO_RESOLVER
@@ -1735,10 +1752,19 @@ Itcl_BuildVirtualTables(
     ItclClassCmdInfo *icciPtr;
 #endif
     int newEntry;
+    int hierIdx;
+    int i;
 
     Tcl_DStringInit(&buffer);
     Tcl_DStringInit(&buffer2);
 
+    /*
+     *  Invalidate the method names mapped for objects of this class,
+     *  and the instantiation plans of this class and its derived classes.
+     */
+    iclsPtr->generation++;
+    ItclInvalidateInstancePlans(iclsPtr);
+
     /*
      *  Clear the variable resolution table.
      */
@@ -1752,6 +1778,8 @@ Itcl_BuildVirtualTables(
     }
     Tcl_DeleteHashTable(&iclsPtr->resolveVars);
     Tcl_InitHashTable(&iclsPtr->resolveVars, TCL_STRING_KEYS);
+    Tcl_DeleteHashTable(&iclsPtr->publicOptions);
+    Tcl_InitHashTable(&iclsPtr->publicOptions, TCL_STRING_KEYS);
     iclsPtr->numInstanceVars = 0;
 
     /*
@@ -1770,9 +1798,8 @@ Itcl_BuildVirtualTables(
      *  least specific.  Add a lookup entry for each variable
      *  into the table.
      */
-    Itcl_InitHierIter(&hier, iclsPtr);
-    iclsPtr2 = Itcl_AdvanceHierIter(&hier);
-    while (iclsPtr2 != NULL) {
+    for (hierIdx = 0; hierIdx < iclsPtr->numHierarchy; hierIdx++) {
+        iclsPtr2 = iclsPtr->hierarchy[hierIdx];
         hPtr = Tcl_FirstHashEntry(&iclsPtr2->variables, &place);
         while (hPtr) {
 #ifdef NEW_PROTO_RESOLVER
@@ -1852,6 +1879,20 @@ Itcl_BuildVirtualTables(
                         vlookup->leastQualName =
                             Tcl_GetHashKey(&iclsPtr->resolveVars, hPtr);
                     }
+
+		    /*
+		     *  Public variables are configuration options under
+		     *  each of their names.
+		     */
+		    if (ivPtr->protection == ITCL_PUBLIC) {
+			Tcl_DStringSetLength(&buffer2, 0);
+			Tcl_DStringAppend(&buffer2, "-", 1);
+			Tcl_DStringAppend(&buffer2,
+			        Tcl_DStringValue(&buffer), -1);
+			hPtr = Tcl_CreateHashEntry(&iclsPtr->publicOptions,
+			        Tcl_DStringValue(&buffer2), &newEntry);
+			Tcl_SetHashValue(hPtr, (ClientData)vlookup);
+		    }
 #ifdef NEW_PROTO_RESOLVER
                     Itcl_RegisterClassVariable(iclsPtr->infoPtr->interp,
 		        iclsPtr->nsPtr, Tcl_DStringValue(&buffer),
@@ -1880,9 +1921,7 @@ Itcl_BuildVirtualTables(
             }
             hPtr = Tcl_NextHashEntry(&place);
         }
-        iclsPtr2 = Itcl_AdvanceHierIter(&hier);
     }
-    Itcl_DeleteHierIter(&hier);
 
     /*
      *  Clear the command resolution table.
@@ -1904,9 +1943,8 @@ Itcl_BuildVirtualTables(
      *  least specific.  Look for the first (most-specific) definition
      *  of each member function, and enter it into the table.
      */
-    Itcl_InitHierIter(&hier, iclsPtr);
-    iclsPtr2 = Itcl_AdvanceHierIter(&hier);
-    while (iclsPtr2 != NULL) {
+    for (hierIdx = 0; hierIdx < iclsPtr->numHierarchy; hierIdx++) {
+        iclsPtr2 = iclsPtr->hierarchy[hierIdx];
         hPtr = Tcl_FirstHashEntry(&iclsPtr2->functions, &place);
         while (hPtr) {
             imPtr = (ItclMemberFunc*)Tcl_GetHashValue(hPtr);
@@ -1970,18 +2008,56 @@ Itcl_BuildVirtualTables(
             }
             hPtr = Tcl_NextHashEntry(&place);
         }
-        iclsPtr2 = Itcl_AdvanceHierIter(&hier);
     }
-    Itcl_DeleteHierIter(&hier);
+
+    /*
+     *  Scan through all classes in the hierarchy, from most to
+     *  least specific, and lay out the call context slots of their
+     *  member functions one class after the other.  Objects of this
+     *  class find the slot for a function as the offset of the
+     *  function's class plus the function's own slot number.
+     */
+    if (iclsPtr->slotBases != NULL) {
+        ckfree((char *)iclsPtr->slotBases);
+    }
+    iclsPtr->slotBases = (ItclSlotBase *)ckalloc(
+            iclsPtr->numHierarchy * sizeof(ItclSlotBase));
+    iclsPtr->numSlotBases = 0;
+    iclsPtr->numMethodSlots = 0;
+    for (hierIdx = 0; hierIdx < iclsPtr->numHierarchy; hierIdx++) {
+        iclsPtr2 = iclsPtr->hierarchy[hierIdx];
+        iclsPtr->slotBases[iclsPtr->numSlotBases].iclsPtr = iclsPtr2;
+        iclsPtr->slotBases[iclsPtr->numSlotBases].offset =
+	        iclsPtr->numMethodSlots;
+        iclsPtr->numSlotBases++;
+        iclsPtr->numMethodSlots += iclsPtr2->numFunctionSlots;
+    }
+
+    /*
+     *  Lay out the object variable slots of the data members the same
+     *  way, except that the slots of this class itself come last.
+     *  Data members added to a single object later on (see
+     *  Itcl_AddComponentCmd) extend this class, and must not run into
+     *  the slots of a base class.
+     */
+    iclsPtr->numObjectVarSlots = 0;
+    for (i = 1; i < iclsPtr->numSlotBases; i++) {
+        iclsPtr->slotBases[i].varOffset = iclsPtr->numObjectVarSlots;
+        iclsPtr->slotBases[i].numVars =
+	        iclsPtr->slotBases[i].iclsPtr->numVariableSlots;
+        iclsPtr->numObjectVarSlots += iclsPtr->slotBases[i].numVars;
+    }
+    iclsPtr->slotBases[0].varOffset = iclsPtr->numObjectVarSlots;
+    iclsPtr->slotBases[0].numVars = iclsPtr->numVariableSlots;
+    iclsPtr->numObjectVarSlots += iclsPtr->numVariableSlots;
 
     /*
      *  Scan through all classes in the hierarchy, from most to
      *  least specific.  Look for the first (most-specific) definition
      *  of each delegated member function, and enter it into the table.
      */
-    Itcl_InitHierIter(&hier, iclsPtr);
-    iclsPtr2 = Itcl_AdvanceHierIter(&hier);
-    while (iclsPtr2 != NULL) {
+    for (hierIdx = 0; hierIdx < iclsPtr->numHierarchy; hierIdx++) {
+        iclsPtr2 = iclsPtr->hierarchy[hierIdx];
         hPtr = Tcl_FirstHashEntry(&iclsPtr2->delegatedFunctions, &place);
         while (hPtr) {
             idmPtr = (ItclDelegatedFunction *)Tcl_GetHashValue(hPtr);
@@ -1994,9 +2070,21 @@ Itcl_BuildVirtualTables(
 	    }
             hPtr = Tcl_NextHashEntry(&place);
         }
-        iclsPtr2 = Itcl_AdvanceHierIter(&hier);
     }
-    Itcl_DeleteHierIter(&hier);
+
+    /*
+     *  Remember the entry of "delegate method *", so that calls of
+     *  unknown methods need not look it up by name.
+     */
+    objPtr = Tcl_NewStringObj("*", -1);
+    Tcl_IncrRefCount(objPtr);
+    hPtr = Tcl_FindHashEntry(&iclsPtr->delegatedFunctions, (char *)objPtr);
+    Tcl_DecrRefCount(objPtr);
+    iclsPtr->delegateAllPtr = NULL;
+    if (hPtr != NULL) {
+        iclsPtr->delegateAllPtr =
+	        (ItclDelegatedFunction *)Tcl_GetHashValue(hPtr);
+    }
 
     Tcl_DStringFree(&buffer);
     Tcl_DStringFree(&buffer2);
@@ -2071,6 +2159,8 @@ Itcl_CreateVariable(
     ivPtr->protection   = Itcl_Protection(interp, 0);
     ivPtr->codePtr      = mCodePtr;
     ivPtr->namePtr      = namePtr;
+    ivPtr->slot         = iclsPtr->numVariableSlots++;
+    ItclInvalidateInstancePlans(iclsPtr);
     Tcl_IncrRefCount(ivPtr->namePtr);
     ivPtr->fullNamePtr = Tcl_NewStringObj(
             Tcl_GetString(iclsPtr->fullNamePtr), -1);
@@ -2096,6 +2186,63 @@ Itcl_CreateVariable(
     *ivPtrPtr = ivPtr;
     return TCL_OK;
 }
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclSetVariableArrayInit()
+ *
+ *  Stores the "-array" initializer of a variable.  Besides the string,
+ *  which is reported by the info commands, the initializer is split
+ *  once here into its element names and values, so initializing the
+ *  variable for each object needs no list parsing.
+ *
+ *  Returns TCL_OK/TCL_ERROR to indicate success/failure.
+ * ------------------------------------------------------------------------
+ */
+int
+ItclSetVariableArrayInit(
+    Tcl_Interp *interp,       /* interpreter managing this transaction */
+    ItclVariable *ivPtr,      /* variable definition */
+    const char *arrayInitStr) /* initializer or NULL for none */
+{
+    Tcl_Obj *listPtr;
+    Tcl_Obj **objv;
+    int objc;
+    int i;
+
+    ivPtr->arrayInitPtr = NULL;
+    ivPtr->arrayInitv = NULL;
+    ivPtr->arrayInitc = 0;
+    if (arrayInitStr == NULL) {
+        return TCL_OK;
+    }
+    listPtr = Tcl_NewStringObj(arrayInitStr, -1);
+    Tcl_IncrRefCount(listPtr);
+    if (Tcl_ListObjGetElements(interp, listPtr, &objc, &objv) != TCL_OK) {
+        Tcl_DecrRefCount(listPtr);
+        return TCL_ERROR;
+    }
+    if (objc & 1) {
+        Tcl_AppendStringsToObj(Tcl_GetObjResult(interp),
+	    "array initializer of variable \"",
+	    Tcl_GetString(ivPtr->namePtr),
+	    "\" must have an even number of elements", (char*)NULL);
+        Tcl_DecrRefCount(listPtr);
+        return TCL_ERROR;
+    }
+    if (objc > 0) {
+	ivPtr->arrayInitv = (Tcl_Obj **)ckalloc(objc * sizeof(Tcl_Obj *));
+	for (i = 0; i < objc; i++) {
+	    ivPtr->arrayInitv[i] = objv[i];
+	    Tcl_IncrRefCount(objv[i]);
+	}
+	ivPtr->arrayInitc = objc;
+    }
+    Tcl_DecrRefCount(listPtr);
+    ivPtr->arrayInitPtr = Tcl_NewStringObj(arrayInitStr, -1);
+    Tcl_IncrRefCount(ivPtr->arrayInitPtr);
+    return TCL_OK;
+}
 
 /*
  * ------------------------------------------------------------------------
@@ -2332,6 +2479,154 @@ Itcl_GetCommonVar(
 }
 
 
+/*
+ * ------------------------------------------------------------------------
+ *  ItclBuildHierarchy()
+ *
+ *  Fills the hierarchy array of a class with the class itself followed
+ *  by all of its base classes, in the order an ItclHierIter visits
+ *  them: depth first, with the bases of each class in the order of
+ *  its "inherit" statement.  Hot paths walk this array instead of
+ *  running an iterator.  Also sets the sorted heritageIds used by
+ *  ITCL_CLASS_ISA.  Invoked when a class is created and when its
+ *  base classes are set, and rebuilds the arrays of derived classes
+ *  as well.
+ *
+ *  Returns the first class that appears more than once in the
+ *  hierarchy, or NULL if there is none.
+ * ------------------------------------------------------------------------
+ */
+ItclClass *
+ItclBuildHierarchy(
+    ItclClass *iclsPtr)      /* class whose hierarchy has changed */
+{
+    Itcl_ListElem *elem;
+    ItclClass *basePtr;
+    HeritageEntry space[ITCL_HERITAGE_SPACE];
+    HeritageEntry *entries;
+    int dupPos;
+    int num;
+    int i;
+
+    num = 1;
+    for (elem = Itcl_FirstListElem(&iclsPtr->bases); elem != NULL;
+            elem = Itcl_NextListElem(elem)) {
+        basePtr = (ItclClass *)Itcl_GetListValue(elem);
+        num += basePtr->numHierarchy;
+    }
+    if (iclsPtr->hierarchy != NULL) {
+        ckfree((char *)iclsPtr->hierarchy);
+    }
+    iclsPtr->hierarchy = (ItclClass **)ckalloc(num * sizeof(ItclClass *));
+    iclsPtr->hierarchy[0] = iclsPtr;
+    iclsPtr->numHierarchy = 1;
+    for (elem = Itcl_FirstListElem(&iclsPtr->bases); elem != NULL;
+            elem = Itcl_NextListElem(elem)) {
+        basePtr = (ItclClass *)Itcl_GetListValue(elem);
+        memcpy(iclsPtr->hierarchy + iclsPtr->numHierarchy,
+	        basePtr->hierarchy, basePtr->numHierarchy * sizeof(ItclClass *));
+        iclsPtr->numHierarchy += basePtr->numHierarchy;
+    }
+
+    /*
+     *  Sort the classIds along with their positions in the hierarchy.
+     *  A class that appears more than once shows up as a run of equal
+     *  ids, and the smallest position after the first of a run is
+     *  where the hierarchy first repeats a class.
+     */
+    num = iclsPtr->numHierarchy;
+    entries = space;
+    if (num > ITCL_HERITAGE_SPACE) {
+        entries = (HeritageEntry *)ckalloc(num * sizeof(HeritageEntry));
+    }
+    for (i = 0; i < num; i++) {
+        entries[i].classId = iclsPtr->hierarchy[i]->classId;
+        entries[i].pos = i;
+    }
+    qsort(entries, num, sizeof(HeritageEntry), CompareHeritageEntries);
+    if (iclsPtr->heritageIds != NULL) {
+        ckfree((char *)iclsPtr->heritageIds);
+    }
+    iclsPtr->heritageIds = (int *)ckalloc(num * sizeof(int));
+    iclsPtr->numHeritageIds = 0;
+    dupPos = num;
+    for (i = 0; i < num; i++) {
+        if ((iclsPtr->numHeritageIds > 0) && (entries[i].classId
+	        == iclsPtr->heritageIds[iclsPtr->numHeritageIds - 1])) {
+	    if (entries[i].pos < dupPos) {
+	        dupPos = entries[i].pos;
+	    }
+	    continue;
+	}
+        iclsPtr->heritageIds[iclsPtr->numHeritageIds++] = entries[i].classId;
+    }
+    if (entries != space) {
+        ckfree((char *)entries);
+    }
+
+    for (elem = Itcl_FirstListElem(&iclsPtr->derived); elem != NULL;
+            elem = Itcl_NextListElem(elem)) {
+        ItclBuildHierarchy((ItclClass *)Itcl_GetListValue(elem));
+    }
+    return (dupPos < num) ? iclsPtr->hierarchy[dupPos] : NULL;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  CompareHeritageEntries()
+ *
+ *  qsort() comparison for ItclBuildHierarchy: by classId, then by
+ *  position in the hierarchy.
+ * ------------------------------------------------------------------------
+ */
+static int
+CompareHeritageEntries(
+    const void *a,
+    const void *b)
+{
+    const HeritageEntry *aPtr = (const HeritageEntry *)a;
+    const HeritageEntry *bPtr = (const HeritageEntry *)b;
+
+    if (aPtr->classId != bPtr->classId) {
+        return (aPtr->classId < bPtr->classId) ? -1 : 1;
+    }
+    return aPtr->pos - bPtr->pos;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclHeritageHasId()
+ *
+ *  Returns 1 if the class numbered "classId" is in the hierarchy of
+ *  "iclsPtr", and 0 otherwise.  Does a binary search of the sorted
+ *  heritageIds, see ITCL_CLASS_ISA.
+ * ------------------------------------------------------------------------
+ */
+int
+ItclHeritageHasId(
+    ItclClass *iclsPtr,      /* class whose hierarchy is searched */
+    int classId)             /* number of the class to look for */
+{
+    int lo;
+    int hi;
+    int mid;
+
+    lo = 0;
+    hi = iclsPtr->numHeritageIds - 1;
+    while (lo <= hi) {
+        mid = (lo + hi) / 2;
+        if (iclsPtr->heritageIds[mid] == classId) {
+	    return 1;
+	}
+	if (iclsPtr->heritageIds[mid] < classId) {
+	    lo = mid + 1;
+	} else {
+	    hi = mid - 1;
+	}
+    }
+    return 0;
+}
+
 /*
  * ------------------------------------------------------------------------
  *  Itcl_InitHierIter()
@@ -2438,6 +2733,14 @@ if (ivPtr->arrayInitPtr != NULL) {
     if (ivPtr->arrayInitPtr) {
         Tcl_DecrRefCount(ivPtr->arrayInitPtr);
     }
+    if (ivPtr->arrayInitv != NULL) {
+	int i;
+
+        for (i = 0; i < ivPtr->arrayInitc; i++) {
+	    Tcl_DecrRefCount(ivPtr->arrayInitv[i]);
+	}
+        ckfree((char*)ivPtr->arrayInitv);
+    }
     ckfree((char*)ivPtr);
 }
 
@@ -286,6 +286,123 @@ Itcl_FindClassesCmd(
     return TCL_OK;
 }
 
+
+/*
+ * ------------------------------------------------------------------------
+ *  AppendInstanceNames()
+ *
+ *  Appends the names of the objects whose most-specific class is
+ *  "iclsPtr" and which match "pattern" to "listPtr".  Names are
+ *  reported the same way Itcl_FindObjectsCmd does when scanning the
+ *  namespaces: short names for objects living in the current namespace,
+ *  full names otherwise.
+ * ------------------------------------------------------------------------
+ */
+static void
+AppendInstanceNames(
+    Tcl_Interp *interp,      /* current interpreter */
+    ItclClass *iclsPtr,      /* report instances of this class */
+    const char *prefix,      /* qualifier of the names in the current
+                              * namespace, NULL to report full names */
+    const char *pattern,     /* pattern for the names or NULL */
+    Tcl_Obj *listPtr)        /* list to append to */
+{
+    ItclObject *ioPtr;
+    Tcl_Obj *objPtr;
+    const char *name;
+    const char *cmdName;
+
+    for (ioPtr = iclsPtr->firstInstancePtr; ioPtr != NULL;
+            ioPtr = ioPtr->nextInstancePtr) {
+        if (ioPtr->accessCmd == NULL) {
+	    continue;
+	}
+	objPtr = Tcl_NewObj();
+	Tcl_GetCommandFullName(interp, ioPtr->accessCmd, objPtr);
+	name = Tcl_GetString(objPtr);
+	if (prefix != NULL) {
+	    cmdName = Tcl_GetCommandName(interp, ioPtr->accessCmd);
+	    if ((strlen(name) == strlen(prefix) + strlen(cmdName))
+	            && (strncmp(name, prefix, strlen(prefix)) == 0)) {
+		Tcl_DecrRefCount(objPtr);
+		objPtr = Tcl_NewStringObj(cmdName, -1);
+		name = cmdName;
+	    }
+	}
+	if (!pattern || Tcl_StringMatch(name, pattern)) {
+	    Tcl_ListObjAppendElement(NULL, listPtr, objPtr);
+	} else {
+	    Tcl_DecrRefCount(objPtr);
+	}
+    }
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  FindInstances()
+ *
+ *  Implements "find objects" with a "-class" and/or "-isa" option.
+ *  Walks the instance lists of the classes in question, instead of
+ *  all commands in the interpreter.  For "-isa" these are the class
+ *  and all classes derived from it.
+ * ------------------------------------------------------------------------
+ */
+static int
+FindInstances(
+    Tcl_Interp *interp,      /* current interpreter */
+    ItclClass *iclsPtr,      /* value of -class or NULL */
+    ItclClass *isaDefn,      /* value of -isa or NULL */
+    const char *pattern,     /* pattern for the names or NULL */
+    int forceFullNames)      /* report full names only */
+{
+    Tcl_Namespace *activeNs = Tcl_GetCurrentNamespace(interp);
+    Tcl_HashTable visited;
+    Tcl_DString prefix;
+    Itcl_Stack search;
+    Itcl_ListElem *elem;
+    ItclClass *iclsPtr2;
+    Tcl_Obj *listPtr;
+    const char *prefixStr;
+    int newEntry;
+
+    Tcl_DStringInit(&prefix);
+    prefixStr = NULL;
+    if (!forceFullNames) {
+        if (activeNs != Tcl_GetGlobalNamespace(interp)) {
+	    Tcl_DStringAppend(&prefix, activeNs->fullName, -1);
+	}
+	Tcl_DStringAppend(&prefix, "::", 2);
+	prefixStr = Tcl_DStringValue(&prefix);
+    }
+    listPtr = Tcl_GetObjResult(interp);
+    if (iclsPtr != NULL) {
+        if ((isaDefn == NULL) || ITCL_CLASS_ISA(iclsPtr, isaDefn)) {
+	    AppendInstanceNames(interp, iclsPtr, prefixStr, pattern, listPtr);
+	}
+	Tcl_DStringFree(&prefix);
+	return TCL_OK;
+    }
+
+    Tcl_InitHashTable(&visited, TCL_ONE_WORD_KEYS);
+    Itcl_InitStack(&search);
+    Itcl_PushStack((ClientData)isaDefn, &search);
+    while (Itcl_GetStackSize(&search) > 0) {
+        iclsPtr2 = (ItclClass *)Itcl_PopStack(&search);
+	Tcl_CreateHashEntry(&visited, (char *)iclsPtr2, &newEntry);
+	if (!newEntry) {
+	    continue;
+	}
+	AppendInstanceNames(interp, iclsPtr2, prefixStr, pattern, listPtr);
+        for (elem = Itcl_LastListElem(&iclsPtr2->derived); elem != NULL;
+	        elem = Itcl_PrevListElem(elem)) {
+	    Itcl_PushStack(Itcl_GetListValue(elem), &search);
+	}
+    }
+    Itcl_DeleteStack(&search);
+    Tcl_DeleteHashTable(&visited);
+    Tcl_DStringFree(&prefix);
+    return TCL_OK;
+}
 
 /*
  * ------------------------------------------------------------------------
@@ -384,6 +501,10 @@ Itcl_FindObjectsCmd(
             "?-class className? ?-isa className? ?pattern?");
         return TCL_ERROR;
     }
+    if ((iclsPtr != NULL) || (isaDefn != NULL)) {
+        return FindInstances(interp, iclsPtr, isaDefn, pattern,
+	        forceFullNames);
+    }
 
     /*
      *  Search through all commands in the current namespace first,
@@ -415,6 +536,11 @@ Itcl_FindObjectsCmd(
                 }
 		Tcl_GetCommandInfoFromToken(cmd, &cmdInfo);
                 contextIoPtr = (ItclObject*)cmdInfo.deleteData;
+		if (contextIoPtr->flags & ITCL_OBJECT_IS_DEFERRED) {
+		    /* waiting for its deferred deletion */
+		    entry = Tcl_NextHashEntry(&place);
+		    continue;
+		}
 
                 /*
                  *  Report full names if:
@@ -444,16 +570,9 @@ Itcl_FindObjectsCmd(
 			pattern))) {
                     if ((iclsPtr == NULL) ||
 		            (contextIoPtr->iclsPtr == iclsPtr)) {
-                        if (isaDefn == NULL) {
+                        if ((isaDefn == NULL) || ITCL_CLASS_ISA(
+			        contextIoPtr->iclsPtr, isaDefn)) {
                             match = 1;
-                        } else {
-                            entry = Tcl_FindHashEntry(
-                                &contextIoPtr->iclsPtr->heritage,
-                                (char*)isaDefn);
-
-                            if (entry) {
-                                match = 1;
-                            }
                         }
                     }
                 }
@@ -561,7 +680,12 @@ Itcl_DelClassCmd(
  *  issues a "delete object" command to delete [incr Tcl] objects.
  *  Handles the following syntax:
  *
- *    delete object <name> ?<name>...?
+ *    delete object ?-deferred? ?--? <name> ?<name>...?
+ *
+ *  "--" ends the options, so that objects named "-deferred" can be
+ *  deleted too.  With "-deferred" all names are looked up first, then
+ *  the objects are taken out of reach right away, and destructed and
+ *  freed later from the event loop by ItclRunDeferredDeletions().
  *
  *  Returns TCL_OK/TCL_ERROR to indicate success/failure.
  * ------------------------------------------------------------------------
@@ -584,6 +708,41 @@ CallDeleteObject(
     return result;
 }
 
+static int
+DelObjectDeferred(
+    Tcl_Interp *interp,      /* current interpreter */
+    int objc,                /* number of object names */
+    Tcl_Obj *const objv[])   /* object names */
+{
+    ItclObject **ioPtrs;
+    char *name;
+    int result;
+    int i;
+
+    ioPtrs = (ItclObject **)ckalloc(sizeof(ItclObject *) * (objc + 1));
+    for (i = 0; i < objc; i++) {
+        name = Tcl_GetString(objv[i]);
+	ioPtrs[i] = NULL;
+        if (Itcl_FindObject(interp, name, &ioPtrs[i]) != TCL_OK) {
+	    ckfree((char *)ioPtrs);
+            return TCL_ERROR;
+        }
+        if (ioPtrs[i] == NULL) {
+            Tcl_AppendStringsToObj(Tcl_GetObjResult(interp),
+                "object \"", name, "\" not found",
+                (char*)NULL);
+	    ckfree((char *)ioPtrs);
+            return TCL_ERROR;
+        }
+    }
+    result = TCL_OK;
+    for (i = 0; (i < objc) && (result == TCL_OK); i++) {
+        result = ItclDeferObjectDeletion(interp, ioPtrs[i]);
+    }
+    ckfree((char *)ioPtrs);
+    return result;
+}
+
 static int
 NRDelObjectCmd(
     ClientData clientData,   /* object management info */
@@ -594,16 +753,31 @@ NRDelObjectCmd(
     ItclObject *contextIoPtr;
     char *name;
     void *callbackPtr;
+    int first;
+    int deferred;
     int i;
     int result;
 
     ItclShowArgs(1, "Itcl_DelObjectCmd", objc, objv);
+    first = 1;
+    deferred = 0;
+    if ((first < objc)
+            && (strcmp(Tcl_GetString(objv[first]), "-deferred") == 0)) {
+        deferred = 1;
+        first++;
+    }
+    if ((first < objc) && (strcmp(Tcl_GetString(objv[first]), "--") == 0)) {
+        first++;
+    }
+    if (deferred) {
+        return DelObjectDeferred(interp, objc-first, objv+first);
+    }
     /*
      *  Scan through the list of objects and attempt to delete them.
      *  If anything goes wrong (i.e., destructors fail), then
      *  abort with an error.
      */
-    for (i=1; i < objc; i++) {
+    for (i=first; i < objc; i++) {
         name = Tcl_GetStringFromObj(objv[i], (int*)NULL);
 	contextIoPtr = NULL;
         if (Itcl_FindObject(interp, name, &contextIoPtr) != TCL_OK) {
@@ -638,8 +812,111 @@ Itcl_DelObjectCmd(
 {
     return Tcl_NRCallObjProc(interp, NRDelObjectCmd, clientData, objc, objv);
 }
-
-
+
+/*
+ * ------------------------------------------------------------------------
+ *  Itcl_DeferredBudgetCmd()
+ *
+ *  Part of the "deferred" ensemble.  Handles the following syntax:
+ *
+ *    deferred budget ?<microseconds>?
+ *
+ *  Sets or returns the time one slice of deferred object deletions may
+ *  take before control returns to the event loop.
+ * ------------------------------------------------------------------------
+ */
+int
+Itcl_DeferredBudgetCmd(
+    ClientData clientData,   /* object management info */
+    Tcl_Interp *interp,      /* current interpreter */
+    int objc,                /* number of arguments */
+    Tcl_Obj *const objv[])   /* argument objects */
+{
+    ItclObjectInfo *infoPtr = (ItclObjectInfo *)clientData;
+    int budget;
+
+    ItclShowArgs(1, "Itcl_DeferredBudgetCmd", objc, objv);
+    if (objc > 2) {
+        Tcl_WrongNumArgs(interp, 1, objv, "?microseconds?");
+        return TCL_ERROR;
+    }
+    if (objc == 2) {
+        if (Tcl_GetIntFromObj(interp, objv[1], &budget) != TCL_OK) {
+	    return TCL_ERROR;
+	}
+	if (budget < 0) {
+            Tcl_AppendResult(interp, "bad budget \"",
+	            Tcl_GetString(objv[1]),
+		    "\": must be a non-negative integer", NULL);
+            return TCL_ERROR;
+	}
+	infoPtr->deferredBudget = budget;
+    }
+    Tcl_SetObjResult(interp, Tcl_NewIntObj(infoPtr->deferredBudget));
+    return TCL_OK;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  Itcl_DeferredPendingCmd()
+ *
+ *  Part of the "deferred" ensemble.  Handles the following syntax:
+ *
+ *    deferred pending
+ *
+ *  Returns the number of objects waiting for their deferred deletion.
+ * ------------------------------------------------------------------------
+ */
+int
+Itcl_DeferredPendingCmd(
+    ClientData clientData,   /* object management info */
+    Tcl_Interp *interp,      /* current interpreter */
+    int objc,                /* number of arguments */
+    Tcl_Obj *const objv[])   /* argument objects */
+{
+    ItclObjectInfo *infoPtr = (ItclObjectInfo *)clientData;
+
+    ItclShowArgs(1, "Itcl_DeferredPendingCmd", objc, objv);
+    if (objc != 1) {
+        Tcl_WrongNumArgs(interp, 1, objv, "");
+        return TCL_ERROR;
+    }
+    Tcl_SetObjResult(interp, Tcl_NewIntObj(
+            Itcl_GetListLength(&infoPtr->deferredObjects)));
+    return TCL_OK;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  Itcl_DeferredFlushCmd()
+ *
+ *  Part of the "deferred" ensemble.  Handles the following syntax:
+ *
+ *    deferred flush
+ *
+ *  Destructs and frees all objects waiting for their deferred deletion
+ *  right away.  Returns the number of objects handled.
+ * ------------------------------------------------------------------------
+ */
+int
+Itcl_DeferredFlushCmd(
+    ClientData clientData,   /* object management info */
+    Tcl_Interp *interp,      /* current interpreter */
+    int objc,                /* number of arguments */
+    Tcl_Obj *const objv[])   /* argument objects */
+{
+    ItclObjectInfo *infoPtr = (ItclObjectInfo *)clientData;
+
+    ItclShowArgs(1, "Itcl_DeferredFlushCmd", objc, objv);
+    if (objc != 1) {
+        Tcl_WrongNumArgs(interp, 1, objv, "");
+        return TCL_ERROR;
+    }
+    Tcl_SetObjResult(interp,
+            Tcl_NewIntObj(ItclRunDeferredDeletions(infoPtr, -1)));
+    return TCL_OK;
+}
+
 /*
  * ------------------------------------------------------------------------
  *  Itcl_ScopeCmd()
@@ -802,6 +1079,10 @@ Itcl_ScopeCmd(
             result = TCL_ERROR;
             goto scopeCmdDone;
         }
+        if (ItclLinkObjectVarNamespaces(interp, contextIoPtr) != TCL_OK) {
+            result = TCL_ERROR;
+            goto scopeCmdDone;
+        }
 
         doAppend = 1;
         if (contextIclsPtr->flags & ITCL_ECLASS) {
@@ -1164,7 +1445,326 @@ Itcl_IsClassCmd(
     return TCL_OK;
 
 } /* end Itcl_IsClassCmd function */
+
+/*
+ * ------------------------------------------------------------------------
+ *  Itcl_NewCmd()
+ *
+ *  Invoked by Tcl whenever the user issues an "itcl::new" command to
+ *  create several objects of a class at once.  Handles the following
+ *  syntax:
+ *
+ *    itcl::new className ?-count n? ?-names varName? ?--? ?arg arg ...?
+ *
+ *  Creates "n" objects (default 1) named like "className #auto" and
+ *  passes the remaining arguments to each constructor.  Returns the
+ *  list of object names, or, if "-names" is given, stores that list
+ *  in the variable "varName" and returns the number of objects.
+ * ------------------------------------------------------------------------
+ */
+int
+Itcl_NewCmd(
+    ClientData clientData,   /* class/object info */
+    Tcl_Interp *interp,      /* current interpreter */
+    int objc,                /* number of arguments */
+    Tcl_Obj *const objv[])   /* argument objects */
+{
+    static const char *const options[] = {
+        "--", "-count", "-names", NULL
+    };
+    enum newOptIdx {
+        NEW_LAST, NEW_COUNT, NEW_NAMES
+    };
+    ItclClass *iclsPtr;
+    Tcl_Obj *namesPtr;
+    Tcl_Obj *varNamePtr;
+    int count;
+    int idx;
+    int pos;
+
+    ItclShowArgs(1, "Itcl_NewCmd", objc, objv);
+    if (objc < 2) {
+        Tcl_WrongNumArgs(interp, 1, objv,
+	        "className ?-count n? ?-names varName? ?--? ?arg arg ...?");
+        return TCL_ERROR;
+    }
+    iclsPtr = Itcl_FindClass(interp, Tcl_GetString(objv[1]),
+            /* autoload */ 1);
+    if (iclsPtr == NULL) {
+        return TCL_ERROR;
+    }
+
+    count = 1;
+    varNamePtr = NULL;
+    for (pos = 2; pos < objc; pos++) {
+        if (Tcl_GetString(objv[pos])[0] != '-') {
+            break;
+        }
+        if (Tcl_GetIndexFromObj(NULL, objv[pos], options, "option", 0,
+                &idx) != TCL_OK) {
+            /* constructor arguments may start with "-" */
+            break;
+        }
+        if (idx == NEW_LAST) {
+            pos++;
+            break;
+        }
+        if (pos + 1 >= objc) {
+            Tcl_AppendResult(interp, "missing value for option \"",
+	            Tcl_GetString(objv[pos]), "\"", NULL);
+            return TCL_ERROR;
+        }
+        pos++;
+        if (idx == NEW_COUNT) {
+            if (Tcl_GetIntFromObj(interp, objv[pos], &count) != TCL_OK) {
+                return TCL_ERROR;
+            }
+            if (count < 0) {
+                Tcl_AppendResult(interp, "bad count \"",
+		        Tcl_GetString(objv[pos]),
+			"\": must be a non-negative integer", NULL);
+                return TCL_ERROR;
+            }
+        } else {
+            varNamePtr = objv[pos];
+        }
+    }
+
+    if (Itcl_CreateObjects(interp, iclsPtr, count, objc - pos, objv + pos,
+            &namesPtr) != TCL_OK) {
+        return TCL_ERROR;
+    }
+    if (varNamePtr != NULL) {
+        if (Tcl_ObjSetVar2(interp, varNamePtr, NULL, namesPtr,
+	        TCL_LEAVE_ERR_MSG) == NULL) {
+            return TCL_ERROR;
+        }
+        Tcl_SetObjResult(interp, Tcl_NewIntObj(count));
+    } else {
+        Tcl_SetObjResult(interp, namesPtr);
+    }
+    return TCL_OK;
+}
 
+/*
+ *  Kinds of storage reported by the "memory" ensemble, in the order
+ *  of the sizes filled in by GetObjectMemory().
+ */
+static const char *memoryKinds[] = {
+    "object", "tables", "vars", "varns", "oo", "contexts", NULL
+};
+#define ITCL_MEMORY_KINDS 6
+
+/*
+ * ------------------------------------------------------------------------
+ *  GetObjectMemory()
+ *
+ *  Fills "sizes" with the bytes used by the object structure and its
+ *  resolver, the option, component and delegation tables, the compact
+ *  variable storage, the variable namespaces, the TclOO object with its
+ *  namespace, and the call contexts of an object.  Values of variables
+ *  are not counted, they are usually shared.
+ * ------------------------------------------------------------------------
+ */
+static void
+GetObjectMemory(
+    Tcl_Interp *interp,      /* current interpreter */
+    ItclObject *ioPtr,       /* object to examine */
+    Tcl_WideInt sizes[])     /* returns: ITCL_MEMORY_KINDS sizes */
+{
+    ItclObjectTables *tablesPtr;
+    Tcl_Namespace *varNsPtr;
+    Tcl_DString buffer;
+    int prefixLen;
+    int i;
+
+    sizes[0] = sizeof(ItclObject);
+    if (ioPtr->resolvePtr != NULL) {
+        sizes[0] += sizeof(Tcl_Resolve) + sizeof(ItclResolveInfo);
+    }
+
+    sizes[1] = 0;
+    tablesPtr = ioPtr->tablesPtr;
+    if (tablesPtr != NULL) {
+        sizes[1] = sizeof(ItclObjectTables)
+	        + Itcl_HashTableSize(&tablesPtr->objectOptions)
+	        + Itcl_HashTableSize(&tablesPtr->objectComponents)
+	        + Itcl_HashTableSize(&tablesPtr->objectMethodVariables)
+	        + Itcl_HashTableSize(&tablesPtr->objectDelegatedOptions)
+	        + Itcl_HashTableSize(&tablesPtr->objectDelegatedFunctions);
+    }
+
+    sizes[2] = ioPtr->numObjectVars * sizeof(Tcl_Var);
+    if (ioPtr->varTablePtr != NULL) {
+        sizes[2] += Itcl_VarTableSize(ioPtr->varTablePtr);
+    }
+
+    /*
+     *  The instance variables live in one child namespace of the
+     *  variable namespace per class in the hierarchy, named like the
+     *  class.
+     */
+    sizes[3] = 0;
+    if (ioPtr->varNsNamePtr != NULL) {
+        varNsPtr = Tcl_FindNamespace(interp,
+	        Tcl_GetString(ioPtr->varNsNamePtr), NULL, 0);
+        if (varNsPtr != NULL) {
+	    sizes[3] = Itcl_NamespaceSize(varNsPtr);
+	    Tcl_DStringInit(&buffer);
+	    Tcl_DStringAppend(&buffer, varNsPtr->fullName, -1);
+	    prefixLen = Tcl_DStringLength(&buffer);
+	    for (i = 0; i < ioPtr->iclsPtr->numHierarchy; i++) {
+	        Tcl_DStringSetLength(&buffer, prefixLen);
+		Tcl_DStringAppend(&buffer,
+		        ioPtr->iclsPtr->hierarchy[i]->nsPtr->fullName, -1);
+		varNsPtr = Tcl_FindNamespace(interp,
+		        Tcl_DStringValue(&buffer), NULL, 0);
+		if (varNsPtr != NULL) {
+		    sizes[3] += Itcl_NamespaceSize(varNsPtr);
+		}
+	    }
+	    Tcl_DStringFree(&buffer);
+	}
+    }
+
+    sizes[4] = 0;
+    if (ioPtr->oPtr != NULL) {
+        sizes[4] = Itcl_TclOOObjectSize(ioPtr->oPtr);
+    }
+
+    sizes[5] = ioPtr->numCallContexts * sizeof(ItclCallContext *);
+    for (i = 0; i < ioPtr->numCallContexts; i++) {
+        if (ioPtr->callContexts[i] != NULL) {
+	    sizes[5] += sizeof(ItclCallContext);
+	}
+    }
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  Itcl_MemoryClassCmd()
+ *
+ *  Part of the "memory" ensemble.  Handles the following syntax:
+ *
+ *    memory class className
+ *
+ *  Returns a dict with the number of live "instances" of the class, the
+ *  "peak" of that number, the bytes used by all of them for each kind
+ *  of storage listed by "memory object", the "total" of these and the
+ *  bytes used "perinstance" on average.  Only objects whose most-specific class
+ *  is "className" are counted.
+ * ------------------------------------------------------------------------
+ */
+int
+Itcl_MemoryClassCmd(
+    ClientData clientData,   /* object management info */
+    Tcl_Interp *interp,      /* current interpreter */
+    int objc,                /* number of arguments */
+    Tcl_Obj *const objv[])   /* argument objects */
+{
+    ItclClass *iclsPtr;
+    ItclObject *ioPtr;
+    Tcl_Obj *resultPtr;
+    Tcl_WideInt sizes[ITCL_MEMORY_KINDS];
+    Tcl_WideInt totals[ITCL_MEMORY_KINDS];
+    Tcl_WideInt total;
+    int i;
+
+    ItclShowArgs(1, "Itcl_MemoryClassCmd", objc, objv);
+    if (objc != 2) {
+        Tcl_WrongNumArgs(interp, 1, objv, "className");
+        return TCL_ERROR;
+    }
+    iclsPtr = Itcl_FindClass(interp, Tcl_GetString(objv[1]),
+            /* autoload */ 1);
+    if (iclsPtr == NULL) {
+        return TCL_ERROR;
+    }
+
+    memset(totals, 0, sizeof(totals));
+    for (ioPtr = iclsPtr->firstInstancePtr; ioPtr != NULL;
+            ioPtr = ioPtr->nextInstancePtr) {
+        GetObjectMemory(interp, ioPtr, sizes);
+	for (i = 0; i < ITCL_MEMORY_KINDS; i++) {
+	    totals[i] += sizes[i];
+	}
+    }
+
+    resultPtr = Tcl_NewDictObj();
+    Tcl_DictObjPut(NULL, resultPtr, Tcl_NewStringObj("instances", -1),
+            Tcl_NewIntObj(iclsPtr->numInstances));
+    Tcl_DictObjPut(NULL, resultPtr, Tcl_NewStringObj("peak", -1),
+            Tcl_NewIntObj(iclsPtr->maxInstances));
+    total = 0;
+    for (i = 0; i < ITCL_MEMORY_KINDS; i++) {
+        Tcl_DictObjPut(NULL, resultPtr, Tcl_NewStringObj(memoryKinds[i], -1),
+	        Tcl_NewWideIntObj(totals[i]));
+	total += totals[i];
+    }
+    Tcl_DictObjPut(NULL, resultPtr, Tcl_NewStringObj("total", -1),
+            Tcl_NewWideIntObj(total));
+    Tcl_DictObjPut(NULL, resultPtr, Tcl_NewStringObj("perinstance", -1),
+            Tcl_NewWideIntObj((iclsPtr->numInstances > 0)
+	    ? total / iclsPtr->numInstances : 0));
+    Tcl_SetObjResult(interp, resultPtr);
+    return TCL_OK;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  Itcl_MemoryObjectCmd()
+ *
+ *  Part of the "memory" ensemble.  Handles the following syntax:
+ *
+ *    memory object objName
+ *
+ *  Returns a dict with the bytes used by the object for each kind of
+ *  storage, see GetObjectMemory(), and their "total".
+ * ------------------------------------------------------------------------
+ */
+int
+Itcl_MemoryObjectCmd(
+    ClientData clientData,   /* object management info */
+    Tcl_Interp *interp,      /* current interpreter */
+    int objc,                /* number of arguments */
+    Tcl_Obj *const objv[])   /* argument objects */
+{
+    ItclObject *contextIoPtr;
+    Tcl_Obj *resultPtr;
+    Tcl_WideInt sizes[ITCL_MEMORY_KINDS];
+    Tcl_WideInt total;
+    const char *name;
+    int i;
+
+    ItclShowArgs(1, "Itcl_MemoryObjectCmd", objc, objv);
+    if (objc != 2) {
+        Tcl_WrongNumArgs(interp, 1, objv, "objName");
+        return TCL_ERROR;
+    }
+    name = Tcl_GetString(objv[1]);
+    contextIoPtr = NULL;
+    if (Itcl_FindObject(interp, name, &contextIoPtr) != TCL_OK) {
+        return TCL_ERROR;
+    }
+    if (contextIoPtr == NULL) {
+        Tcl_AppendResult(interp, "object \"", name, "\" not found", NULL);
+        return TCL_ERROR;
+    }
+
+    GetObjectMemory(interp, contextIoPtr, sizes);
+    resultPtr = Tcl_NewDictObj();
+    total = 0;
+    for (i = 0; i < ITCL_MEMORY_KINDS; i++) {
+        Tcl_DictObjPut(NULL, resultPtr, Tcl_NewStringObj(memoryKinds[i], -1),
+	        Tcl_NewWideIntObj(sizes[i]));
+	total += sizes[i];
+    }
+    Tcl_DictObjPut(NULL, resultPtr, Tcl_NewStringObj("total", -1),
+            Tcl_NewWideIntObj(total));
+    Tcl_SetObjResult(interp, resultPtr);
+    return TCL_OK;
+}
+
 /*
  * ------------------------------------------------------------------------
  *  Itcl_FilterCmd()
@@ -1557,7 +2157,8 @@ Itcl_AddObjectOptionCmd(
     Tcl_AppendToObj(ioptPtr->fullNamePtr, "::", 2);
     Tcl_AppendToObj(ioptPtr->fullNamePtr, Tcl_GetString(ioptPtr->namePtr), -1);
     Tcl_IncrRefCount(ioptPtr->fullNamePtr);
-    hPtr = Tcl_CreateHashEntry(&ioPtr->objectOptions,
+    hPtr = Tcl_CreateHashEntry(
+            ITCL_OBJECT_TABLE_FOR_WRITE(ioPtr, objectOptions),
             (char *)ioptPtr->namePtr, &isNew);
     Tcl_SetHashValue(hPtr, ioptPtr);
     ItclSetInstanceVar(interp, "itcl_options",
@@ -1620,7 +2221,8 @@ Itcl_AddDelegatedOptionCmd(
     if (result != TCL_OK) {
         return result;
     }
-    hPtr = Tcl_CreateHashEntry(&ioPtr->objectDelegatedOptions,
+    hPtr = Tcl_CreateHashEntry(
+            ITCL_OBJECT_TABLE_FOR_WRITE(ioPtr, objectDelegatedOptions),
             (char *)idoPtr->namePtr, &isNew);
     Tcl_SetHashValue(hPtr, idoPtr);
     return result;
@@ -1652,8 +2254,7 @@ Itcl_AddDelegatedFunctionCmd(
     ItclObject *ioPtr;
     ItclClass *iclsPtr;
     ItclDelegatedFunction *idmPtr;
-    ItclHierIter hier;
-    const char *val;
+    int hierIdx;
     int isNew;
     int result;
 
@@ -1685,21 +2286,25 @@ Itcl_AddDelegatedFunctionCmd(
         return result;
     }
     componentNamePtr = idmPtr->icPtr->namePtr;
-    Itcl_InitHierIter(&hier, ioPtr->iclsPtr);
-    while ((iclsPtr = Itcl_AdvanceHierIter(&hier)) != NULL) {
-        hPtr = Tcl_FindHashEntry(&iclsPtr->components, (char *)
-                componentNamePtr);
+    iclsPtr = NULL;
+    for (hierIdx = 0; hierIdx < ioPtr->iclsPtr->numHierarchy; hierIdx++) {
+        hPtr = Tcl_FindHashEntry(
+                &ioPtr->iclsPtr->hierarchy[hierIdx]->components,
+                (char *)componentNamePtr);
 	if (hPtr != NULL) {
+	    iclsPtr = ioPtr->iclsPtr->hierarchy[hierIdx];
 	    break;
 	}
     }
-    Itcl_DeleteHierIter(&hier);
-    val = Itcl_GetInstanceVar(interp,
+    componentNamePtr = Itcl_GetInstanceVarObj(interp,
             Tcl_GetString(componentNamePtr), ioPtr, iclsPtr);
-    componentNamePtr = Tcl_NewStringObj(val, -1);
+    if (componentNamePtr == NULL) {
+        componentNamePtr = Tcl_NewObj();
+    }
     Tcl_IncrRefCount(componentNamePtr);
     DelegateFunction(interp, ioPtr, ioPtr->iclsPtr, componentNamePtr, idmPtr);
-    hPtr = Tcl_CreateHashEntry(&ioPtr->objectDelegatedFunctions,
+    hPtr = Tcl_CreateHashEntry(
+            ITCL_OBJECT_TABLE_FOR_WRITE(ioPtr, objectDelegatedFunctions),
             (char *)idmPtr->namePtr, &isNew);
     Tcl_DecrRefCount(componentNamePtr);
     Tcl_SetHashValue(hPtr, idmPtr);
@@ -1757,8 +2362,9 @@ Itcl_AddComponentCmd(
         return TCL_ERROR;
     }
     contextIclsPtr = contextIoPtr->iclsPtr;
-    hPtr = Tcl_CreateHashEntry(&contextIoPtr->objectComponents, (char *)objv[2],
-            &isNew);
+    hPtr = Tcl_CreateHashEntry(
+            ITCL_OBJECT_TABLE_FOR_WRITE(contextIoPtr, objectComponents),
+            (char *)objv[2], &isNew);
     if (!isNew) {
 	Tcl_AppendResult(interp, "Itcl_AddComponentCmd component \"",
 	        Tcl_GetString(objv[2]), "\" already exists for object \"",
@@ -1865,13 +2471,7 @@ Itcl_AddComponentCmd(
     Itcl_PopCallFrame(interp);
     varPtr = Tcl_NewNamespaceVar(interp, varNsPtr,
             Tcl_GetString(ivPtr->namePtr));
-    hPtr = Tcl_CreateHashEntry(&contextIoPtr->objectVariables,
-            (char *)ivPtr, &isNew);
-    if (isNew) {
-	Itcl_PreserveVar(varPtr);
-        Tcl_SetHashValue(hPtr, varPtr);
-    } else {
-    }
+    ItclSetObjectVar(contextIoPtr, ivPtr, varPtr);
     return result;
 }
 
@@ -1898,9 +2498,9 @@ Itcl_SetComponentCmd(
     ItclClass *contextIclsPtr;
     ItclComponent *icPtr;
     ItclDelegatedOption *idoPtr;
-    ItclHierIter hier;
     const char *name;
     const char *val;
+    int hierIdx;
     int result;
 
     result = TCL_OK;
@@ -1920,15 +2520,15 @@ Itcl_SetComponentCmd(
 	       "for \"", Tcl_GetString(objv[1]), "\" == NULL", NULL);
         return TCL_ERROR;
     }
-    Itcl_InitHierIter(&hier, contextIoPtr->iclsPtr);
     hPtr = NULL;
-    while ((contextIclsPtr = Itcl_AdvanceHierIter(&hier)) != NULL) {
+    for (hierIdx = 0; hierIdx < contextIoPtr->iclsPtr->numHierarchy;
+            hierIdx++) {
+        contextIclsPtr = contextIoPtr->iclsPtr->hierarchy[hierIdx];
         hPtr = Tcl_FindHashEntry(&contextIclsPtr->components, (char *)objv[2]);
         if (hPtr != NULL) {
 	    break;
 	}
     }
-    Itcl_DeleteHierIter(&hier);
     if (hPtr == NULL) {
 	Tcl_AppendResult(interp, "object \"", Tcl_GetString(objv[1]),
 	        "\" has no component \"", Tcl_GetString(objv[2]), "\"", NULL);
@@ -1939,8 +2539,9 @@ Itcl_SetComponentCmd(
             contextIoPtr, contextIclsPtr);
     if ((val != NULL) && (strlen(val) != 0)) {
         /* delete delegated options to the old component here !! */
-        Itcl_InitHierIter(&hier, contextIoPtr->iclsPtr);
-        while ((iclsPtr = Itcl_AdvanceHierIter(&hier)) != NULL) {
+        for (hierIdx = 0; hierIdx < contextIoPtr->iclsPtr->numHierarchy;
+                hierIdx++) {
+            iclsPtr = contextIoPtr->iclsPtr->hierarchy[hierIdx];
             FOREACH_HASH_VALUE(idoPtr, &iclsPtr->delegatedOptions) {
 	        if (strcmp(Tcl_GetString(idoPtr->icPtr->namePtr),
 		        Tcl_GetString(objv[2])) == 0) {
@@ -1948,7 +2549,6 @@ Itcl_SetComponentCmd(
 	        }
 	    }
         }
-        Itcl_DeleteHierIter(&hier);
     }
     if (ItclSetInstanceVar(interp, Tcl_GetString(icPtr->namePtr), NULL,
              Tcl_GetString(objv[3]), contextIoPtr, contextIclsPtr) == NULL) {
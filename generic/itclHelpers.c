@@ -79,7 +79,8 @@ ItclCreateArgList(
     const char *str,		/* string representing argument list */
     int *argcPtr,		/* number of mandatory arguments */
     int *maxArgcPtr,		/* number of arguments parsed */
-    Tcl_Obj **usagePtr,         /* store usage message for arguments here */
+    Tcl_Obj **usagePtr,         /* store usage message for arguments here,
+                                 * or NULL to skip it */
     ItclArgList **arglistPtrPtr,
     				/* returns pointer to parsed argument list */
     ItclMemberFunc *mPtr,
@@ -102,7 +103,9 @@ ItclCreateArgList(
     result = TCL_OK;
     *maxArgcPtr = 0;
     *argcPtr = 0;
-    *usagePtr = Tcl_NewStringObj("", -1);
+    if (usagePtr != NULL) {
+        *usagePtr = Tcl_NewStringObj("", -1);
+    }
     if (str) {
         if (Tcl_SplitList(interp, (const char *)str, &argc, &argv)
 	        != TCL_OK) {
@@ -157,7 +160,9 @@ ItclCreateArgList(
 	         *arglistPtrPtr = arglistPtr;
 	    } else {
 	        lastArglistPtr->nextPtr = arglistPtr;
-	        Tcl_AppendToObj(*usagePtr, " ", 1);
+		if (usagePtr != NULL) {
+	            Tcl_AppendToObj(*usagePtr, " ", 1);
+		}
 	    }
 	    arglistPtr->namePtr = 
 	            Tcl_NewStringObj(defaultArgv[0], -1);
@@ -169,17 +174,21 @@ ItclCreateArgList(
 		if ((strcmp(defaultArgv[0], "args") == 0) && (i == argc-1)) {
 		    hadArgsArgument = 1;
 		    (*argcPtr)--;
-	            Tcl_AppendToObj(*usagePtr, "?arg arg ...?", -1);
-		} else {
+		    if (usagePtr != NULL) {
+	                Tcl_AppendToObj(*usagePtr, "?arg arg ...?", -1);
+		    }
+		} else if (usagePtr != NULL) {
 	            Tcl_AppendToObj(*usagePtr, defaultArgv[0], -1);
 	        }
 	    } else {
 	        arglistPtr->defaultValuePtr = 
 		        Tcl_NewStringObj(defaultArgv[1], -1);
 		Tcl_IncrRefCount(arglistPtr->defaultValuePtr);
-	        Tcl_AppendToObj(*usagePtr, "?", 1);
-	        Tcl_AppendToObj(*usagePtr, defaultArgv[0], -1);
-	        Tcl_AppendToObj(*usagePtr, "?", 1);
+		if (usagePtr != NULL) {
+	            Tcl_AppendToObj(*usagePtr, "?", 1);
+	            Tcl_AppendToObj(*usagePtr, defaultArgv[0], -1);
+	            Tcl_AppendToObj(*usagePtr, "?", 1);
+		}
 	    }
             lastArglistPtr = arglistPtr;
 	    i++;
@@ -226,6 +235,76 @@ ItclDeleteArgList(
     }
 }
 
+/*
+ * ------------------------------------------------------------------------
+ *  ArgListUsage()
+ *
+ *  Builds the usage string for a parsed argument list, the same string
+ *  ItclCreateArgList() returns when asked for it.
+ * ------------------------------------------------------------------------
+ */
+static Tcl_Obj *
+ArgListUsage(
+    ItclArgList *arglistPtr)	/* first argument in arg list chain */
+{
+    Tcl_Obj *usagePtr;
+    ItclArgList *currPtr;
+
+    usagePtr = Tcl_NewStringObj("", -1);
+    for (currPtr=arglistPtr; currPtr; currPtr=currPtr->nextPtr) {
+        if (currPtr->namePtr == NULL) {
+	    /* placeholder for an empty argument list */
+	    continue;
+	}
+	if (currPtr != arglistPtr) {
+	    Tcl_AppendToObj(usagePtr, " ", 1);
+	}
+	if (currPtr->defaultValuePtr != NULL) {
+	    Tcl_AppendToObj(usagePtr, "?", 1);
+	    Tcl_AppendObjToObj(usagePtr, currPtr->namePtr);
+	    Tcl_AppendToObj(usagePtr, "?", 1);
+	} else if ((currPtr->nextPtr == NULL)
+	        && (strcmp(Tcl_GetString(currPtr->namePtr), "args") == 0)) {
+	    Tcl_AppendToObj(usagePtr, "?arg arg ...?", -1);
+	} else {
+	    Tcl_AppendObjToObj(usagePtr, currPtr->namePtr);
+	}
+    }
+    Tcl_IncrRefCount(usagePtr);
+    return usagePtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclMemberCodeUsage()
+ *  ItclMemberFuncUsage()
+ *
+ *  Return the usage string of a member implementation or of a member
+ *  function, or NULL if no argument list was specified.  The string is
+ *  only needed for introspection and error messages, so it is built
+ *  on first use.
+ * ------------------------------------------------------------------------
+ */
+Tcl_Obj *
+ItclMemberCodeUsage(
+    ItclMemberCode *mcode)
+{
+    if ((mcode->usagePtr == NULL) && (mcode->argListPtr != NULL)) {
+        mcode->usagePtr = ArgListUsage(mcode->argListPtr);
+    }
+    return mcode->usagePtr;
+}
+
+Tcl_Obj *
+ItclMemberFuncUsage(
+    ItclMemberFunc *imPtr)
+{
+    if ((imPtr->usagePtr == NULL) && (imPtr->argListPtr != NULL)) {
+        imPtr->usagePtr = ArgListUsage(imPtr->argListPtr);
+    }
+    return imPtr->usagePtr;
+}
+
 
 /*
  * ------------------------------------------------------------------------
@@ -412,6 +491,9 @@ DeleteClassDictInfo(
         Tcl_AppendResult(interp, "cannot get dict ", varName, NULL);
 	return TCL_ERROR;
     }
+    if (Tcl_IsShared(dictPtr)) {
+        dictPtr = Tcl_DuplicateObj(dictPtr);
+    }
     keyPtr = iclsPtr->fullNamePtr;
     if (Tcl_DictObjRemove(interp, dictPtr, keyPtr) != TCL_OK) {
         return TCL_ERROR;
@@ -444,27 +526,149 @@ AddDictEntry(
     return TCL_OK;
 }
 
+/*
+ *  The class description dicts kept in ::itcl::internal::dicts, indexed
+ *  by the ITCL_DICT_INFO_* kind that fills them.
+ */
+const char *const ItclDictInfoVarNames[] = {
+    NULL,
+    ITCL_NAMESPACE"::internal::dicts::classes",
+    ITCL_NAMESPACE"::internal::dicts::classOptions",
+    ITCL_NAMESPACE"::internal::dicts::classDelegatedOptions",
+    ITCL_NAMESPACE"::internal::dicts::classComponents",
+    ITCL_NAMESPACE"::internal::dicts::classVariables",
+    ITCL_NAMESPACE"::internal::dicts::classFunctions",
+    ITCL_NAMESPACE"::internal::dicts::classDelegatedFunctions"
+};
+
 /*
  * ------------------------------------------------------------------------
- *  ItclAddClassesDictInfo()
+ *  QueueDictInfo()
+ *
+ *  Remembers that the entry for "memberPtr" in one of the
+ *  ::itcl::internal::dicts class variables has to be (re)built.  The
+ *  queue is flushed by ItclClassDictsTrace() when a script reads one of
+ *  those variables, so class definitions do not pay for them.
  * ------------------------------------------------------------------------
  */
-int
-ItclAddClassesDictInfo(
+static int
+QueueDictInfo(
+    ItclClass *iclsPtr,
+    int kind,
+    ClientData memberPtr)
+{
+    ItclObjectInfo *infoPtr = iclsPtr->infoPtr;
+    ItclDictInfo *diPtr;
+
+    if (infoPtr->numDictInfos == infoPtr->maxDictInfos) {
+        infoPtr->maxDictInfos = infoPtr->maxDictInfos ?
+	        2 * infoPtr->maxDictInfos : 64;
+        infoPtr->dictInfos = (ItclDictInfo *)ckrealloc(
+	        (char *)infoPtr->dictInfos,
+	        infoPtr->maxDictInfos * sizeof(ItclDictInfo));
+    }
+    if (iclsPtr->numDictInfos == 0) {
+        iclsPtr->firstDictInfo = infoPtr->numDictInfos;
+    }
+    diPtr = &infoPtr->dictInfos[infoPtr->numDictInfos++];
+    diPtr->kind = kind;
+    diPtr->iclsPtr = iclsPtr;
+    diPtr->memberPtr = memberPtr;
+    iclsPtr->numDictInfos++;
+    return TCL_OK;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  CompactDictInfos()
+ *
+ *  Removes the dropped entries from the queue once they make up half
+ *  of it, and renumbers the first entry of each class.
+ * ------------------------------------------------------------------------
+ */
+static void
+CompactDictInfos(
+    ItclObjectInfo *infoPtr)
+{
+    ItclDictInfo *diPtr;
+    int i;
+    int j;
+
+    if (2 * infoPtr->numDeadDictInfos < infoPtr->numDictInfos) {
+        return;
+    }
+    for (i = j = 0; i < infoPtr->numDictInfos; i++) {
+        diPtr = &infoPtr->dictInfos[i];
+	if (diPtr->iclsPtr != NULL) {
+	    infoPtr->dictInfos[j++] = *diPtr;
+	}
+    }
+    infoPtr->numDictInfos = j;
+    infoPtr->numDeadDictInfos = 0;
+    /* backwards, so the lowest index of each class is stored last */
+    while (j-- > 0) {
+        infoPtr->dictInfos[j].iclsPtr->firstDictInfo = j;
+    }
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclForgetDictInfo()
+ *
+ *  Drops the queued dict entries of a class that is going away, or of
+ *  a single member when "memberPtr" is not NULL.  The entries are only
+ *  marked as dropped, starting at the first entry of the class, so this
+ *  does not move the rest of the queue.
+ * ------------------------------------------------------------------------
+ */
+void
+ItclForgetDictInfo(
+    ItclClass *iclsPtr,
+    ClientData memberPtr)
+{
+    ItclObjectInfo *infoPtr = iclsPtr->infoPtr;
+    ItclDictInfo *diPtr;
+    int remaining;
+    int i;
+
+    remaining = iclsPtr->numDictInfos;
+    for (i = iclsPtr->firstDictInfo;
+            (remaining > 0) && (i < infoPtr->numDictInfos); i++) {
+        diPtr = &infoPtr->dictInfos[i];
+        if (diPtr->iclsPtr != iclsPtr) {
+	    continue;
+	}
+	remaining--;
+	if ((memberPtr == NULL) || (diPtr->memberPtr == memberPtr)) {
+	    diPtr->iclsPtr = NULL;
+	    iclsPtr->numDictInfos--;
+	    infoPtr->numDeadDictInfos++;
+	}
+    }
+    CompactDictInfos(infoPtr);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  AddClassesDictInfo()
+ * ------------------------------------------------------------------------
+ */
+static int
+AddClassesDictInfo(
     Tcl_Interp *interp,
+    Tcl_Obj *dictPtr,
     ItclClass *iclsPtr)
 {
-    Tcl_Obj *dictPtr;
     Tcl_Obj *keyPtr;
     Tcl_Obj *keyPtr1;
     Tcl_Obj *valuePtr1;
     Tcl_Obj *valuePtr2;
     Tcl_Obj *listPtr;
     FOREACH_HASH_DECLS;
-    ItclHierIter hier;
     ItclClass *iclsPtr2;
     void *value;
     int found;
+    int hierIdx;
     int newValue1;
     int haveHierarchy;
 
@@ -481,13 +685,6 @@ ItclAddClassesDictInfo(
 	        "\"", NULL);
         return TCL_ERROR;
     }
-    dictPtr = Tcl_GetVar2Ex(interp,
-             ITCL_NAMESPACE"::internal::dicts::classes", NULL, 0);
-    if (dictPtr == NULL) {
-        Tcl_AppendResult(interp, "cannot get dict ", ITCL_NAMESPACE,
-	        "::internal::dicts::classes", NULL);
-	return TCL_ERROR;
-    }
     if (Tcl_DictObjGet(interp, dictPtr, keyPtr1, &valuePtr1) != TCL_OK) {
         return TCL_ERROR;
     }
@@ -495,6 +692,9 @@ ItclAddClassesDictInfo(
     if (valuePtr1 == NULL) {
         newValue1 = 1;
         valuePtr1 = Tcl_NewDictObj();
+    } else if (Tcl_IsShared(valuePtr1)) {
+        newValue1 = 1;
+        valuePtr1 = Tcl_DuplicateObj(valuePtr1);
     }
     keyPtr = iclsPtr->fullNamePtr;
     if (Tcl_DictObjGet(interp, valuePtr1, keyPtr, &valuePtr2) != TCL_OK) {
@@ -513,19 +713,16 @@ ItclAddClassesDictInfo(
             != TCL_OK) {
         return TCL_ERROR;
     }
-    Itcl_InitHierIter(&hier, iclsPtr);
-    iclsPtr2 = Itcl_AdvanceHierIter(&hier);
     haveHierarchy = 0;
     listPtr = Tcl_NewListObj(0, NULL);
-    while (iclsPtr2 != NULL) {
+    for (hierIdx = 0; hierIdx < iclsPtr->numHierarchy; hierIdx++) {
+        iclsPtr2 = iclsPtr->hierarchy[hierIdx];
         haveHierarchy = 1;
 	if (Tcl_ListObjAppendElement(interp, listPtr, iclsPtr2->fullNamePtr)
 	        != TCL_OK) {
 	    return TCL_ERROR;
 	}
-        iclsPtr2 = Itcl_AdvanceHierIter(&hier);
     }
-    Itcl_DeleteHierIter(&hier);
     if (haveHierarchy) {
         if (AddDictEntry(interp, valuePtr2, "-heritage", listPtr) != TCL_OK) {
             return TCL_ERROR;
@@ -560,8 +757,6 @@ ItclAddClassesDictInfo(
             return TCL_ERROR;
         }
     }
-    Tcl_SetVar2Ex(interp, ITCL_NAMESPACE"::internal::dicts::classes",
-            NULL, dictPtr, 0);
     return TCL_OK;
 }
 
@@ -582,6 +777,7 @@ ItclDeleteClassesDictInfo(
     void* value;
     int found;
 
+    ItclForgetDictInfo(iclsPtr, NULL);
     found = 0;
     FOREACH_HASH(keyPtr, value, &iclsPtr->infoPtr->classTypes) {
         if (iclsPtr->flags & PTR2INT(value)) {
@@ -595,6 +791,10 @@ ItclDeleteClassesDictInfo(
 	        "\"", NULL);
         return TCL_ERROR;
     }
+    if (!iclsPtr->infoPtr->dictInfosFlushed) {
+        /* nothing has been written to the dict variables yet */
+        return TCL_OK;
+    }
     dictPtr = Tcl_GetVar2Ex(interp,
              ITCL_NAMESPACE"::internal::dicts::classes", NULL, 0);
     if (dictPtr == NULL) {
@@ -602,6 +802,9 @@ ItclDeleteClassesDictInfo(
 	        "::internal::dicts::classes", NULL);
 	return TCL_ERROR;
     }
+    if (Tcl_IsShared(dictPtr)) {
+        dictPtr = Tcl_DuplicateObj(dictPtr);
+    }
     if (Tcl_DictObjGet(interp, dictPtr, keyPtr, &valuePtr) != TCL_OK) {
         return TCL_ERROR;
     }
@@ -610,6 +813,9 @@ ItclDeleteClassesDictInfo(
 	 * and no class has been created so ignore silently */
         return TCL_OK;
     }
+    if (Tcl_IsShared(valuePtr)) {
+        valuePtr = Tcl_DuplicateObj(valuePtr);
+    }
     if (Tcl_DictObjRemove(interp, valuePtr, iclsPtr->fullNamePtr) != TCL_OK) {
         return TCL_ERROR;
     }
@@ -636,6 +842,10 @@ ItclDeleteClassesDictInfo(
 /*
  * ------------------------------------------------------------------------
  *  ItclAddObjectsDictInfo()
+ *
+ *  Marks a fully constructed object as a member of
+ *  ::itcl::internal::dicts::objects.  The dict itself is only built
+ *  when the variable is read, see ItclObjectsDictTrace().
  * ------------------------------------------------------------------------
  */
 int
@@ -643,83 +853,11 @@ ItclAddObjectsDictInfo(
     Tcl_Interp *interp,
     ItclObject *ioPtr)
 {
-    Tcl_Obj *dictPtr;
-    Tcl_Obj *keyPtr;
-    Tcl_Obj *keyPtr1;
-    Tcl_Obj *valuePtr1;
-    Tcl_Obj *valuePtr2;
-    Tcl_Obj *objPtr;
-    int newValue1;
-
-    dictPtr = Tcl_GetVar2Ex(interp,
-             ITCL_NAMESPACE"::internal::dicts::objects", NULL, 0);
-    if (dictPtr == NULL) {
-        Tcl_AppendResult(interp, "cannot get dict ", ITCL_NAMESPACE,
-	        "::internal::dicts::objects", NULL);
-	return TCL_ERROR;
-    }
-    keyPtr1 = Tcl_NewStringObj("instances", -1);
-    if (Tcl_DictObjGet(interp, dictPtr, keyPtr1, &valuePtr1) != TCL_OK) {
-        return TCL_ERROR;
-    }
-    newValue1 = 0;
-    if (valuePtr1 == NULL) {
-        newValue1 = 1;
-        valuePtr1 = Tcl_NewDictObj();
-    }
-    keyPtr = ioPtr->namePtr;
-    if (Tcl_DictObjGet(interp, valuePtr1, keyPtr, &valuePtr2) != TCL_OK) {
-        return TCL_ERROR;
-    }
-    if (valuePtr2 == NULL) {
-        if (Tcl_DictObjRemove(interp, valuePtr1, keyPtr) != TCL_OK) {
-            return TCL_ERROR;
-        }
-    }
-    valuePtr2 = Tcl_NewDictObj();
-    if (AddDictEntry(interp, valuePtr2, "-name", ioPtr->namePtr) != TCL_OK) {
-        return TCL_ERROR;
-    }
-    if (AddDictEntry(interp, valuePtr2, "-origname", ioPtr->namePtr)
-            != TCL_OK) {
-        return TCL_ERROR;
-    }
-    if (AddDictEntry(interp, valuePtr2, "-class", ioPtr->iclsPtr->fullNamePtr)
-            != TCL_OK) {
-        return TCL_ERROR;
-    }
-    if (ioPtr->hullWindowNamePtr != NULL) {
-        if (AddDictEntry(interp, valuePtr2, "-hullwindow",
-	        ioPtr->hullWindowNamePtr) != TCL_OK) {
-            return TCL_ERROR;
-        }
-    }
-    if (AddDictEntry(interp, valuePtr2, "-varns", ioPtr->varNsNamePtr)
-            != TCL_OK) {
-        return TCL_ERROR;
-    }
-    objPtr = Tcl_NewObj();
-    Tcl_GetCommandFullName(interp, ioPtr->accessCmd, objPtr);
-    if (AddDictEntry(interp, valuePtr2, "-command", objPtr) != TCL_OK) {
-	Tcl_DecrRefCount(objPtr);
-        return TCL_ERROR;
-    }
-    keyPtr = ioPtr->namePtr;
-    if (Tcl_DictObjPut(interp, valuePtr1, keyPtr, valuePtr2) != TCL_OK) {
-        return TCL_ERROR;
-    }
-    if (newValue1) {
-	/* Cannot fail. Screened non-dicts earlier. */
-        Tcl_DictObjPut(interp, dictPtr, keyPtr1, valuePtr1);
-    } else {
-	/* Don't leak the key val... */
-	Tcl_DecrRefCount(keyPtr1);
-    }
-    Tcl_SetVar2Ex(interp, ITCL_NAMESPACE"::internal::dicts::objects",
-            NULL, dictPtr, 0);
+    ioPtr->flags |= ITCL_OBJECT_IN_OBJECTS_DICT;
+    ioPtr->infoPtr->objectsDictStale = 1;
     return TCL_OK;
 }
-
+
 /*
  * ------------------------------------------------------------------------
  *  ItclDeleteObjectsDictInfo()
@@ -730,80 +868,94 @@ ItclDeleteObjectsDictInfo(
     Tcl_Interp *interp,
     ItclObject *ioPtr)
 {
+    if (ioPtr->flags & ITCL_OBJECT_IN_OBJECTS_DICT) {
+        ioPtr->flags &= ~ITCL_OBJECT_IN_OBJECTS_DICT;
+        ioPtr->infoPtr->objectsDictStale = 1;
+    }
+    return TCL_OK;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclObjectsDictTrace()
+ *
+ *  Read and write trace on ::itcl::internal::dicts::objects.  If
+ *  objects were added or removed since the last read, the dict is
+ *  rebuilt from the object registry before the value is returned.
+ *  The variable is read-only: writes from scripts are rejected and
+ *  the next read rebuilds the dict.
+ * ------------------------------------------------------------------------
+ */
+char *
+ItclObjectsDictTrace(
+    ClientData clientData,   /* the ItclObjectInfo */
+    Tcl_Interp *interp,      /* current interpreter */
+    const char *name1,       /* variable name */
+    const char *name2,       /* unused */
+    int flags)               /* flags indicating read/write */
+{
+    FOREACH_HASH_DECLS;
+    ItclObjectInfo *infoPtr;
+    ItclObject *ioPtr;
     Tcl_Obj *dictPtr;
-    Tcl_Obj *keyPtr;
-    Tcl_Obj *keyPtr1;
+    Tcl_Obj *instancesPtr;
     Tcl_Obj *valuePtr;
-    Tcl_Obj *valuePtr1;
+    Tcl_Obj *objPtr;
 
-    dictPtr = Tcl_GetVar2Ex(interp,
-             ITCL_NAMESPACE"::internal::dicts::objects", NULL, 0);
-    if (dictPtr == NULL) {
-        Tcl_AppendResult(interp, "cannot get dict ", ITCL_NAMESPACE,
-	        "::internal::dicts::objects", NULL);
-	return TCL_ERROR;
-    }
-    keyPtr1 = Tcl_NewStringObj("instances", -1);
-    if (Tcl_DictObjGet(interp, dictPtr, keyPtr1, &valuePtr) != TCL_OK) {
-	Tcl_DecrRefCount(keyPtr1);
-        return TCL_ERROR;
-    }
-    if (valuePtr == NULL) {
-	/* looks like no object has been registered yet
-	 * so ignore and return OK */
-	Tcl_DecrRefCount(keyPtr1);
-        return TCL_OK;
-    }
-    keyPtr = ioPtr->namePtr;
-    if (Tcl_DictObjGet(interp, valuePtr, keyPtr, &valuePtr1) != TCL_OK) {
-	Tcl_DecrRefCount(keyPtr1);
-        return TCL_ERROR;
-    }
-    if (valuePtr1 == NULL) {
-	/* looks like the object has not been constructed successfully
-	 * so ignore and return OK */
-	Tcl_DecrRefCount(keyPtr1);
-        return TCL_OK;
-    }
-    if (Tcl_DictObjRemove(interp, valuePtr, keyPtr) != TCL_OK) {
-	Tcl_DecrRefCount(keyPtr1);
-        return TCL_ERROR;
-    }
-    if (Tcl_DictObjPut(interp, dictPtr, keyPtr1, valuePtr) != TCL_OK) {
-	/* This is very likely impossible. non-dict already screened. */
-	Tcl_DecrRefCount(keyPtr1);
-        return TCL_ERROR;
+    infoPtr = (ItclObjectInfo *)clientData;
+    if (flags & TCL_INTERP_DESTROYED) {
+        return NULL;
+    }
+    if (flags & TCL_TRACE_WRITES) {
+        infoPtr->objectsDictStale = 1;
+        return "variable \"objects\" cannot be modified";
+    }
+    if (!infoPtr->objectsDictStale) {
+        return NULL;
+    }
+    infoPtr->objectsDictStale = 0;
+    instancesPtr = Tcl_NewDictObj();
+    FOREACH_HASH_VALUE(ioPtr, &infoPtr->objects) {
+        if (!(ioPtr->flags & ITCL_OBJECT_IN_OBJECTS_DICT)) {
+            continue;
+        }
+        valuePtr = Tcl_NewDictObj();
+        AddDictEntry(NULL, valuePtr, "-name", ioPtr->namePtr);
+        AddDictEntry(NULL, valuePtr, "-origname", ioPtr->namePtr);
+        AddDictEntry(NULL, valuePtr, "-class", ioPtr->iclsPtr->fullNamePtr);
+        AddDictEntry(NULL, valuePtr, "-hullwindow", ioPtr->hullWindowNamePtr);
+        AddDictEntry(NULL, valuePtr, "-varns", ioPtr->varNsNamePtr);
+        if (ioPtr->accessCmd != NULL) {
+            objPtr = Tcl_NewObj();
+            Tcl_GetCommandFullName(interp, ioPtr->accessCmd, objPtr);
+            AddDictEntry(NULL, valuePtr, "-command", objPtr);
+        }
+        Tcl_DictObjPut(NULL, instancesPtr, ioPtr->namePtr, valuePtr);
     }
-    Tcl_DecrRefCount(keyPtr1);
-    Tcl_SetVar2Ex(interp, ITCL_NAMESPACE"::internal::dicts::objects",
-            NULL, dictPtr, 0);
-    return TCL_OK;
+    dictPtr = Tcl_NewDictObj();
+    AddDictEntry(NULL, dictPtr, "instances", instancesPtr);
+    Tcl_SetVar2Ex(interp, ITCL_NAMESPACE"::internal::dicts::objects", NULL,
+            dictPtr, TCL_GLOBAL_ONLY);
+    return NULL;
 }
-
+
 /*
  * ------------------------------------------------------------------------
- *  ItclAddOptionDictInfo()
+ *  AddOptionDictInfo()
  * ------------------------------------------------------------------------
  */
-int
-ItclAddOptionDictInfo(
+static int
+AddOptionDictInfo(
     Tcl_Interp *interp,
+    Tcl_Obj *dictPtr,
     ItclClass *iclsPtr,
     ItclOption *ioptPtr)
 {
-    Tcl_Obj *dictPtr;
     Tcl_Obj *keyPtr;
     Tcl_Obj *valuePtr1;
     Tcl_Obj *valuePtr2;
     int newValue1;
 
-    dictPtr = Tcl_GetVar2Ex(interp,
-             ITCL_NAMESPACE"::internal::dicts::classOptions", NULL, 0);
-    if (dictPtr == NULL) {
-        Tcl_AppendResult(interp, "cannot get dict ", ITCL_NAMESPACE,
-	        "::internal::dicts::classOptions", NULL);
-	return TCL_ERROR;
-    }
     keyPtr = iclsPtr->fullNamePtr;
     if (Tcl_DictObjGet(interp, dictPtr, keyPtr, &valuePtr1) != TCL_OK) {
         return TCL_ERROR;
@@ -812,6 +964,9 @@ ItclAddOptionDictInfo(
     if (valuePtr1 == NULL) {
         valuePtr1 = Tcl_NewDictObj();
         newValue1 = 1;
+    } else if (Tcl_IsShared(valuePtr1)) {
+        valuePtr1 = Tcl_DuplicateObj(valuePtr1);
+        newValue1 = 1;
     }
     keyPtr = ioptPtr->namePtr;
     if (Tcl_DictObjGet(interp, valuePtr1, keyPtr, &valuePtr2) != TCL_OK) {
@@ -819,6 +974,8 @@ ItclAddOptionDictInfo(
     }
     if (valuePtr2 == NULL) {
         valuePtr2 = Tcl_NewDictObj();
+    } else if (Tcl_IsShared(valuePtr2)) {
+        valuePtr2 = Tcl_DuplicateObj(valuePtr2);
     }
     if (AddDictEntry(interp, valuePtr2, "-name", ioptPtr->namePtr) != TCL_OK) {
         return TCL_ERROR;
@@ -895,24 +1052,22 @@ ItclAddOptionDictInfo(
             return TCL_ERROR;
         }
     }
-    Tcl_SetVar2Ex(interp, ITCL_NAMESPACE"::internal::dicts::classOptions",
-            NULL, dictPtr, 0);
     return TCL_OK;
 }
 
 /*
  * ------------------------------------------------------------------------
- *  ItclAddDelegatedOptionDictInfo()
+ *  AddDelegatedOptionDictInfo()
  * ------------------------------------------------------------------------
  */
-int
-ItclAddDelegatedOptionDictInfo(
+static int
+AddDelegatedOptionDictInfo(
     Tcl_Interp *interp,
+    Tcl_Obj *dictPtr,
     ItclClass *iclsPtr,
     ItclDelegatedOption *idoPtr)
 {
     FOREACH_HASH_DECLS;
-    Tcl_Obj *dictPtr;
     Tcl_Obj *keyPtr;
     Tcl_Obj *valuePtr1;
     Tcl_Obj *valuePtr2;
@@ -922,14 +1077,6 @@ ItclAddDelegatedOptionDictInfo(
     int newValue1;
 
     keyPtr = iclsPtr->fullNamePtr;
-    dictPtr = Tcl_GetVar2Ex(interp,
-             ITCL_NAMESPACE"::internal::dicts::classDelegatedOptions",
-	     NULL, 0);
-    if (dictPtr == NULL) {
-        Tcl_AppendResult(interp, "cannot get dict ", ITCL_NAMESPACE,
-	        "::internal::dicts::classDelegatedOptions", NULL);
-	return TCL_ERROR;
-    }
     if (Tcl_DictObjGet(interp, dictPtr, keyPtr, &valuePtr1) != TCL_OK) {
         return TCL_ERROR;
     }
@@ -937,6 +1084,9 @@ ItclAddDelegatedOptionDictInfo(
     if (valuePtr1 == NULL) {
         valuePtr1 = Tcl_NewDictObj();
         newValue1 = 1;
+    } else if (Tcl_IsShared(valuePtr1)) {
+        valuePtr1 = Tcl_DuplicateObj(valuePtr1);
+        newValue1 = 1;
     }
     keyPtr = idoPtr->namePtr;
     if (Tcl_DictObjGet(interp, valuePtr1, keyPtr, &valuePtr2) != TCL_OK) {
@@ -944,6 +1094,8 @@ ItclAddDelegatedOptionDictInfo(
     }
     if (valuePtr2 == NULL) {
         valuePtr2 = Tcl_NewDictObj();
+    } else if (Tcl_IsShared(valuePtr2)) {
+        valuePtr2 = Tcl_DuplicateObj(valuePtr2);
     }
     if (AddDictEntry(interp, valuePtr2, "-name", idoPtr->namePtr) != TCL_OK) {
         return TCL_ERROR;
@@ -998,25 +1150,22 @@ ItclAddDelegatedOptionDictInfo(
             return TCL_ERROR;
         }
     }
-    Tcl_SetVar2Ex(interp,
-            ITCL_NAMESPACE"::internal::dicts::classDelegatedOptions",
-            NULL, dictPtr, 0);
     return TCL_OK;
 }
 
 /*
  * ------------------------------------------------------------------------
- *  ItclAddClassComponentDictInfo()
+ *  AddClassComponentDictInfo()
  * ------------------------------------------------------------------------
  */
-int
-ItclAddClassComponentDictInfo(
+static int
+AddClassComponentDictInfo(
     Tcl_Interp *interp,
+    Tcl_Obj *dictPtr,
     ItclClass *iclsPtr,
     ItclComponent *icPtr)
 {
     FOREACH_HASH_DECLS;
-    Tcl_Obj *dictPtr;
     Tcl_Obj *keyPtr;
     Tcl_Obj *valuePtr1;
     Tcl_Obj *valuePtr2;
@@ -1025,14 +1174,6 @@ ItclAddClassComponentDictInfo(
     int newValue1;
 
     keyPtr = iclsPtr->fullNamePtr;
-    dictPtr = Tcl_GetVar2Ex(interp,
-             ITCL_NAMESPACE"::internal::dicts::classComponents",
-	     NULL, 0);
-    if (dictPtr == NULL) {
-        Tcl_AppendResult(interp, "cannot get dict ", ITCL_NAMESPACE,
-	        "::internal::dicts::classComponents", NULL);
-	return TCL_ERROR;
-    }
     if (Tcl_DictObjGet(interp, dictPtr, keyPtr, &valuePtr1) != TCL_OK) {
         return TCL_ERROR;
     }
@@ -1040,6 +1181,9 @@ ItclAddClassComponentDictInfo(
     if (valuePtr1 == NULL) {
         valuePtr1 = Tcl_NewDictObj();
         newValue1 = 1;
+    } else if (Tcl_IsShared(valuePtr1)) {
+        valuePtr1 = Tcl_DuplicateObj(valuePtr1);
+        newValue1 = 1;
     }
     keyPtr = icPtr->namePtr;
     if (Tcl_DictObjGet(interp, valuePtr1, keyPtr, &valuePtr2) != TCL_OK) {
@@ -1047,6 +1191,8 @@ ItclAddClassComponentDictInfo(
     }
     if (valuePtr2 == NULL) {
         valuePtr2 = Tcl_NewDictObj();
+    } else if (Tcl_IsShared(valuePtr2)) {
+        valuePtr2 = Tcl_DuplicateObj(valuePtr2);
     }
     if (AddDictEntry(interp, valuePtr2, "-name", icPtr->namePtr) != TCL_OK) {
         return TCL_ERROR;
@@ -1090,24 +1236,21 @@ ItclAddClassComponentDictInfo(
             return TCL_ERROR;
         }
     }
-    Tcl_SetVar2Ex(interp,
-            ITCL_NAMESPACE"::internal::dicts::classComponents",
-            NULL, dictPtr, 0);
     return TCL_OK;
 }
 
 /*
  * ------------------------------------------------------------------------
- *  ItclAddClassVariableDictInfo()
+ *  AddClassVariableDictInfo()
  * ------------------------------------------------------------------------
  */
-int
-ItclAddClassVariableDictInfo(
+static int
+AddClassVariableDictInfo(
     Tcl_Interp *interp,
+    Tcl_Obj *dictPtr,
     ItclClass *iclsPtr,
     ItclVariable *ivPtr)
 {
-    Tcl_Obj *dictPtr;
     Tcl_Obj *keyPtr;
     Tcl_Obj *valuePtr1;
     Tcl_Obj *valuePtr2;
@@ -1117,14 +1260,6 @@ ItclAddClassVariableDictInfo(
     int newValue1;
 
     keyPtr = iclsPtr->fullNamePtr;
-    dictPtr = Tcl_GetVar2Ex(interp,
-             ITCL_NAMESPACE"::internal::dicts::classVariables",
-	     NULL, 0);
-    if (dictPtr == NULL) {
-        Tcl_AppendResult(interp, "cannot get dict ", ITCL_NAMESPACE,
-	        "::internal::dicts::classVariables", NULL);
-	return TCL_ERROR;
-    }
     if (Tcl_DictObjGet(interp, dictPtr, keyPtr, &valuePtr1) != TCL_OK) {
         return TCL_ERROR;
     }
@@ -1132,6 +1267,9 @@ ItclAddClassVariableDictInfo(
     if (valuePtr1 == NULL) {
         valuePtr1 = Tcl_NewDictObj();
         newValue1 = 1;
+    } else if (Tcl_IsShared(valuePtr1)) {
+        valuePtr1 = Tcl_DuplicateObj(valuePtr1);
+        newValue1 = 1;
     }
     keyPtr = ivPtr->namePtr;
     if (Tcl_DictObjGet(interp, valuePtr1, keyPtr, &valuePtr2) != TCL_OK) {
@@ -1139,6 +1277,8 @@ ItclAddClassVariableDictInfo(
     }
     if (valuePtr2 == NULL) {
         valuePtr2 = Tcl_NewDictObj();
+    } else if (Tcl_IsShared(valuePtr2)) {
+        valuePtr2 = Tcl_DuplicateObj(valuePtr2);
     }
     if (AddDictEntry(interp, valuePtr2, "-name", ivPtr->namePtr) != TCL_OK) {
         return TCL_ERROR;
@@ -1242,24 +1382,21 @@ ItclAddClassVariableDictInfo(
             return TCL_ERROR;
         }
     }
-    Tcl_SetVar2Ex(interp,
-            ITCL_NAMESPACE"::internal::dicts::classVariables",
-            NULL, dictPtr, 0);
     return TCL_OK;
 }
 
 /*
  * ------------------------------------------------------------------------
- *  ItclAddClassFunctionDictInfo()
+ *  AddClassFunctionDictInfo()
  * ------------------------------------------------------------------------
  */
-int
-ItclAddClassFunctionDictInfo(
+static int
+AddClassFunctionDictInfo(
     Tcl_Interp *interp,
+    Tcl_Obj *dictPtr,
     ItclClass *iclsPtr,
     ItclMemberFunc *imPtr)
 {
-    Tcl_Obj *dictPtr;
     Tcl_Obj *keyPtr;
     Tcl_Obj *valuePtr1;
     Tcl_Obj *valuePtr2;
@@ -1268,14 +1405,6 @@ ItclAddClassFunctionDictInfo(
     int haveFlags;
     int newValue1;
 
-    dictPtr = Tcl_GetVar2Ex(interp,
-             ITCL_NAMESPACE"::internal::dicts::classFunctions",
-	     NULL, 0);
-    if (dictPtr == NULL) {
-        Tcl_AppendResult(interp, "cannot get dict ", ITCL_NAMESPACE,
-	        "::internal::dicts::classFunctions", NULL);
-	return TCL_ERROR;
-    }
     keyPtr = iclsPtr->fullNamePtr;
     if (Tcl_DictObjGet(interp, dictPtr, keyPtr, &valuePtr1) != TCL_OK) {
         return TCL_ERROR;
@@ -1284,6 +1413,9 @@ ItclAddClassFunctionDictInfo(
     if (valuePtr1 == NULL) {
         valuePtr1 = Tcl_NewDictObj();
         newValue1 = 1;
+    } else if (Tcl_IsShared(valuePtr1)) {
+        valuePtr1 = Tcl_DuplicateObj(valuePtr1);
+        newValue1 = 1;
     }
     keyPtr = imPtr->namePtr;
     if (Tcl_DictObjGet(interp, valuePtr1, keyPtr, &valuePtr2) != TCL_OK) {
@@ -1370,7 +1502,7 @@ ItclAddClassFunctionDictInfo(
                 return TCL_ERROR;
             }
 	}
-        if (imPtr->codePtr->usagePtr != NULL) {
+        if (ItclMemberCodeUsage(imPtr->codePtr) != NULL) {
             if (AddDictEntry(interp, valuePtr2, "-usage",
 	            imPtr->codePtr->usagePtr) != TCL_OK) {
                 return TCL_ERROR;
@@ -1402,25 +1534,22 @@ ItclAddClassFunctionDictInfo(
             return TCL_ERROR;
         }
     }
-    Tcl_SetVar2Ex(interp,
-            ITCL_NAMESPACE"::internal::dicts::classFunctions",
-            NULL, dictPtr, 0);
     return TCL_OK;
 }
 
 /*
  * ------------------------------------------------------------------------
- *  ItclAddClassDelegatedFunctionDictInfo()
+ *  AddClassDelegatedFunctionDictInfo()
  * ------------------------------------------------------------------------
  */
-int
-ItclAddClassDelegatedFunctionDictInfo(
+static int
+AddClassDelegatedFunctionDictInfo(
     Tcl_Interp *interp,
+    Tcl_Obj *dictPtr,
     ItclClass *iclsPtr,
     ItclDelegatedFunction *idmPtr)
 {
     FOREACH_HASH_DECLS;
-    Tcl_Obj *dictPtr;
     Tcl_Obj *keyPtr;
     Tcl_Obj *valuePtr1;
     Tcl_Obj *valuePtr2;
@@ -1430,14 +1559,6 @@ ItclAddClassDelegatedFunctionDictInfo(
     int newValue1;
 
     keyPtr = iclsPtr->fullNamePtr;
-    dictPtr = Tcl_GetVar2Ex(interp,
-             ITCL_NAMESPACE"::internal::dicts::classDelegatedFunctions",
-	     NULL, 0);
-    if (dictPtr == NULL) {
-        Tcl_AppendResult(interp, "cannot get dict ", ITCL_NAMESPACE,
-	        "::internal::dicts::classDelegatedFunctions", NULL);
-	return TCL_ERROR;
-    }
     if (Tcl_DictObjGet(interp, dictPtr, keyPtr, &valuePtr1) != TCL_OK) {
         return TCL_ERROR;
     }
@@ -1445,6 +1566,9 @@ ItclAddClassDelegatedFunctionDictInfo(
     if (valuePtr1 == NULL) {
         valuePtr1 = Tcl_NewDictObj();
         newValue1 = 1;
+    } else if (Tcl_IsShared(valuePtr1)) {
+        valuePtr1 = Tcl_DuplicateObj(valuePtr1);
+        newValue1 = 1;
     }
     keyPtr = idmPtr->namePtr;
     if (Tcl_DictObjGet(interp, valuePtr1, keyPtr, &valuePtr2) != TCL_OK) {
@@ -1452,6 +1576,8 @@ ItclAddClassDelegatedFunctionDictInfo(
     }
     if (valuePtr2 == NULL) {
         valuePtr2 = Tcl_NewDictObj();
+    } else if (Tcl_IsShared(valuePtr2)) {
+        valuePtr2 = Tcl_DuplicateObj(valuePtr2);
     }
     if (AddDictEntry(interp, valuePtr2, "-name", idmPtr->namePtr) != TCL_OK) {
         return TCL_ERROR;
@@ -1503,8 +1629,210 @@ ItclAddClassDelegatedFunctionDictInfo(
             return TCL_ERROR;
         }
     }
-    Tcl_SetVar2Ex(interp,
-            ITCL_NAMESPACE"::internal::dicts::classDelegatedFunctions",
-            NULL, dictPtr, 0);
     return TCL_OK;
 }
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclAddClassesDictInfo()
+ *  ItclAddOptionDictInfo()
+ *  ItclAddDelegatedOptionDictInfo()
+ *  ItclAddClassComponentDictInfo()
+ *  ItclAddClassVariableDictInfo()
+ *  ItclAddClassFunctionDictInfo()
+ *  ItclAddClassDelegatedFunctionDictInfo()
+ *
+ *  Record a class or class member for the ::itcl::internal::dicts
+ *  class variables.  The entries are built by FlushDictInfos() on the
+ *  first read of any of those variables.
+ * ------------------------------------------------------------------------
+ */
+int
+ItclAddClassesDictInfo(
+    Tcl_Interp *interp,
+    ItclClass *iclsPtr)
+{
+    return QueueDictInfo(iclsPtr, ITCL_DICT_INFO_CLASS, iclsPtr);
+}
+
+int
+ItclAddOptionDictInfo(
+    Tcl_Interp *interp,
+    ItclClass *iclsPtr,
+    ItclOption *ioptPtr)
+{
+    return QueueDictInfo(iclsPtr, ITCL_DICT_INFO_OPTION, ioptPtr);
+}
+
+int
+ItclAddDelegatedOptionDictInfo(
+    Tcl_Interp *interp,
+    ItclClass *iclsPtr,
+    ItclDelegatedOption *idoPtr)
+{
+    return QueueDictInfo(iclsPtr, ITCL_DICT_INFO_DELEGATED_OPTION, idoPtr);
+}
+
+int
+ItclAddClassComponentDictInfo(
+    Tcl_Interp *interp,
+    ItclClass *iclsPtr,
+    ItclComponent *icPtr)
+{
+    return QueueDictInfo(iclsPtr, ITCL_DICT_INFO_COMPONENT, icPtr);
+}
+
+int
+ItclAddClassVariableDictInfo(
+    Tcl_Interp *interp,
+    ItclClass *iclsPtr,
+    ItclVariable *ivPtr)
+{
+    return QueueDictInfo(iclsPtr, ITCL_DICT_INFO_VARIABLE, ivPtr);
+}
+
+int
+ItclAddClassFunctionDictInfo(
+    Tcl_Interp *interp,
+    ItclClass *iclsPtr,
+    ItclMemberFunc *imPtr)
+{
+    return QueueDictInfo(iclsPtr, ITCL_DICT_INFO_FUNCTION, imPtr);
+}
+
+int
+ItclAddClassDelegatedFunctionDictInfo(
+    Tcl_Interp *interp,
+    ItclClass *iclsPtr,
+    ItclDelegatedFunction *idmPtr)
+{
+    return QueueDictInfo(iclsPtr, ITCL_DICT_INFO_DELEGATED_FUNCTION, idmPtr);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  FlushDictInfos()
+ *
+ *  Writes all queued entries into the ::itcl::internal::dicts class
+ *  variables, in the order they were queued.  Each variable is fetched
+ *  and stored only once.
+ * ------------------------------------------------------------------------
+ */
+static void
+FlushDictInfos(
+    ItclObjectInfo *infoPtr)
+{
+    Tcl_Interp *interp = infoPtr->interp;
+    Tcl_InterpState state;
+    Tcl_Obj *dicts[ITCL_DICT_INFO_DELEGATED_FUNCTION+1];
+    ItclDictInfo *dictInfos;
+    ItclDictInfo *diPtr;
+    Tcl_Obj *dictPtr;
+    int numDictInfos;
+    int i;
+
+    /*
+     *  Detach the queue first: fetching the dict variables runs their
+     *  traces again.
+     */
+    dictInfos = infoPtr->dictInfos;
+    numDictInfos = infoPtr->numDictInfos;
+    infoPtr->dictInfos = NULL;
+    infoPtr->numDictInfos = 0;
+    infoPtr->maxDictInfos = 0;
+    infoPtr->numDeadDictInfos = 0;
+    infoPtr->dictInfosFlushed = 1;
+
+    state = Tcl_SaveInterpState(interp, TCL_OK);
+    memset(dicts, 0, sizeof(dicts));
+    for (i = 0; i < numDictInfos; i++) {
+        diPtr = &dictInfos[i];
+	if (diPtr->iclsPtr == NULL) {
+	    continue;
+	}
+	diPtr->iclsPtr->numDictInfos--;
+	dictPtr = dicts[diPtr->kind];
+	if (dictPtr == NULL) {
+	    dictPtr = Tcl_GetVar2Ex(interp, ItclDictInfoVarNames[diPtr->kind],
+	            NULL, TCL_GLOBAL_ONLY);
+	    if (dictPtr == NULL) {
+	        /* the variable was unset */
+	        continue;
+	    }
+	    if (Tcl_IsShared(dictPtr)) {
+	        dictPtr = Tcl_SetVar2Ex(interp,
+		        ItclDictInfoVarNames[diPtr->kind], NULL,
+		        Tcl_DuplicateObj(dictPtr), TCL_GLOBAL_ONLY);
+		if (dictPtr == NULL) {
+		    continue;
+		}
+	    }
+	    dicts[diPtr->kind] = dictPtr;
+	}
+	switch (diPtr->kind) {
+	case ITCL_DICT_INFO_CLASS:
+	    AddClassesDictInfo(interp, dictPtr, diPtr->iclsPtr);
+	    break;
+	case ITCL_DICT_INFO_OPTION:
+	    AddOptionDictInfo(interp, dictPtr, diPtr->iclsPtr,
+	            (ItclOption *)diPtr->memberPtr);
+	    break;
+	case ITCL_DICT_INFO_DELEGATED_OPTION:
+	    AddDelegatedOptionDictInfo(interp, dictPtr, diPtr->iclsPtr,
+	            (ItclDelegatedOption *)diPtr->memberPtr);
+	    break;
+	case ITCL_DICT_INFO_COMPONENT:
+	    AddClassComponentDictInfo(interp, dictPtr, diPtr->iclsPtr,
+	            (ItclComponent *)diPtr->memberPtr);
+	    break;
+	case ITCL_DICT_INFO_VARIABLE:
+	    AddClassVariableDictInfo(interp, dictPtr, diPtr->iclsPtr,
+	            (ItclVariable *)diPtr->memberPtr);
+	    break;
+	case ITCL_DICT_INFO_FUNCTION:
+	    AddClassFunctionDictInfo(interp, dictPtr, diPtr->iclsPtr,
+	            (ItclMemberFunc *)diPtr->memberPtr);
+	    break;
+	case ITCL_DICT_INFO_DELEGATED_FUNCTION:
+	    AddClassDelegatedFunctionDictInfo(interp, dictPtr, diPtr->iclsPtr,
+	            (ItclDelegatedFunction *)diPtr->memberPtr);
+	    break;
+	}
+    }
+    for (i = ITCL_DICT_INFO_CLASS; i <= ITCL_DICT_INFO_DELEGATED_FUNCTION;
+            i++) {
+        if (dicts[i] != NULL) {
+	    /* the dicts were changed in place; let write traces see it */
+	    Tcl_SetVar2Ex(interp, ItclDictInfoVarNames[i], NULL, dicts[i],
+	            TCL_GLOBAL_ONLY);
+	}
+    }
+    Tcl_RestoreInterpState(interp, state);
+    if (dictInfos != NULL) {
+        ckfree((char *)dictInfos);
+    }
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclClassDictsTrace()
+ *
+ *  Read trace on the ::itcl::internal::dicts class variables.  Brings
+ *  all of them up to date before the value is returned.
+ * ------------------------------------------------------------------------
+ */
+char *
+ItclClassDictsTrace(
+    ClientData clientData,   /* the ItclObjectInfo */
+    Tcl_Interp *interp,      /* current interpreter */
+    const char *name1,       /* variable name */
+    const char *name2,       /* unused */
+    int flags)               /* flags indicating read/write */
+{
+    ItclObjectInfo *infoPtr = (ItclObjectInfo *)clientData;
+
+    if (!(flags & TCL_INTERP_DESTROYED) && (infoPtr->numDictInfos > 0)) {
+        FlushDictInfos(infoPtr);
+    }
+    return NULL;
+}
@@ -318,26 +318,14 @@ InfoGutsFinish(
 {
     Tcl_CallFrame *framePtr = (Tcl_CallFrame *) data[0];
     ItclObjectInfo *infoPtr = (ItclObjectInfo *) data[1];
-    ItclCallContext *cPtr = (ItclCallContext *) data[2];
     ItclCallContext *popped;
 
-    Tcl_HashEntry *hPtr = Tcl_FindHashEntry(&infoPtr->frameContext,
-	    (char *) framePtr);
+    popped = ItclPopFrameContext(infoPtr, framePtr, NULL);
 
-    Itcl_Stack *stackPtr = (Itcl_Stack *) Tcl_GetHashValue(hPtr);
-
-    popped = Itcl_PopStack(stackPtr);
-
-    if (Itcl_GetStackSize(stackPtr) == 0) {
-	Itcl_DeleteStack(stackPtr);
-	ckfree((char *)stackPtr);
-	Tcl_DeleteHashEntry(hPtr);
-    }
-
-    if (cPtr != popped) {
+    if ((popped == NULL)
+	    || !(popped->objectFlags & ITCL_OBJECT_ROOT_METHOD)) {
 	Tcl_Panic("Context stack mismatch!");
     }
-    ckfree((char *) cPtr);
 
     return result;
 }
@@ -353,9 +341,6 @@ ItclInfoGuts(
     Tcl_CmdInfo info;
     ItclCallContext *cPtr;
     Tcl_CallFrame *framePtr;
-    Tcl_HashEntry *hPtr;
-    Itcl_Stack *stackPtr;
-    int new;
 
     if (objc == 2) {
 	/*
@@ -372,25 +357,11 @@ ItclInfoGuts(
 
     framePtr = Itcl_GetUplevelCallFrame(interp, 0);
 
-    hPtr = Tcl_CreateHashEntry(&infoPtr->frameContext, (char *)framePtr, &new);
-    if (new) {
-	stackPtr = (Itcl_Stack *) ckalloc(sizeof(Itcl_Stack));
-	Itcl_InitStack(stackPtr);
-	Tcl_SetHashValue(hPtr, stackPtr);
-    } else {
-	stackPtr = (Itcl_Stack *) Tcl_GetHashValue(hPtr);
-    }
-
-    cPtr = (ItclCallContext *) ckalloc(sizeof(ItclCallContext));
+    cPtr = ItclPushFrameContext(infoPtr, framePtr, NULL, NULL);
     cPtr->objectFlags = ITCL_OBJECT_ROOT_METHOD;
-    cPtr->nsPtr = NULL;
     cPtr->ioPtr = ioPtr;
-    cPtr->imPtr = NULL;
-    cPtr->refCount = 1;
-
-    Itcl_PushStack(cPtr, stackPtr);
 
-    Tcl_NRAddCallback(interp, InfoGutsFinish, framePtr, infoPtr, cPtr, NULL);
+    Tcl_NRAddCallback(interp, InfoGutsFinish, framePtr, infoPtr, NULL, NULL);
     Tcl_GetCommandInfoFromToken(infoPtr->infoCmd, &info);
     return Tcl_NRCallObjProc(interp, info.objProc, info.objClientData,
 	    objc-1, objv+1);
@@ -965,10 +936,10 @@ Itcl_BiInfoHeritageCmd(
 {
     ItclClass *contextIclsPtr = NULL;
     ItclObject *contextIoPtr = NULL;
-    ItclHierIter hier;
     Tcl_Obj *listPtr;
     Tcl_Obj *objPtr;
     ItclClass *iclsPtr;
+    int hierIdx;
 
     ItclShowArgs(2, "Itcl_BiInfoHeritageCmd", objc, objv);
     if (objc != 1) {
@@ -993,8 +964,8 @@ Itcl_BiInfoHeritageCmd(
      *  base class names.
      */
     listPtr = Tcl_NewListObj(0, (Tcl_Obj**)NULL);
-    Itcl_InitHierIter(&hier, contextIclsPtr);
-    while ((iclsPtr=Itcl_AdvanceHierIter(&hier)) != NULL) {
+    for (hierIdx = 0; hierIdx < contextIclsPtr->numHierarchy; hierIdx++) {
+        iclsPtr = contextIclsPtr->hierarchy[hierIdx];
         if (iclsPtr->nsPtr == NULL) {
             Tcl_AppendResult(interp, "ITCL: iclsPtr->nsPtr == NULL",
 	            Tcl_GetString(iclsPtr->fullNamePtr), NULL);
@@ -1003,7 +974,6 @@ Itcl_BiInfoHeritageCmd(
             objPtr = Tcl_NewStringObj(iclsPtr->nsPtr->fullName, -1);
         Tcl_ListObjAppendElement((Tcl_Interp*)NULL, listPtr, objPtr);
     }
-    Itcl_DeleteHierIter(&hier);
 
     Tcl_SetObjResult(interp, listPtr);
     return TCL_OK;
@@ -1064,7 +1034,7 @@ Itcl_BiInfoFunctionCmd(
     Tcl_HashEntry *entry;
     ItclMemberFunc *imPtr;
     ItclMemberCode *mcode;
-    ItclHierIter hier;
+    int hierIdx;
 
     ItclShowArgs(2, "Itcl_InfoFunctionCmd", objc, objv);
     /*
@@ -1145,21 +1115,21 @@ Itcl_BiInfoFunctionCmd(
             switch (iflist[i]) {
                 case BIfArgsIdx:
                     if (mcode && mcode->argListPtr) {
-			if (imPtr->usagePtr == NULL) {
+			if (ItclMemberFuncUsage(imPtr) == NULL) {
                             objPtr = Tcl_NewStringObj(
-			            Tcl_GetString(mcode->usagePtr), -1);
+			            Tcl_GetString(ItclMemberCodeUsage(mcode)), -1);
 			} else {
                             objPtr = Tcl_NewStringObj(
-			            Tcl_GetString(imPtr->usagePtr), -1);
+			            Tcl_GetString(ItclMemberFuncUsage(imPtr)), -1);
 		        }
                     } else {
 		        if ((imPtr->flags & ITCL_ARG_SPEC) != 0) {
-			    if (imPtr->usagePtr == NULL) {
+			    if (ItclMemberFuncUsage(imPtr) == NULL) {
                                 objPtr = Tcl_NewStringObj(
-				        Tcl_GetString(mcode->usagePtr), -1);
+				        Tcl_GetString(ItclMemberCodeUsage(mcode)), -1);
 			    } else {
 			        objPtr = Tcl_NewStringObj(
-				        Tcl_GetString(imPtr->usagePtr), -1);
+				        Tcl_GetString(ItclMemberFuncUsage(imPtr)), -1);
 			    }
                         } else {
                             objPtr = Tcl_NewStringObj("<undefined>", -1);
@@ -1207,8 +1177,8 @@ Itcl_BiInfoFunctionCmd(
          */
         resultPtr = Tcl_NewListObj(0, (Tcl_Obj**)NULL);
 
-        Itcl_InitHierIter(&hier, contextIclsPtr);
-        while ((iclsPtr=Itcl_AdvanceHierIter(&hier)) != NULL) {
+        for (hierIdx = 0; hierIdx < contextIclsPtr->numHierarchy; hierIdx++) {
+            iclsPtr = contextIclsPtr->hierarchy[hierIdx];
             entry = Tcl_FirstHashEntry(&iclsPtr->functions, &place);
             while (entry) {
 	        int useIt = 1;
@@ -1241,7 +1211,6 @@ Itcl_BiInfoFunctionCmd(
                 entry = Tcl_NextHashEntry(&place);
             }
         }
-        Itcl_DeleteHierIter(&hier);
 
         Tcl_SetObjResult(interp, resultPtr);
     }
@@ -1281,7 +1250,7 @@ Itcl_BiInfoVariableCmd(
     ItclObject *contextIoPtr;
     ItclVariable *ivPtr;
     ItclVarLookup *vlookup;
-    ItclHierIter hier;
+    int hierIdx;
     char *varName;
     const char *val;
     int i;
@@ -1491,8 +1460,8 @@ Itcl_BiInfoVariableCmd(
          *  "this" variable only once, for the most-specific class.
          */
         resultPtr = Tcl_NewListObj(0, (Tcl_Obj**)NULL);
-        Itcl_InitHierIter(&hier, contextIclsPtr);
-        while ((iclsPtr=Itcl_AdvanceHierIter(&hier)) != NULL) {
+        for (hierIdx = 0; hierIdx < contextIclsPtr->numHierarchy; hierIdx++) {
+            iclsPtr = contextIclsPtr->hierarchy[hierIdx];
             entry = Tcl_FirstHashEntry(&iclsPtr->variables, &place);
             while (entry) {
                 ivPtr = (ItclVariable*)Tcl_GetHashValue(entry);
@@ -1512,7 +1481,6 @@ Itcl_BiInfoVariableCmd(
                 entry = Tcl_NextHashEntry(&place);
             }
         }
-        Itcl_DeleteHierIter(&hier);
 
         Tcl_SetObjResult(interp, resultPtr);
     }
@@ -1922,7 +1890,7 @@ Itcl_BiInfoArgsCmd(
          */
         if ((mcode && mcode->argListPtr != NULL)
 		|| ((imPtr->flags & ITCL_ARG_SPEC) != 0)) {
-	    Tcl_SetObjResult(interp, imPtr->usagePtr);
+	    Tcl_SetObjResult(interp, ItclMemberFuncUsage(imPtr));
         } else {
 	    Tcl_SetObjResult(interp, Tcl_NewStringObj("<undefined>", -1));
         }
@@ -2025,7 +1993,7 @@ Itcl_BiInfoOptionCmd(
     ItclClass *contextIclsPtr;
     ItclObject *contextIoPtr;
     ItclOption *ioptPtr;
-    ItclHierIter hier;
+    int hierIdx;
     ItclClass *iclsPtr;
     const char *val;
     int i;
@@ -2073,7 +2041,7 @@ Itcl_BiInfoOptionCmd(
 	    return TCL_ERROR;
 	}
 	optionNamePtr = Tcl_NewStringObj(optionName, -1);
-        hPtr = Tcl_FindHashEntry(&contextIoPtr->objectOptions,
+        hPtr = Tcl_FindHashEntry(ITCL_OBJECT_TABLE(contextIoPtr, objectOptions),
 	        (char *)optionNamePtr);
         if (hPtr == NULL) {
             Tcl_AppendStringsToObj(Tcl_GetObjResult(interp),
@@ -2241,8 +2209,8 @@ Itcl_BiInfoOptionCmd(
          */
         resultPtr = Tcl_NewListObj(0, (Tcl_Obj**)NULL);
 	Tcl_IncrRefCount(resultPtr);
-        Itcl_InitHierIter(&hier, contextIclsPtr);
-        while ((iclsPtr=Itcl_AdvanceHierIter(&hier)) != NULL) {
+        for (hierIdx = 0; hierIdx < contextIclsPtr->numHierarchy; hierIdx++) {
+            iclsPtr = contextIclsPtr->hierarchy[hierIdx];
             hPtr = Tcl_FirstHashEntry(&iclsPtr->options, &place);
             while (hPtr) {
                 ioptPtr = (ItclOption*)Tcl_GetHashValue(hPtr);
@@ -2251,7 +2219,6 @@ Itcl_BiInfoOptionCmd(
                 hPtr = Tcl_NextHashEntry(&place);
             }
         }
-        Itcl_DeleteHierIter(&hier);
 
         Tcl_SetObjResult(interp, resultPtr);
     }
@@ -2307,9 +2274,10 @@ Itcl_BiInfoComponentCmd(
     Tcl_HashEntry *hPtr;
     Tcl_Namespace *nsPtr;
     ItclComponent *icPtr;
-    ItclHierIter hier;
     ItclClass *iclsPtr;
+    ItclClass *hierClsPtr;
     const char *val;
+    int hierIdx;
     int i;
     int result;
 
@@ -2361,18 +2329,19 @@ Itcl_BiInfoComponentCmd(
     if (componentName) {
 	componentNamePtr = Tcl_NewStringObj(componentName, -1);
 	if (contextIoPtr != NULL) {
-	    Itcl_InitHierIter(&hier, contextIoPtr->iclsPtr);
+	    hierClsPtr = contextIoPtr->iclsPtr;
 	} else {
-	    Itcl_InitHierIter(&hier, contextIclsPtr);
+	    hierClsPtr = contextIclsPtr;
 	}
-	while ((iclsPtr = Itcl_AdvanceHierIter(&hier)) != NULL) {
+	hPtr = NULL;
+	for (hierIdx = 0; hierIdx < hierClsPtr->numHierarchy; hierIdx++) {
+	    iclsPtr = hierClsPtr->hierarchy[hierIdx];
 	    hPtr = Tcl_FindHashEntry(&iclsPtr->components,
 	            (char *)componentNamePtr);
 	    if (hPtr != NULL) {
 	        break;
 	    }
 	}
-	Itcl_DeleteHierIter(&hier);
         if (hPtr == NULL) {
             Tcl_AppendStringsToObj(Tcl_GetObjResult(interp),
                 "\"", componentName, "\" isn't a component in class \"",
@@ -2460,8 +2429,8 @@ Itcl_BiInfoComponentCmd(
          */
         resultPtr = Tcl_NewListObj(0, (Tcl_Obj**)NULL);
 	Tcl_IncrRefCount(resultPtr);
-        Itcl_InitHierIter(&hier, contextIclsPtr);
-        while ((iclsPtr=Itcl_AdvanceHierIter(&hier)) != NULL) {
+        for (hierIdx = 0; hierIdx < contextIclsPtr->numHierarchy; hierIdx++) {
+            iclsPtr = contextIclsPtr->hierarchy[hierIdx];
             hPtr = Tcl_FirstHashEntry(&iclsPtr->components, &place);
             while (hPtr) {
                 icPtr = (ItclComponent *)Tcl_GetHashValue(hPtr);
@@ -2471,7 +2440,6 @@ Itcl_BiInfoComponentCmd(
                 hPtr = Tcl_NextHashEntry(&place);
             }
         }
-        Itcl_DeleteHierIter(&hier);
 
         Tcl_SetObjResult(interp, resultPtr);
     }
@@ -3024,7 +2992,7 @@ Itcl_BiInfoMethodCmd(
     ItclClass *iclsPtr;
     ItclMemberFunc *imPtr;
     ItclMemberCode *mcode;
-    ItclHierIter hier;
+    int hierIdx;
     const char *val;
     char *cmdName;
     int i;
@@ -3135,21 +3103,21 @@ Itcl_BiInfoMethodCmd(
             switch (iflist[i]) {
                 case BIfArgsIdx:
                     if (mcode && mcode->argListPtr) {
-			if (imPtr->usagePtr == NULL) {
+			if (ItclMemberFuncUsage(imPtr) == NULL) {
                             objPtr = Tcl_NewStringObj(
-			            Tcl_GetString(mcode->usagePtr), -1);
+			            Tcl_GetString(ItclMemberCodeUsage(mcode)), -1);
 			} else {
                             objPtr = Tcl_NewStringObj(
-			            Tcl_GetString(imPtr->usagePtr), -1);
+			            Tcl_GetString(ItclMemberFuncUsage(imPtr)), -1);
 		        }
                     } else {
 		        if ((imPtr->flags & ITCL_ARG_SPEC) != 0) {
-			    if (imPtr->usagePtr == NULL) {
+			    if (ItclMemberFuncUsage(imPtr) == NULL) {
                                 objPtr = Tcl_NewStringObj(
-				        Tcl_GetString(mcode->usagePtr), -1);
+				        Tcl_GetString(ItclMemberCodeUsage(mcode)), -1);
 			    } else {
 			        objPtr = Tcl_NewStringObj(
-				        Tcl_GetString(imPtr->usagePtr), -1);
+				        Tcl_GetString(ItclMemberFuncUsage(imPtr)), -1);
 			    }
                         } else {
                             objPtr = Tcl_NewStringObj("<undefined>", -1);
@@ -3196,8 +3164,8 @@ Itcl_BiInfoMethodCmd(
          */
         resultPtr = Tcl_NewListObj(0, (Tcl_Obj**)NULL);
 
-        Itcl_InitHierIter(&hier, contextIclsPtr);
-        while ((iclsPtr=Itcl_AdvanceHierIter(&hier)) != NULL) {
+        for (hierIdx = 0; hierIdx < contextIclsPtr->numHierarchy; hierIdx++) {
+            iclsPtr = contextIclsPtr->hierarchy[hierIdx];
             hPtr = Tcl_FirstHashEntry(&iclsPtr->functions, &place);
             while (hPtr) {
 	        int useIt = 1;
@@ -3216,7 +3184,6 @@ Itcl_BiInfoMethodCmd(
                 hPtr = Tcl_NextHashEntry(&place);
             }
         }
-        Itcl_DeleteHierIter(&hier);
 
         Tcl_SetObjResult(interp, resultPtr);
     }
@@ -3380,7 +3347,7 @@ Itcl_BiInfoOptionsCmd(
     if (ioPtr == NULL) {
         tablePtr = &iclsPtr->options;
     } else {
-        tablePtr = &ioPtr->objectOptions;
+        tablePtr = ITCL_OBJECT_TABLE(ioPtr, objectOptions);
     }
     FOREACH_HASH_VALUE(ioptPtr, tablePtr) {
 	name = Tcl_GetString(ioptPtr->namePtr);
@@ -3393,7 +3360,7 @@ Itcl_BiInfoOptionsCmd(
     if (ioPtr == NULL) {
         tablePtr = &iclsPtr->delegatedOptions;
     } else {
-        tablePtr = &ioPtr->objectDelegatedOptions;
+        tablePtr = ITCL_OBJECT_TABLE(ioPtr, objectDelegatedOptions);
     }
     FOREACH_HASH_VALUE(idoPtr, tablePtr) {
         name = Tcl_GetString(idoPtr->namePtr);
@@ -3518,7 +3485,7 @@ Itcl_BiInfoComponentsCmd(
     ItclObject *ioPtr;
     ItclClass *iclsPtr;
     ItclComponent *icPtr;
-    ItclHierIter hier;
+    int hierIdx;
     ItclClass *iclsPtr2;
     const char *name;
     const char *pattern;
@@ -3547,9 +3514,8 @@ Itcl_BiInfoComponentsCmd(
         pattern = Tcl_GetString(objv[1]);
     }
     listPtr = Tcl_NewListObj(0, NULL);
-    Itcl_InitHierIter(&hier, iclsPtr);
-    iclsPtr2 = Itcl_AdvanceHierIter(&hier);
-    while (iclsPtr2 != NULL) {
+    for (hierIdx = 0; hierIdx < iclsPtr->numHierarchy; hierIdx++) {
+        iclsPtr2 = iclsPtr->hierarchy[hierIdx];
         FOREACH_HASH_VALUE(icPtr, &iclsPtr2->components) {
             name = Tcl_GetString(icPtr->namePtr);
             if ((pattern == NULL) ||
@@ -3558,9 +3524,7 @@ Itcl_BiInfoComponentsCmd(
 	                Tcl_NewStringObj(Tcl_GetString(icPtr->namePtr), -1));
             }
         }
-        iclsPtr2 = Itcl_AdvanceHierIter(&hier);
     }
-    Itcl_DeleteHierIter(&hier);
     Tcl_SetObjResult(interp, listPtr);
     return TCL_OK;
 }
@@ -3593,7 +3557,7 @@ Itcl_BiInfoTypeMethodCmd(
     ItclClass *iclsPtr;
     ItclMemberFunc *imPtr;
     ItclMemberCode *mcode;
-    ItclHierIter hier;
+    int hierIdx;
     const char *val;
     char *cmdName;
     int i;
@@ -3705,21 +3669,21 @@ Itcl_BiInfoTypeMethodCmd(
             switch (iflist[i]) {
                 case BIfArgsIdx:
                     if (mcode && mcode->argListPtr) {
-			if (imPtr->usagePtr == NULL) {
+			if (ItclMemberFuncUsage(imPtr) == NULL) {
                             objPtr = Tcl_NewStringObj(
-			            Tcl_GetString(mcode->usagePtr), -1);
+			            Tcl_GetString(ItclMemberCodeUsage(mcode)), -1);
 			} else {
                             objPtr = Tcl_NewStringObj(
-			            Tcl_GetString(imPtr->usagePtr), -1);
+			            Tcl_GetString(ItclMemberFuncUsage(imPtr)), -1);
 		        }
                     } else {
 		        if ((imPtr->flags & ITCL_ARG_SPEC) != 0) {
-			    if (imPtr->usagePtr == NULL) {
+			    if (ItclMemberFuncUsage(imPtr) == NULL) {
                                 objPtr = Tcl_NewStringObj(
-				        Tcl_GetString(mcode->usagePtr), -1);
+				        Tcl_GetString(ItclMemberCodeUsage(mcode)), -1);
 			    } else {
 			        objPtr = Tcl_NewStringObj(
-				        Tcl_GetString(imPtr->usagePtr), -1);
+				        Tcl_GetString(ItclMemberFuncUsage(imPtr)), -1);
 			    }
                         } else {
                             objPtr = Tcl_NewStringObj("<undefined>", -1);
@@ -3766,8 +3730,8 @@ Itcl_BiInfoTypeMethodCmd(
          */
         resultPtr = Tcl_NewListObj(0, (Tcl_Obj**)NULL);
 
-        Itcl_InitHierIter(&hier, contextIclsPtr);
-        while ((iclsPtr=Itcl_AdvanceHierIter(&hier)) != NULL) {
+        for (hierIdx = 0; hierIdx < contextIclsPtr->numHierarchy; hierIdx++) {
+            iclsPtr = contextIclsPtr->hierarchy[hierIdx];
             hPtr = Tcl_FirstHashEntry(&iclsPtr->functions, &place);
             while (hPtr) {
 	        int useIt = 1;
@@ -3786,7 +3750,6 @@ Itcl_BiInfoTypeMethodCmd(
                 hPtr = Tcl_NextHashEntry(&place);
             }
         }
-        Itcl_DeleteHierIter(&hier);
 
         Tcl_SetObjResult(interp, resultPtr);
     }
@@ -3983,7 +3946,7 @@ Itcl_BiInfoTypeVariableCmd(
     ItclObject *contextIoPtr;
     ItclVariable *ivPtr;
     ItclVarLookup *vlookup;
-    ItclHierIter hier;
+    int hierIdx;
     char *varName;
     const char *val;
     int i;
@@ -4175,8 +4138,8 @@ Itcl_BiInfoTypeVariableCmd(
          *  "this" variable only once, for the most-specific class.
          */
         resultPtr = Tcl_NewListObj(0, (Tcl_Obj**)NULL);
-        Itcl_InitHierIter(&hier, contextIclsPtr);
-        while ((iclsPtr=Itcl_AdvanceHierIter(&hier)) != NULL) {
+        for (hierIdx = 0; hierIdx < contextIclsPtr->numHierarchy; hierIdx++) {
+            iclsPtr = contextIclsPtr->hierarchy[hierIdx];
             hPtr = Tcl_FirstHashEntry(&iclsPtr->variables, &place);
             while (hPtr) {
                 ivPtr = (ItclVariable*)Tcl_GetHashValue(hPtr);
@@ -4198,7 +4161,6 @@ Itcl_BiInfoTypeVariableCmd(
                 hPtr = Tcl_NextHashEntry(&place);
             }
         }
-        Itcl_DeleteHierIter(&hier);
 
         Tcl_SetObjResult(interp, resultPtr);
     }
@@ -4340,10 +4302,8 @@ Itcl_BiInfoInstancesCmd(
     int objc,              /* number of arguments */
     Tcl_Obj *const objv[]) /* argument objects */
 {
-    FOREACH_HASH_DECLS;
     Tcl_Obj *listPtr;
     Tcl_Obj *objPtr;
-    ItclObjectInfo *infoPtr;
     ItclObject *ioPtr;
     ItclClass *iclsPtr;
     const char *pattern;
@@ -4366,11 +4326,10 @@ Itcl_BiInfoInstancesCmd(
     if (objc == 2) {
         pattern = Tcl_GetString(objv[1]);
     }
-    infoPtr = (ItclObjectInfo *)clientData;
     listPtr = Tcl_NewListObj(0, NULL);
-    FOREACH_HASH_VALUE(ioPtr, &infoPtr->objects) {
-	/* FIXME need to scan the inheritance too */
-        if (ioPtr->iclsPtr == iclsPtr) {
+    for (ioPtr = (iclsPtr != NULL) ? iclsPtr->firstInstancePtr : NULL;
+            ioPtr != NULL; ioPtr = ioPtr->nextInstancePtr) {
+        if (ioPtr->accessCmd != NULL) {
 	    if (ioPtr->iclsPtr->flags & ITCL_WIDGETADAPTOR) {
 	        objPtr = Tcl_NewStringObj(Tcl_GetCommandName(interp,
 		        ioPtr->accessCmd), -1);
@@ -4670,7 +4629,7 @@ Itcl_BiInfoDelegatedOptionCmd(
     ItclObject *contextIoPtr;
     ItclObjectInfo *infoPtr;
     ItclDelegatedOption *idoptPtr;
-    ItclHierIter hier;
+    int hierIdx;
     ItclClass *iclsPtr;
     char *optionName;
     int i;
@@ -4747,7 +4706,8 @@ Itcl_BiInfoDelegatedOptionCmd(
 	    return TCL_ERROR;
 	}
 	optionNamePtr = Tcl_NewStringObj(optionName, -1);
-        hPtr = Tcl_FindHashEntry(&contextIoPtr->objectDelegatedOptions,
+        hPtr = Tcl_FindHashEntry(
+                ITCL_OBJECT_TABLE(contextIoPtr, objectDelegatedOptions),
 	        (char *)optionNamePtr);
         if (hPtr == NULL) {
             Tcl_AppendStringsToObj(Tcl_GetObjResult(interp),
@@ -4858,8 +4818,8 @@ Itcl_BiInfoDelegatedOptionCmd(
          */
         resultPtr = Tcl_NewListObj(0, (Tcl_Obj**)NULL);
 	Tcl_IncrRefCount(resultPtr);
-        Itcl_InitHierIter(&hier, contextIclsPtr);
-        while ((iclsPtr=Itcl_AdvanceHierIter(&hier)) != NULL) {
+        for (hierIdx = 0; hierIdx < contextIclsPtr->numHierarchy; hierIdx++) {
+            iclsPtr = contextIclsPtr->hierarchy[hierIdx];
             hPtr = Tcl_FirstHashEntry(&iclsPtr->delegatedOptions, &place);
             while (hPtr) {
                 idoptPtr = (ItclDelegatedOption*)Tcl_GetHashValue(hPtr);
@@ -4868,7 +4828,6 @@ Itcl_BiInfoDelegatedOptionCmd(
                 hPtr = Tcl_NextHashEntry(&place);
             }
         }
-        Itcl_DeleteHierIter(&hier);
 
         Tcl_SetObjResult(interp, resultPtr);
     }
@@ -4907,7 +4866,7 @@ Itcl_BiInfoDelegatedMethodCmd(
     ItclClass *contextIclsPtr;
     ItclObject *contextIoPtr;
     ItclDelegatedFunction *idmPtr;
-    ItclHierIter hier;
+    int hierIdx;
     ItclClass *iclsPtr;
     char *cmdName;
     int i;
@@ -4972,7 +4931,8 @@ Itcl_BiInfoDelegatedMethodCmd(
     if (cmdName) {
 	cmdNamePtr = Tcl_NewStringObj(cmdName, -1);
 	if (contextIoPtr != NULL) {
-            hPtr = Tcl_FindHashEntry(&contextIoPtr->objectDelegatedFunctions,
+            hPtr = Tcl_FindHashEntry(
+                    ITCL_OBJECT_TABLE(contextIoPtr, objectDelegatedFunctions),
 	            (char *)cmdNamePtr);
 	} else {
             hPtr = Tcl_FindHashEntry(&contextIclsPtr->delegatedFunctions,
@@ -5084,8 +5044,8 @@ Itcl_BiInfoDelegatedMethodCmd(
          */
         resultPtr = Tcl_NewListObj(0, (Tcl_Obj**)NULL);
 	Tcl_IncrRefCount(resultPtr);
-        Itcl_InitHierIter(&hier, contextIclsPtr);
-        while ((iclsPtr=Itcl_AdvanceHierIter(&hier)) != NULL) {
+        for (hierIdx = 0; hierIdx < contextIclsPtr->numHierarchy; hierIdx++) {
+            iclsPtr = contextIclsPtr->hierarchy[hierIdx];
             hPtr = Tcl_FirstHashEntry(&iclsPtr->delegatedFunctions, &place);
             while (hPtr) {
                 idmPtr = (ItclDelegatedFunction *)Tcl_GetHashValue(hPtr);
@@ -5097,7 +5057,6 @@ Itcl_BiInfoDelegatedMethodCmd(
                 hPtr = Tcl_NextHashEntry(&place);
             }
         }
-        Itcl_DeleteHierIter(&hier);
 
         Tcl_SetObjResult(interp, resultPtr);
     }
@@ -5137,7 +5096,7 @@ Itcl_BiInfoDelegatedTypeMethodCmd(
     ItclClass *contextIclsPtr;
     ItclObject *contextIoPtr;
     ItclDelegatedFunction *idmPtr;
-    ItclHierIter hier;
+    int hierIdx;
     ItclClass *iclsPtr;
     char *cmdName;
     int i;
@@ -5202,7 +5161,8 @@ Itcl_BiInfoDelegatedTypeMethodCmd(
     if (cmdName) {
 	cmdNamePtr = Tcl_NewStringObj(cmdName, -1);
 	if (contextIoPtr != NULL) {
-            hPtr = Tcl_FindHashEntry(&contextIoPtr->objectDelegatedFunctions,
+            hPtr = Tcl_FindHashEntry(
+                    ITCL_OBJECT_TABLE(contextIoPtr, objectDelegatedFunctions),
 	            (char *)cmdNamePtr);
 	} else {
             hPtr = Tcl_FindHashEntry(&contextIclsPtr->delegatedFunctions,
@@ -5316,8 +5276,8 @@ Itcl_BiInfoDelegatedTypeMethodCmd(
          */
         resultPtr = Tcl_NewListObj(0, (Tcl_Obj**)NULL);
 	Tcl_IncrRefCount(resultPtr);
-        Itcl_InitHierIter(&hier, contextIclsPtr);
-        while ((iclsPtr=Itcl_AdvanceHierIter(&hier)) != NULL) {
+        for (hierIdx = 0; hierIdx < contextIclsPtr->numHierarchy; hierIdx++) {
+            iclsPtr = contextIclsPtr->hierarchy[hierIdx];
             hPtr = Tcl_FirstHashEntry(&iclsPtr->delegatedFunctions, &place);
             while (hPtr) {
                 idmPtr = (ItclDelegatedFunction *)Tcl_GetHashValue(hPtr);
@@ -5329,7 +5289,6 @@ Itcl_BiInfoDelegatedTypeMethodCmd(
                 hPtr = Tcl_NextHashEntry(&place);
             }
         }
-        Itcl_DeleteHierIter(&hier);
 
         Tcl_SetObjResult(interp, resultPtr);
     }
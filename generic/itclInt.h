@@ -64,6 +64,12 @@
 #define ITCL_INTERP_DATA "itcl_data"
 #define ITCL_TK_VERSION "8.6"
 
+/*
+ * Default time in microseconds one slice of deferred object deletions
+ * may take, see ItclRunDeferredDeletions.
+ */
+#define ITCL_DEFERRED_BUDGET 1000
+
 /*
  * Convenience macros for iterating through hash tables. FOREACH_HASH_DECLS
  * sets up the declarations needed for the main macro, FOREACH_HASH, which
@@ -124,6 +130,27 @@ typedef struct ItclArgList {
     Tcl_Obj *defaultValuePtr;   /* default value or NULL if none */
 } ItclArgList;
 
+/*
+ *  Pending update of one of the ::itcl::internal::dicts class
+ *  variables.  Class definitions only queue these; the variables are
+ *  brought up to date when a script reads one of them.
+ */
+#define ITCL_DICT_INFO_CLASS              1
+#define ITCL_DICT_INFO_OPTION             2
+#define ITCL_DICT_INFO_DELEGATED_OPTION   3
+#define ITCL_DICT_INFO_COMPONENT          4
+#define ITCL_DICT_INFO_VARIABLE           5
+#define ITCL_DICT_INFO_FUNCTION           6
+#define ITCL_DICT_INFO_DELEGATED_FUNCTION 7
+
+typedef struct ItclDictInfo {
+    int kind;                       /* one of ITCL_DICT_INFO_* */
+    struct ItclClass *iclsPtr;      /* class the entry belongs to, or NULL
+                                     * if the entry was dropped */
+    ClientData memberPtr;           /* member to describe, or the class
+                                     * itself for ITCL_DICT_INFO_CLASS */
+} ItclDictInfo;
+
 /*
  *  Common info for managing all known objects.
  *  Each interpreter has one of these data structures stored as
@@ -136,6 +163,7 @@ struct ItclMemberFunc;
 struct EnsembleInfo;
 struct ItclDelegatedOption;
 struct ItclDelegatedFunction;
+struct ItclFrameContext;
 
 typedef struct ItclObjectInfo {
     Tcl_Interp *interp;             /* interpreter that manages this info */
@@ -150,7 +178,7 @@ typedef struct ItclObjectInfo {
     Tcl_HashTable procMethods;      /* maps from procPtr to mFunc */
     Tcl_HashTable instances;        /* maps from instanceNumber to ioPtr */
     Tcl_HashTable unused8;          /* maps from ioPtr to instanceNumber */
-    Tcl_HashTable frameContext;     /* maps frame to context stack */
+    Tcl_HashTable unused9;          /* Removed: was frame to context map */
     Tcl_HashTable classTypes;       /* maps from class type i.e. "widget"
                                      * to define value i.e. ITCL_WIDGET */
     int protection;                 /* protection level currently in effect */
@@ -206,8 +234,62 @@ typedef struct ItclObjectInfo {
     Tcl_Obj *typeDestructorArgumentPtr;
     struct ItclObject *lastIoPtr;   /* last object constructed */
     Tcl_Command infoCmd;
+    struct ItclFrameContext *frameContexts;
+                                    /* shadow of the call stack: one entry
+                                     * for each active Itcl call, innermost
+                                     * call last */
+    int numFrameContexts;           /* number of entries in use */
+    int maxFrameContexts;           /* number of entries allocated */
+    int classEpoch;                 /* bumped whenever a namespace becomes
+                                     * or stops being a class namespace */
+    Tcl_Obj *myPtr;                 /* shared "my" word used to dispatch
+                                     * method calls to TclOO */
+    Tcl_HashTable builtinAliases;   /* "@itcl-builtin-*" command names to
+                                     * ItclBuiltinAlias, see
+                                     * ItclFindBuiltinAlias */
+    int builtinAliasesInitted;      /* set to 1 while builtinAliases is
+                                     * valid */
+    int lazyVars;                   /* set from ITCL_LAZY_VARS: objects of
+                                     * all itcl::class classes without a
+                                     * varstorage declaration create their
+                                     * variables on first access */
+    int objectsDictStale;           /* set when objects were added or
+                                     * removed since
+                                     * ::itcl::internal::dicts::objects
+                                     * was last built */
+    ItclDictInfo *dictInfos;        /* queued class dict updates, in
+                                     * definition order */
+    int numDictInfos;               /* number of entries in use */
+    int maxDictInfos;               /* number of entries allocated */
+    int numDeadDictInfos;           /* entries in use that were dropped */
+    int dictInfosFlushed;           /* set once queued entries have been
+                                     * written to the dict variables */
+    Itcl_List deferredObjects;      /* objects whose deletion has been
+                                     * deferred and their former names,
+                                     * see ItclDeferObjectDeletion */
+    Tcl_TimerToken deferredTimer;   /* pending slice of deferred
+                                     * deletions, or NULL */
+    int deferredBudget;             /* time in microseconds each slice
+                                     * of deferred deletions may take */
+    int deferredCounter;            /* used to name deferred objects */
+    Tcl_HashTable emptyObjectTable; /* always empty, read in place of the
+                                     * tables of objects without
+                                     * ItclObjectTables */
+    int classIdCounter;             /* used to number classes, see
+                                     * ItclClass.classId */
 } ItclObjectInfo;
 
+/*
+ *  Command an "@itcl-builtin-*" name within a method body stands for.
+ *  The command token is looked up once and dropped by a command trace
+ *  when the command is renamed or deleted.
+ */
+typedef struct ItclBuiltinAlias {
+    const char *commandName;        /* fully qualified command name */
+    Tcl_Command cmd;                /* cached token, or NULL */
+    ItclObjectInfo *infoPtr;        /* info for all known objects */
+} ItclBuiltinAlias;
+
 typedef struct EnsembleInfo {
     Tcl_HashTable ensembles;        /* list of all known ensembles */
     Tcl_HashTable subEnsembles;     /* list of all known subensembles */
@@ -239,6 +321,9 @@ typedef struct EnsembleInfo {
 #define ITCL_CLASS_NO_VARNS_DELETE        0x80000
 #define ITCL_CLASS_SHOULD_VARNS_DELETE   0x100000
 #define ITCL_CLASS_DESTRUCTOR_CALLED     0x400000
+#define ITCL_CLASS_COMPACT_VARS          0x800000
+#define ITCL_CLASS_LAZY_VARS            0x1000000
+#define ITCL_CLASS_NAMESPACE_VARS       0x2000000
 
 
 typedef struct ItclClass {
@@ -254,10 +339,6 @@ typedef struct ItclClass {
 				   * and other stuff like stacks */
     Itcl_List bases;              /* list of base classes */
     Itcl_List derived;            /* list of all derived classes */
-    Tcl_HashTable heritage;       /* table of all base classes.  Look up
-                                   * by pointer to class definition.  This
-                                   * provides fast lookup for inheritance
-                                   * tests. */
     Tcl_Obj *initCode;            /* initialization code for new objs */
     Tcl_HashTable variables;      /* definitions for all data members
                                      in this class.  Look up simple string
@@ -313,8 +394,155 @@ typedef struct ItclClass {
     Tcl_Obj *typeConstructorPtr;  /* initialization for types */
     int destructorHasBeenCalled;  /* prevent multiple invocations of destrcutor */
     int refCount;
+    int numFunctionSlots;         /* number of call context slots handed
+                                   * out to member functions of this
+                                   * class, see ItclMemberFunc.slot */
+    struct ItclSlotBase *slotBases;
+                                  /* first call context slot of each
+                                   * class in the hierarchy, most
+                                   * specific first */
+    int numSlotBases;             /* number of entries in slotBases */
+    int numMethodSlots;           /* number of call context slots needed
+                                   * by objects of this class */
+    int generation;               /* bumped whenever method name resolution
+                                   * for this class may have changed */
+    Tcl_HashTable *methodNameCache;
+                                  /* mapped method names, see
+                                   * ItclMapMethodNameProc, or NULL */
+    int numMethodNameCache;       /* number of entries in methodNameCache */
+    int numVariableSlots;         /* number of object variable slots handed
+                                   * out to data members of this class,
+                                   * see ItclVariable.slot */
+    int numObjectVarSlots;        /* number of object variable slots needed
+                                   * by objects of this class */
+    struct ItclObject *firstInstancePtr;
+                                  /* objects whose most-specific class
+                                   * this is, in creation order, linked
+                                   * by ItclObject.nextInstancePtr */
+    struct ItclObject *lastInstancePtr;
+    int numInstances;             /* number of objects in that list */
+    int numDictInfos;             /* entries of this class still queued
+                                   * in ItclObjectInfo.dictInfos */
+    int firstDictInfo;            /* no entry of this class is queued
+                                   * before this index */
+    struct ItclInstancePlan *planPtr;
+                                  /* what creating an object of this
+                                   * class involves, see
+                                   * ItclGetInstancePlan, or NULL */
+    int maxInstances;             /* high-water mark of numInstances */
+    struct ItclClass **hierarchy; /* this class and all of its base
+                                   * classes in the order an ItclHierIter
+                                   * visits them, see ItclBuildHierarchy */
+    int numHierarchy;             /* number of entries in hierarchy */
+    int classId;                  /* number of this class, larger than
+                                   * the numbers of all its base classes */
+    int *heritageIds;             /* classIds of the classes in hierarchy,
+                                   * sorted and without duplicates, see
+                                   * ITCL_CLASS_ISA */
+    int numHeritageIds;           /* number of entries in heritageIds */
+    Tcl_HashTable publicOptions;  /* every name of a public variable in
+                                   * resolveVars with a leading "-",
+                                   * as used by configure and cget.
+                                   * Look up "-x" and get back the
+                                   * ItclVarLookup* of resolveVars */
+    struct ItclDelegatedFunction *delegateAllPtr;
+                                  /* entry of "delegate method *" in
+                                   * delegatedFunctions, or NULL */
 } ItclClass;
 
+/*
+ *  Tests whether basePtr is the class iclsPtr itself or one of its base
+ *  classes.  Base classes exist before their derived classes are
+ *  created, so their classIds are smaller.
+ */
+#define ITCL_CLASS_ISA(iclsPtr, basePtr) \
+    (((iclsPtr) == (basePtr)) \
+	    || (((basePtr)->classId < (iclsPtr)->classId) \
+	    && ItclHeritageHasId((iclsPtr), (basePtr)->classId)))
+
+/*
+ *  Location of the call context slots and of the object variable slots
+ *  of one class within an object of a derived (or the same) class.
+ */
+typedef struct ItclSlotBase {
+    ItclClass *iclsPtr;           /* class in the hierarchy */
+    int offset;                   /* index of its first slot */
+    int varOffset;                /* index of its first variable slot */
+    int numVars;                  /* number of variable slots set aside
+                                   * for it */
+} ItclSlotBase;
+
+/*
+ *  One data member in the instantiation plan of a class, with the
+ *  lookups ItclCreateObject() needs for it done in advance.
+ */
+typedef struct ItclPlanVar {
+    struct ItclVariable *ivPtr;   /* the data member */
+    Tcl_VarTraceProc *traceProc;  /* trace of a built-in variable such as
+                                   * "this", or NULL */
+    Tcl_Var commonVarPtr;         /* the variable of a common, or NULL */
+    struct ItclComponent *icPtr;  /* the component of a component
+                                   * variable, or NULL */
+    int isResolved;               /* set if the name is in the resolveVars
+                                   * table of the member's class */
+} ItclPlanVar;
+
+/*
+ *  Instantiation plan of a class: the data members to create for a new
+ *  object, grouped by class in the order of ItclClass.slotBases, and
+ *  which of those classes have constructors or destructors.  Thrown
+ *  away by ItclInvalidateInstancePlans when a class in the hierarchy
+ *  gets new members.
+ */
+typedef struct ItclInstancePlan {
+    int numBases;                 /* number of classes in the hierarchy */
+    int *firstVar;                /* index into vars of the first member
+                                   * of each class, numBases+1 entries */
+    unsigned char *hasConstructor;
+                                  /* bit i is set if slot base i has a
+                                   * constructor */
+    unsigned char *hasDestructor; /* bit i is set if slot base i has a
+                                   * destructor */
+    int anyConstructor;           /* set if any class in the hierarchy has
+                                   * a constructor or init code */
+    int numVars;                  /* number of entries in vars */
+    ItclPlanVar *vars;
+    struct ItclVariable **nameVars;
+                                  /* the "this" and "self" variables in
+                                   * vars, which hold the object name */
+    int numNameVars;              /* number of entries in nameVars */
+} ItclInstancePlan;
+
+/*
+ *  Bitmaps with one bit per entry of ItclClass.slotBases, such as
+ *  ItclObject.constructed.
+ */
+#define ITCL_BASE_BITS_SIZE(n)     (((n) + 7) >> 3)
+#define ITCL_BASE_BIT_SET(bits, i) ((bits)[(i) >> 3] |= (1 << ((i) & 7)))
+#define ITCL_BASE_BIT_ISSET(bits, i) ((bits)[(i) >> 3] & (1 << ((i) & 7)))
+#define ITCL_INLINE_BASE_BITS      64
+
+/*
+ *  Result of mapping an unqualified method name for objects of a class,
+ *  valid as long as the generations and the calling namespace match.
+ *  The entries for one name are chained in the class's methodNameCache
+ *  table, which is flushed when it holds more than
+ *  ITCL_METHOD_NAME_CACHE_SIZE of them.
+ */
+#define ITCL_METHOD_NAME_CACHE_SIZE 256
+
+typedef struct ItclMethodNameCache {
+    struct ItclMethodNameCache *nextPtr;
+                                  /* next entry for the same name */
+    long nsId;                    /* id of the namespace calling it */
+    int isMethodFrame;            /* called from a method call frame */
+    int generation;               /* generation of the object's class */
+    int classEpoch;               /* ItclObjectInfo.classEpoch */
+    ItclClass *lookupClsPtr;      /* class whose resolveCmds was searched */
+    int lookupGeneration;         /* generation of lookupClsPtr */
+    int found;                    /* 1 if the name was in resolveCmds */
+} ItclMethodNameCache;
+
 typedef struct ItclHierIter {
     ItclClass *current;           /* current position in hierarchy */
     Itcl_Stack stack;             /* stack used for traversal */
@@ -328,21 +556,30 @@ typedef struct ItclHierIter {
 #define ITCL_TCLOO_OBJECT_IS_DELETED     0x20
 #define ITCL_OBJECT_DESTRUCT_ERROR       0x40
 #define ITCL_OBJECT_SHOULD_VARNS_DELETE  0x80
+#define ITCL_OBJECT_COMPACT_VARS         0x100
+#define ITCL_OBJECT_VARNS_LINKED         0x200
+#define ITCL_OBJECT_LAZY_VARS            0x400
+#define ITCL_OBJECT_IS_INSTANCE          0x800
+#define ITCL_OBJECT_IN_OBJECTS_DICT      0x1000
+#define ITCL_OBJECT_IS_DEFERRED          0x4000
 #define ITCL_OBJECT_ROOT_METHOD          0x8000
 
 /*
- *  Representation for each [incr Tcl] object.
+ *  Flags describing how an object is stored and where it is listed,
+ *  as opposed to how far its deletion got.  They must survive a failed
+ *  destructor, see ItclProcErrorProc.
  */
-typedef struct ItclObject {
-    ItclClass *iclsPtr;          /* most-specific class */
-    Tcl_Command accessCmd;       /* object access command */
+#define ITCL_OBJECT_STORAGE_FLAGS \
+    (ITCL_OBJECT_COMPACT_VARS|ITCL_OBJECT_VARNS_LINKED \
+    |ITCL_OBJECT_LAZY_VARS|ITCL_OBJECT_IS_INSTANCE \
+    |ITCL_OBJECT_IN_OBJECTS_DICT|ITCL_OBJECT_IS_DEFERRED)
 
-    Tcl_HashTable* constructed;  /* temp storage used during construction */
-    Tcl_HashTable* destructed;   /* temp storage used during destruction */
-    Tcl_HashTable objectVariables;
-                                 /* used for storing Tcl_Var entries for
-				  * variable resolving, key is ivPtr of
-				  * variable, value is varPtr */
+/*
+ *  Per object tables only used by objects of ::itcl::type,
+ *  ::itcl::widget, ::itcl::extendedclass etc.  Kept out of line so
+ *  plain class objects do not carry five empty hash tables.
+ */
+typedef struct ItclObjectTables {
     Tcl_HashTable objectOptions; /* definitions for all option members
                                      in this object. Look up option namePtr
                                      names and get back ItclOption* ptrs */
@@ -364,7 +601,34 @@ typedef struct ItclObject {
 				     members in this object. Look up function
 				     namePtr names and get back
 				     ItclMemberFunc * ptrs */
-    Tcl_HashTable contextCache;   /* cache for function contexts */
+} ItclObjectTables;
+
+/*
+ *  Access to the tables of an ItclObject: reads fall back to an empty
+ *  table shared by all objects, writes allocate the tables on demand.
+ */
+#define ITCL_OBJECT_TABLE(ioPtr, name) \
+    (((ioPtr)->tablesPtr != NULL) ? &(ioPtr)->tablesPtr->name \
+	    : &(ioPtr)->infoPtr->emptyObjectTable)
+#define ITCL_OBJECT_TABLE_FOR_WRITE(ioPtr, name) \
+    (&ItclGetObjectTables(ioPtr)->name)
+
+/*
+ *  Representation for each [incr Tcl] object.
+ */
+typedef struct ItclObject {
+    ItclClass *iclsPtr;          /* most-specific class */
+    Tcl_Command accessCmd;       /* object access command */
+
+    unsigned char *constructed;  /* during construction: bitmap of the
+                                  * classes whose constructor has run,
+                                  * indexed like iclsPtr->slotBases */
+    unsigned char *destructed;   /* the same for destructors during
+                                  * destruction */
+    struct ItclObjectTables *tablesPtr;
+                                  /* option, component and delegation
+                                   * tables, NULL until the first entry
+                                   * is added, see ITCL_OBJECT_TABLE */
     Tcl_Obj *namePtr;
     Tcl_Obj *origNamePtr;         /* the original name before any rename */
     Tcl_Obj *createNamePtr;       /* the temp name before any rename
@@ -386,6 +650,29 @@ typedef struct ItclObject {
                                    * setting components in DelegationInstall */
     int hadConstructorError;      /* needed for multiple calls of CallItclObjectCmd */
     int refCount;
+    struct ItclCallContext **callContexts;
+                                  /* reusable method call contexts indexed
+                                   * by method slot, NULL until the first
+                                   * method call */
+    int numCallContexts;          /* number of entries in callContexts */
+    Tcl_Var *objectVars;          /* Tcl_Var of each data member used for
+                                   * variable resolving, indexed by
+                                   * variable slot, see ItclGetObjectVar */
+    int numObjectVars;            /* number of entries in objectVars */
+    struct TclVarHashTable *varTablePtr;
+                                  /* storage of the instance variables if
+                                   * ITCL_OBJECT_COMPACT_VARS is set,
+                                   * instead of the variable namespaces */
+    struct ItclObject *prevInstancePtr;
+    struct ItclObject *nextInstancePtr;
+                                  /* neighbours in the instance list of
+                                   * iclsPtr, see ItclAddInstance */
+    Itcl_ListElem *deferredElem;  /* entry in infoPtr->deferredObjects
+                                   * while the deletion is deferred */
+    unsigned char constructedSpace[ITCL_BASE_BITS_SIZE(ITCL_INLINE_BASE_BITS)];
+    unsigned char destructedSpace[ITCL_BASE_BITS_SIZE(ITCL_INLINE_BASE_BITS)];
+                                  /* storage for constructed/destructed
+                                   * unless the hierarchy is larger */
 } ItclObject;
 
 #define ITCL_IGNORE_ERRS  0x002  /* useful for construction/destruction */
@@ -448,6 +735,22 @@ typedef struct ItclMemberCode {
 #define ITCL_TYPE_METHOD       0x1000 /* non-zero => typemethod */
 #define ITCL_METHOD            0x2000 /* non-zero => method */
 
+/*
+ *  Flag bits for ItclMember: functions of ::itcl::type and
+ *  ::itcl::widgetadaptor classes that ItclObjectCmd hands directly to
+ *  their builtin implementation, set from the function name.
+ */
+#define ITCL_BI_MYTYPEMETHOD     0x004000
+#define ITCL_BI_MYMETHOD         0x008000
+#define ITCL_BI_MYPROC           0x010000
+#define ITCL_BI_MYTYPEVAR        0x020000
+#define ITCL_BI_MYVAR            0x040000
+#define ITCL_BI_ITCL_HULL        0x080000
+#define ITCL_BI_CALLINSTANCE     0x100000
+#define ITCL_BI_GETINSTANCEVAR   0x200000
+#define ITCL_BI_INSTALLCOMPONENT 0x400000
+#define ITCL_BI_DISPATCH         0x7fc000 /* any of the above */
+
 /*
  *  Flag bits for ItclMember: variables
  */
@@ -518,6 +821,9 @@ typedef struct ItclMemberFunc {
     ItclDelegatedFunction *idmPtr;
                                 /* if the function is delegated != NULL */
     int refCount;
+    int slot;                   /* index of the call context slot within
+                                 * the slots of the class, the object's
+                                 * slot is found via ItclClass.slotBases */
 } ItclMemberFunc;
 
 /*
@@ -536,6 +842,12 @@ typedef struct ItclVariable {
     int initted;                /* is set when first time initted, to check
                                  * for example itcl_hull var, which can be only
 				 * initialized once */
+    int slot;                   /* object variable slot of this member
+                                 * within its class, see
+                                 * ItclClass.slotBases */
+    int arrayInitc;             /* number of elements in arrayInitv */
+    Tcl_Obj **arrayInitv;       /* arrayInitPtr split into alternating
+                                 * element names and values */
 } ItclVariable;
 
 
@@ -645,8 +957,30 @@ typedef struct ItclCallContext {
     ItclObject *ioPtr;
     ItclMemberFunc *imPtr;
     int refCount;
+    int slot;                     /* index in the object's callContexts
+                                   * or -1 if not owned by the object */
 } ItclCallContext;
 
+/*
+ *  Call context bound to a call frame.  The entries are kept in a
+ *  per-interp array in call order, so the context of the current frame
+ *  is almost always found at the top without hashing.
+ */
+typedef struct ItclFrameContext {
+    Tcl_CallFrame *framePtr;      /* frame the context is active in */
+    int level;                    /* level of framePtr */
+    int unordered;                /* 1 if this or an outer entry is on a
+                                   * lower level than its predecessor */
+    Tcl_ObjectContext contextPtr; /* TclOO context of the method call or
+                                   * NULL */
+    ItclCallContext *callContextPtr;
+                                  /* context of the call or NULL if
+                                   * rootContext is used */
+    ItclCallContext rootContext;  /* storage for contexts that are not
+                                   * bound to a method (object info,
+                                   * Itcl_SetContext) */
+} ItclFrameContext;
+
 /*
  * The macro below is used to modify a "char" value (e.g. by casting
  * it to an unsigned character) so that it can be used safely with
@@ -706,24 +1040,78 @@ MODULE_SCOPE int ItclCheckCallMethod(ClientData clientData, Tcl_Interp *interp,
         Tcl_ObjectContext contextPtr, Tcl_CallFrame *framePtr, int *isFinished);
 MODULE_SCOPE int ItclAfterCallMethod(ClientData clientData, Tcl_Interp *interp,
         Tcl_ObjectContext contextPtr, Tcl_Namespace *nsPtr, int result);
+MODULE_SCOPE ItclCallContext *ItclPushFrameContext(ItclObjectInfo *infoPtr,
+        Tcl_CallFrame *framePtr, Tcl_ObjectContext contextPtr,
+        ItclCallContext *callContextPtr);
+MODULE_SCOPE ItclCallContext *ItclPeekFrameContext(ItclObjectInfo *infoPtr,
+        Tcl_CallFrame *framePtr);
+MODULE_SCOPE ItclCallContext *ItclPopFrameContext(ItclObjectInfo *infoPtr,
+        Tcl_CallFrame *framePtr, Tcl_ObjectContext contextPtr);
 MODULE_SCOPE void ItclReportObjectUsage(Tcl_Interp *interp,
         ItclObject *contextIoPtr, Tcl_Namespace *callerNsPtr,
 	Tcl_Namespace *contextNsPtr);
 MODULE_SCOPE int ItclMapMethodNameProc(Tcl_Interp *interp, Tcl_Object oPtr,
         Tcl_Class *startClsPtr, Tcl_Obj *methodObj);
+MODULE_SCOPE void ItclFreeMethodNameCache(ItclClass *iclsPtr);
+MODULE_SCOPE Tcl_Var ItclGetObjectVar(ItclObject *ioPtr,
+        ItclVariable *ivPtr);
+MODULE_SCOPE void ItclSetObjectVar(ItclObject *ioPtr, ItclVariable *ivPtr,
+        Tcl_Var varPtr);
+MODULE_SCOPE Tcl_Obj *ItclGetObjectVarValue(Tcl_Interp *interp,
+        ItclObject *ioPtr, ItclVariable *ivPtr, const char *name2, int flags);
+MODULE_SCOPE Tcl_Obj *ItclSetObjectVarValue(Tcl_Interp *interp,
+        ItclObject *ioPtr, ItclVariable *ivPtr, const char *name2,
+        Tcl_Obj *valuePtr, int flags);
+MODULE_SCOPE int ItclLinkObjectVarNamespaces(Tcl_Interp *interp,
+        ItclObject *ioPtr);
 MODULE_SCOPE int ItclCreateArgList(Tcl_Interp *interp, const char *str,
         int *argcPtr, int *maxArgcPtr, Tcl_Obj **usagePtr,
 	ItclArgList **arglistPtrPtr, ItclMemberFunc *imPtr,
 	const char *commandName);
 MODULE_SCOPE int ItclObjectCmd(ClientData clientData, Tcl_Interp *interp,
         Tcl_Object oPtr, Tcl_Class clsPtr, int objc, Tcl_Obj *const *objv);
+MODULE_SCOPE int ItclSetVariableArrayInit(Tcl_Interp *interp,
+        ItclVariable *ivPtr, const char *arrayInitStr);
 MODULE_SCOPE int ItclCreateObject (Tcl_Interp *interp, const char* name,
         ItclClass *iclsPtr, int objc, Tcl_Obj *const objv[]);
 MODULE_SCOPE void ItclDeleteObjectVariablesNamespace(Tcl_Interp *interp,
         ItclObject *ioPtr);
+MODULE_SCOPE void ItclAddInstance(ItclObject *ioPtr);
+MODULE_SCOPE void ItclRemoveInstance(ItclObject *ioPtr);
+MODULE_SCOPE ItclInstancePlan *ItclGetInstancePlan(ItclClass *iclsPtr);
+MODULE_SCOPE void ItclFreeInstancePlan(ItclClass *iclsPtr);
+MODULE_SCOPE void ItclInvalidateInstancePlans(ItclClass *iclsPtr);
+MODULE_SCOPE int ItclBaseIndex(ItclClass *iclsPtr, ItclClass *baseClsPtr);
+MODULE_SCOPE unsigned char *ItclNewBaseBits(ItclObject *ioPtr,
+        unsigned char *space);
+MODULE_SCOPE void ItclFreeBaseBits(unsigned char *bits, unsigned char *space);
+MODULE_SCOPE ItclClass *ItclBuildHierarchy(ItclClass *iclsPtr);
+MODULE_SCOPE int ItclHeritageHasId(ItclClass *iclsPtr, int classId);
+MODULE_SCOPE ItclObjectTables *ItclGetObjectTables(struct ItclObject *ioPtr);
+MODULE_SCOPE int ItclDeferObjectDeletion(Tcl_Interp *interp,
+        ItclObject *ioPtr);
+MODULE_SCOPE int ItclRunDeferredDeletions(ItclObjectInfo *infoPtr,
+        int budget);
+MODULE_SCOPE void ItclCancelDeferredDeletions(ItclObjectInfo *infoPtr);
+MODULE_SCOPE int Itcl_NewCmd(ClientData clientData, Tcl_Interp *interp,
+        int objc, Tcl_Obj *const objv[]);
+MODULE_SCOPE int Itcl_MemoryClassCmd(ClientData clientData,
+        Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
+MODULE_SCOPE int Itcl_MemoryObjectCmd(ClientData clientData,
+        Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
+MODULE_SCOPE int Itcl_DeferredBudgetCmd(ClientData clientData,
+        Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
+MODULE_SCOPE int Itcl_DeferredPendingCmd(ClientData clientData,
+        Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
+MODULE_SCOPE int Itcl_DeferredFlushCmd(ClientData clientData,
+        Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
 MODULE_SCOPE void ItclDeleteClassVariablesNamespace(Tcl_Interp *interp,
         ItclClass *iclsPtr);
 MODULE_SCOPE int ItclInfoInit(Tcl_Interp *interp, ItclObjectInfo *infoPtr);
+MODULE_SCOPE Tcl_Command ItclFindBuiltinAlias(Tcl_Interp *interp,
+        ItclObjectInfo *infoPtr, const char *cmdName);
+MODULE_SCOPE void ItclFinishBuiltinAliases(Tcl_Interp *interp,
+        ItclObjectInfo *infoPtr);
 
 struct Tcl_ResolvedVarInfo;
 MODULE_SCOPE int Itcl_ClassCmdResolver(Tcl_Interp *interp, const char* name,
@@ -774,6 +1162,8 @@ MODULE_SCOPE int Itcl_HandleDelegateMethodCmd(Tcl_Interp *interp,
 MODULE_SCOPE int DelegateFunction(Tcl_Interp *interp, ItclObject *ioPtr,
         ItclClass *iclsPtr, Tcl_Obj *componentNamePtr,
         ItclDelegatedFunction *idmPtr);
+MODULE_SCOPE int ItclInstallDelegatedMethod(Tcl_Interp *interp,
+        ItclClass *iclsPtr, ItclDelegatedFunction *idmPtr);
 MODULE_SCOPE int ItclInitObjectMethodVariables(Tcl_Interp *interp,
         ItclObject *ioPtr, ItclClass *iclsPtr, const char *name);
 MODULE_SCOPE int InitTclOOFunctionPointers(Tcl_Interp *interp);
@@ -805,6 +1195,8 @@ MODULE_SCOPE int ItclDeleteClassesDictInfo(Tcl_Interp *interp,
 MODULE_SCOPE int ItclAddObjectsDictInfo(Tcl_Interp *interp, ItclObject *ioPtr);
 MODULE_SCOPE int ItclDeleteObjectsDictInfo(Tcl_Interp *interp,
         ItclObject *ioPtr);
+MODULE_SCOPE char *ItclObjectsDictTrace(ClientData clientData,
+        Tcl_Interp *interp, const char *name1, const char *name2, int flags);
 MODULE_SCOPE int ItclAddOptionDictInfo(Tcl_Interp *interp, ItclClass *iclsPtr,
 	ItclOption *ioptPtr);
 MODULE_SCOPE int ItclAddDelegatedOptionDictInfo(Tcl_Interp *interp,
@@ -817,6 +1209,12 @@ MODULE_SCOPE int ItclAddClassFunctionDictInfo(Tcl_Interp *interp,
         ItclClass *iclsPtr, ItclMemberFunc *imPtr);
 MODULE_SCOPE int ItclAddClassDelegatedFunctionDictInfo(Tcl_Interp *interp,
         ItclClass *iclsPtr, ItclDelegatedFunction *idmPtr);
+MODULE_SCOPE const char *const ItclDictInfoVarNames[];
+MODULE_SCOPE void ItclForgetDictInfo(ItclClass *iclsPtr, ClientData memberPtr);
+MODULE_SCOPE char *ItclClassDictsTrace(ClientData clientData,
+        Tcl_Interp *interp, const char *name1, const char *name2, int flags);
+MODULE_SCOPE Tcl_Obj *ItclMemberCodeUsage(ItclMemberCode *mcode);
+MODULE_SCOPE Tcl_Obj *ItclMemberFuncUsage(ItclMemberFunc *imPtr);
 MODULE_SCOPE int ItclClassCreateObject(ClientData clientData, Tcl_Interp *interp,
         int objc, Tcl_Obj *const objv[]);
 MODULE_SCOPE Tcl_ObjCmdProc Itcl_BiMyProcCmd;
@@ -842,6 +1240,7 @@ typedef int (ItclRootMethodProc)(ItclObject *ioPtr, Tcl_Interp *interp,
 	int objc, Tcl_Obj *const objv[]);
 
 MODULE_SCOPE const Tcl_MethodType itclRootMethodType;
+MODULE_SCOPE const Tcl_ObjectMetadataType itclObjectMetadataType;
 MODULE_SCOPE ItclRootMethodProc ItclUnknownGuts;
 MODULE_SCOPE ItclRootMethodProc ItclConstructGuts;
 MODULE_SCOPE ItclRootMethodProc ItclInfoGuts;
@@ -8,7 +8,7 @@
 /* !BEGIN!: Do not edit below this line. */
 
 #define ITCLINT_STUBS_EPOCH 0
-#define ITCLINT_STUBS_REVISION 150
+#define ITCLINT_STUBS_REVISION 154
 
 #ifdef __cplusplus
 extern "C" {
@@ -521,6 +521,19 @@ ITCLAPI void		Itcl_UnsetContext(Tcl_Interp *interp);
 ITCLAPI const char *	ItclGetInstanceVar(Tcl_Interp *interp,
 				const char *name, const char *name2,
 				ItclObject *ioPtr, ItclClass *iclsPtr);
+/* 185 */
+ITCLAPI int		Itcl_CreateObjects(Tcl_Interp *interp,
+				ItclClass *iclsPtr, int count, int objc,
+				Tcl_Obj *const objv[], Tcl_Obj **namesPtrPtr);
+/* Slot 186 is reserved */
+/* 187 */
+ITCLAPI Tcl_Obj *	ItclGetInstanceVarObj(Tcl_Interp *interp,
+				const char *name, const char *name2,
+				ItclObject *ioPtr, ItclClass *iclsPtr);
+/* 188 */
+ITCLAPI Tcl_Obj *	Itcl_GetInstanceVarObj(Tcl_Interp *interp,
+				const char *name, ItclObject *contextIoPtr,
+				ItclClass *contextIclsPtr);
 
 typedef struct ItclIntStubs {
     int magic;
@@ -713,6 +726,10 @@ typedef struct ItclIntStubs {
     void (*itcl_SetContext) (Tcl_Interp *interp, ItclObject *ioPtr); /* 182 */
     void (*itcl_UnsetContext) (Tcl_Interp *interp); /* 183 */
     const char * (*itclGetInstanceVar) (Tcl_Interp *interp, const char *name, const char *name2, ItclObject *ioPtr, ItclClass *iclsPtr); /* 184 */
+    int (*itcl_CreateObjects) (Tcl_Interp *interp, ItclClass *iclsPtr, int count, int objc, Tcl_Obj *const objv[], Tcl_Obj **namesPtrPtr); /* 185 */
+    void (*reserved186)(void);
+    Tcl_Obj * (*itclGetInstanceVarObj) (Tcl_Interp *interp, const char *name, const char *name2, ItclObject *ioPtr, ItclClass *iclsPtr); /* 187 */
+    Tcl_Obj * (*itcl_GetInstanceVarObj) (Tcl_Interp *interp, const char *name, ItclObject *contextIoPtr, ItclClass *contextIclsPtr); /* 188 */
 } ItclIntStubs;
 
 extern const ItclIntStubs *itclIntStubsPtr;
@@ -1038,6 +1055,13 @@ extern const ItclIntStubs *itclIntStubsPtr;
 	(itclIntStubsPtr->itcl_UnsetContext) /* 183 */
 #define ItclGetInstanceVar \
 	(itclIntStubsPtr->itclGetInstanceVar) /* 184 */
+#define Itcl_CreateObjects \
+	(itclIntStubsPtr->itcl_CreateObjects) /* 185 */
+/* Slot 186 is reserved */
+#define ItclGetInstanceVarObj \
+	(itclIntStubsPtr->itclGetInstanceVarObj) /* 187 */
+#define Itcl_GetInstanceVarObj \
+	(itclIntStubsPtr->itcl_GetInstanceVarObj) /* 188 */
 
 #endif /* defined(USE_ITCL_STUBS) */
 
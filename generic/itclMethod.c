@@ -503,6 +503,8 @@ ItclCreateMemberFunc(
             (char*)NULL);
         return TCL_ERROR;
     }
+    /* a new constructor or destructor changes the instantiation plans */
+    ItclInvalidateInstancePlans(iclsPtr);
 
     /*
      *  Try to create the implementation for this command member.
@@ -534,6 +536,7 @@ ItclCreateMemberFunc(
         Tcl_IncrRefCount(imPtr->origArgsPtr);
     }
     imPtr->codePtr    = mcode;
+    imPtr->slot       = iclsPtr->numFunctionSlots++;
     ItclPreserveMemberCode(mcode);
 
     if (imPtr->protection == ITCL_DEFAULT_PROTECT) {
@@ -547,9 +550,7 @@ ItclCreateMemberFunc(
     }
     if (mcode->argListPtr) {
         ItclCreateArgList(interp, arglist, &imPtr->argcount,
-	        &imPtr->maxargcount, &imPtr->usagePtr,
-		&imPtr->argListPtr, imPtr, NULL);
-        Tcl_IncrRefCount(imPtr->usagePtr);
+	        &imPtr->maxargcount, NULL, &imPtr->argListPtr, imPtr, NULL);
     }
 
     name = Tcl_GetString(namePtr);
@@ -653,6 +654,27 @@ ItclCreateMemberFunc(
             imPtr->flags |= ITCL_COMMON;
 	}
     }
+    if (*name == 'm') {
+	if (strcmp(name, "mytypemethod") == 0) {
+	    imPtr->flags |= ITCL_BI_MYTYPEMETHOD;
+	} else if (strcmp(name, "mymethod") == 0) {
+	    imPtr->flags |= ITCL_BI_MYMETHOD;
+	} else if (strcmp(name, "myproc") == 0) {
+	    imPtr->flags |= ITCL_BI_MYPROC;
+	} else if (strcmp(name, "mytypevar") == 0) {
+	    imPtr->flags |= ITCL_BI_MYTYPEVAR;
+	} else if (strcmp(name, "myvar") == 0) {
+	    imPtr->flags |= ITCL_BI_MYVAR;
+	}
+    } else if (strcmp(name, "itcl_hull") == 0) {
+	imPtr->flags |= ITCL_BI_ITCL_HULL;
+    } else if (strcmp(name, "callinstance") == 0) {
+	imPtr->flags |= ITCL_BI_CALLINSTANCE;
+    } else if (strcmp(name, "getinstancevar") == 0) {
+	imPtr->flags |= ITCL_BI_GETINSTANCEVAR;
+    } else if (strcmp(name, "installcomponent") == 0) {
+	imPtr->flags |= ITCL_BI_INSTALLCOMPONENT;
+    }
     if (strcmp(name, "constructor") == 0) {
 	/*
 	 * REVISE mcode->bodyPtr here!
@@ -796,6 +818,7 @@ Itcl_ChangeMemberFunc(
     ItclPreserveMemberCode(mcode);
     ItclReleaseMemberCode(imPtr->codePtr);
     imPtr->codePtr = mcode;
+    imPtr->iclsPtr->generation++;
     if (mcode->flags & ITCL_IMPLEMENT_TCL) {
 	ClientData pmPtr;
         imPtr->tmPtr = (ClientData)Itcl_NewProcClassMethod(interp,
@@ -851,7 +874,6 @@ ItclCreateMemberCode(
 {
     int argc;
     int maxArgc;
-    Tcl_Obj *usagePtr;
     ItclArgList *argListPtr;
     ItclMemberCode *mcode;
     const char **cPtrPtr;
@@ -864,7 +886,7 @@ ItclCreateMemberCode(
     memset(mcode, 0, sizeof(ItclMemberCode));
 
     if (arglist) {
-        if (ItclCreateArgList(interp, arglist, &argc, &maxArgc, &usagePtr,
+        if (ItclCreateArgList(interp, arglist, &argc, &maxArgc, NULL,
 	        &argListPtr, NULL, NULL) != TCL_OK) {
             Itcl_DeleteMemberCode((char*)mcode);
             return TCL_ERROR;
@@ -872,8 +894,6 @@ ItclCreateMemberCode(
         mcode->argcount = argc;
         mcode->maxargcount = maxArgc;
         mcode->argListPtr = argListPtr;
-        mcode->usagePtr = usagePtr;
-	Tcl_IncrRefCount(mcode->usagePtr);
 	mcode->argumentPtr = Tcl_NewStringObj((const char *)arglist, -1);
 	if (iclsPtr->flags & (ITCL_TYPE|ITCL_WIDGETADAPTOR)) {
 	    haveError = 0;
@@ -1215,16 +1235,15 @@ Itcl_GetMemberCode(
 
 static int
 CallItclObjectCmd(
-    ClientData data[],
     Tcl_Interp *interp,
-    int result)
+    ItclMemberFunc *imPtr,
+    ItclObject *ioPtr,
+    int objc,
+    Tcl_Obj *const *objv)
 {
     Tcl_Object oPtr;
-    ItclMemberFunc *imPtr = data[0];
-    ItclObject *ioPtr = data[1];
-    int objc = PTR2INT(data[2]);
-    Tcl_Obj **objv = data[3];
-    
+    int result;
+
     ItclShowArgs(1, "CallItclObjectCmd", objc, objv);
     if (ioPtr != NULL) {
         ioPtr->hadConstructorError = 0;
@@ -1323,9 +1342,10 @@ Itcl_EvalMemberCode(
     } else {
         if ((mcode->flags & ITCL_IMPLEMENT_TCL) != 0) {
             callbackPtr = Itcl_GetCurrentCallbackPtr(interp);
-            Tcl_NRAddCallback(interp, CallItclObjectCmd, imPtr, contextIoPtr,
-	            INT2PTR(objc), (void *)objv);
-            result = Itcl_NRRunCallbacks(interp, callbackPtr);
+            result = CallItclObjectCmd(interp, imPtr, contextIoPtr,
+	            objc, objv);
+	    /* procs leave their invocation to the callbacks */
+            result = Itcl_NRRunCallbacksResult(interp, result, callbackPtr);
          }
     }
 
@@ -1411,6 +1431,188 @@ EquivArgLists(
     return 1;
 }
 
+/*
+ * ------------------------------------------------------------------------
+ *  ItclPushFrameContext()
+ *
+ *  Binds a call context to the call frame "framePtr".  Entries are
+ *  kept in a per-interp array in call order, so pushing and looking up
+ *  the context of the current frame need no hashing, and once the
+ *  array has grown to the maximum call depth no allocation either.
+ *  The level of the frame is recorded with the entry, see
+ *  FindFrameContext.
+ *
+ *  If "callContextPtr" is NULL, storage inside the entry is used for
+ *  the context.  The returned pointer to that storage is only valid
+ *  until the next context is pushed.
+ * ------------------------------------------------------------------------
+ */
+
+ItclCallContext *
+ItclPushFrameContext(
+    ItclObjectInfo *infoPtr,
+    Tcl_CallFrame *framePtr,
+    Tcl_ObjectContext contextPtr,
+    ItclCallContext *callContextPtr)
+{
+    ItclFrameContext *fcPtr;
+
+    if (infoPtr->numFrameContexts >= infoPtr->maxFrameContexts) {
+        infoPtr->maxFrameContexts = (infoPtr->maxFrameContexts == 0)
+	        ? ALLOC_CHUNK * 4 : infoPtr->maxFrameContexts * 2;
+        infoPtr->frameContexts = (ItclFrameContext *)ckrealloc(
+	        (char *)infoPtr->frameContexts,
+		infoPtr->maxFrameContexts * sizeof(ItclFrameContext));
+    }
+    fcPtr = &infoPtr->frameContexts[infoPtr->numFrameContexts++];
+    fcPtr->framePtr = framePtr;
+    fcPtr->level = Itcl_GetCallFrameLevel(framePtr);
+    fcPtr->unordered = 0;
+    if (infoPtr->numFrameContexts > 1) {
+        ItclFrameContext *prevPtr = fcPtr - 1;
+
+        fcPtr->unordered = prevPtr->unordered
+	        || (fcPtr->level < prevPtr->level);
+    }
+    fcPtr->contextPtr = contextPtr;
+    fcPtr->callContextPtr = callContextPtr;
+    if (callContextPtr == NULL) {
+        memset(&fcPtr->rootContext, 0, sizeof(ItclCallContext));
+        fcPtr->rootContext.refCount = 1;
+        fcPtr->rootContext.slot = -1;
+	return &fcPtr->rootContext;
+    }
+    return callContextPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  FindFrameContext()
+ *
+ *  Returns the index of the innermost entry bound to "framePtr" or -1.
+ *
+ *  A frame is one level deeper than the frame it was called from, so
+ *  as long as calls nest normally the levels of the entries never
+ *  decrease from one entry to the next.  Entries on deeper levels are
+ *  skipped and the search ends at the first entry on a lower level, so
+ *  a frame without a context, e.g. a proc called from a method, is
+ *  found missing at the first probe as well.  uplevel and coroutines
+ *  call into lower levels; entries pushed from there on are marked
+ *  "unordered" and compared one by one until they are popped again.
+ * ------------------------------------------------------------------------
+ */
+
+static int
+FindFrameContext(
+    ItclObjectInfo *infoPtr,
+    Tcl_CallFrame *framePtr)
+{
+    ItclFrameContext *fcPtr;
+    int level;
+    int i;
+
+    if (framePtr == NULL) {
+        return -1;
+    }
+    level = Itcl_GetCallFrameLevel(framePtr);
+    for (i = infoPtr->numFrameContexts - 1; i >= 0; i--) {
+        fcPtr = &infoPtr->frameContexts[i];
+        if (fcPtr->framePtr == framePtr) {
+	    return i;
+	}
+	if (!fcPtr->unordered && (fcPtr->level < level)) {
+	    break;
+	}
+    }
+    return -1;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclPeekFrameContext()
+ *
+ *  Returns the innermost call context bound to "framePtr", or NULL if
+ *  the frame has no Itcl context.
+ * ------------------------------------------------------------------------
+ */
+
+ItclCallContext *
+ItclPeekFrameContext(
+    ItclObjectInfo *infoPtr,
+    Tcl_CallFrame *framePtr)
+{
+    ItclFrameContext *fcPtr;
+    int i;
+
+    i = FindFrameContext(infoPtr, framePtr);
+    if (i < 0) {
+        return NULL;
+    }
+    fcPtr = &infoPtr->frameContexts[i];
+    if (fcPtr->callContextPtr == NULL) {
+	return &fcPtr->rootContext;
+    }
+    return fcPtr->callContextPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclPopFrameContext()
+ *
+ *  Removes the innermost call context bound to "framePtr", or if
+ *  "framePtr" is NULL, the innermost one pushed for the TclOO method
+ *  context "contextPtr".  Returns the removed context or NULL if there
+ *  was none.  A context stored inside the entry stays readable until
+ *  the next context is pushed.
+ * ------------------------------------------------------------------------
+ */
+
+ItclCallContext *
+ItclPopFrameContext(
+    ItclObjectInfo *infoPtr,
+    Tcl_CallFrame *framePtr,
+    Tcl_ObjectContext contextPtr)
+{
+    ItclFrameContext *fcPtr;
+    ItclFrameContext removed;
+    int i;
+
+    if (framePtr != NULL) {
+        i = FindFrameContext(infoPtr, framePtr);
+    } else {
+	for (i = infoPtr->numFrameContexts - 1; i >= 0; i--) {
+	    if (infoPtr->frameContexts[i].contextPtr == contextPtr) {
+		break;
+	    }
+	}
+    }
+    if (i < 0) {
+        return NULL;
+    }
+    fcPtr = &infoPtr->frameContexts[i];
+    infoPtr->numFrameContexts--;
+    if (i == infoPtr->numFrameContexts) {
+	/* the usual case: the innermost call returns */
+        if (fcPtr->callContextPtr == NULL) {
+	    return &fcPtr->rootContext;
+	}
+        return fcPtr->callContextPtr;
+    }
+    /*
+     * A call finished out of order, which happens with coroutines.
+     * Close the gap, the removed entry is kept behind the used ones.
+     */
+    removed = *fcPtr;
+    memmove(fcPtr, fcPtr + 1,
+            (infoPtr->numFrameContexts - i) * sizeof(ItclFrameContext));
+    fcPtr = &infoPtr->frameContexts[infoPtr->numFrameContexts];
+    *fcPtr = removed;
+    if (fcPtr->callContextPtr == NULL) {
+        return &fcPtr->rootContext;
+    }
+    return fcPtr->callContextPtr;
+}
+
 /*
  * ------------------------------------------------------------------------
  *  Itcl_GetContext()
@@ -1432,29 +1634,16 @@ Itcl_SetContext(
     Tcl_Interp *interp,
     ItclObject *ioPtr)
 {
-    int new;
-    Itcl_Stack *stackPtr;
     Tcl_CallFrame *framePtr = Itcl_GetUplevelCallFrame(interp, 0);
     ItclObjectInfo *infoPtr = (ItclObjectInfo *)Tcl_GetAssocData(interp,
             ITCL_INTERP_DATA, NULL);
-    Tcl_HashEntry *hPtr = Tcl_CreateHashEntry(&infoPtr->frameContext,
-	    (char *)framePtr, &new);
-    ItclCallContext *contextPtr
-	    = (ItclCallContext *) ckalloc(sizeof(ItclCallContext));
-
-    memset(contextPtr, 0, sizeof(ItclCallContext));
-    contextPtr->ioPtr = ioPtr;
-    contextPtr->refCount = 1;
+    ItclCallContext *contextPtr;
 
-    if (!new) {
+    if (ItclPeekFrameContext(infoPtr, framePtr) != NULL) {
 	Tcl_Panic("frame already has context?!");
     }
-    
-    stackPtr = (Itcl_Stack *) ckalloc(sizeof(Itcl_Stack));
-    Itcl_InitStack(stackPtr);
-    Tcl_SetHashValue(hPtr, stackPtr);
-
-    Itcl_PushStack(contextPtr, stackPtr);
+    contextPtr = ItclPushFrameContext(infoPtr, framePtr, NULL, NULL);
+    contextPtr->ioPtr = ioPtr;
 }
 
 void
@@ -1464,21 +1653,15 @@ Itcl_UnsetContext(
     Tcl_CallFrame *framePtr = Itcl_GetUplevelCallFrame(interp, 0);
     ItclObjectInfo *infoPtr = (ItclObjectInfo *)Tcl_GetAssocData(interp,
             ITCL_INTERP_DATA, NULL);
-    Tcl_HashEntry *hPtr = Tcl_FindHashEntry(&infoPtr->frameContext,
-	    (char *)framePtr);
-    Itcl_Stack *stackPtr = (Itcl_Stack *) Tcl_GetHashValue(hPtr);
-    ItclCallContext *contextPtr = Itcl_PopStack(stackPtr);
+    ItclCallContext *contextPtr = ItclPopFrameContext(infoPtr, framePtr,
+            NULL);
 
-    if (Itcl_GetStackSize(stackPtr) > 0) {
+    if (ItclPeekFrameContext(infoPtr, framePtr) != NULL) {
 	Tcl_Panic("frame context stack not empty!");
     }
-    Itcl_DeleteStack(stackPtr);
-    ckfree((char *) stackPtr);
-    Tcl_DeleteHashEntry(hPtr);
-    if (--contextPtr->refCount) {
+    if ((contextPtr == NULL) || --contextPtr->refCount) {
 	Tcl_Panic("frame context ref count not zero!");
     }
-    ckfree((char *)contextPtr);
 }
 
 int
@@ -1488,22 +1671,18 @@ Itcl_GetContext(
     ItclObject **ioPtrPtr)        /* returns:  object data or NULL */
 {
     Tcl_Namespace *nsPtr;
+    Tcl_HashEntry *hPtr;
+    ItclCallContext *contextPtr;
 
     /* Fetch the current call frame.  That determines context. */
     Tcl_CallFrame *framePtr = Itcl_GetUplevelCallFrame(interp, 0);
 
-    /* Try to map it to a context stack. */
+    /* Try to map it to a context. */
     ItclObjectInfo *infoPtr = (ItclObjectInfo *)Tcl_GetAssocData(interp,
             ITCL_INTERP_DATA, NULL);
-    Tcl_HashEntry *hPtr = Tcl_FindHashEntry(&infoPtr->frameContext,
-	    (char *)framePtr);
-    if (hPtr) {
-	/* Frame maps to a context stack. */
-	Itcl_Stack *stackPtr = (Itcl_Stack *)Tcl_GetHashValue(hPtr);
-	ItclCallContext *contextPtr = Itcl_PeekStack(stackPtr);
-
-	assert(contextPtr);
-
+    contextPtr = ItclPeekFrameContext(infoPtr, framePtr);
+    if (contextPtr) {
+	/* Frame maps to a context. */
 	if (contextPtr->objectFlags & ITCL_OBJECT_ROOT_METHOD) {
 	    ItclObject *ioPtr = contextPtr->ioPtr;
 
@@ -1627,14 +1806,14 @@ Itcl_GetMemberFuncUsage(
      *  Add the argument usage info.
      */
     if (imPtr->codePtr) {
-	if (imPtr->codePtr->usagePtr != NULL) {
+	if (ItclMemberCodeUsage(imPtr->codePtr) != NULL) {
             arglist = Tcl_GetString(imPtr->codePtr->usagePtr);
 	} else {
 	    arglist = NULL;
 	}
     } else {
         if (imPtr->argListPtr != NULL) {
-            arglist = Tcl_GetString(imPtr->usagePtr);
+            arglist = Tcl_GetString(ItclMemberFuncUsage(imPtr));
         } else {
             arglist = NULL;
         }
@@ -1880,8 +2059,8 @@ Itcl_ConstructBase(
     ItclClass *contextClass)  /* current class being constructed */
 {
     int result = TCL_OK;
-    Tcl_Obj *objPtr;
     Itcl_ListElem *elem;
+    ItclInstancePlan *planPtr;
 
     /*
      *  If the class has an "initCode", invoke it in the current context.
@@ -1898,27 +2077,25 @@ Itcl_ConstructBase(
      *  have not been constructed.  Invoke base class constructors
      *  implicitly, as needed.  Go through the list of base classes
      *  in reverse order, so that least-specific classes are constructed
-     *  first.
+     *  first.  The constructors called may throw the instantiation
+     *  plan away, so it is fetched again for each base class.
      */
 
-    objPtr = Tcl_NewStringObj("constructor", -1);
-    Tcl_IncrRefCount(objPtr);
     for (elem = Itcl_LastListElem(&contextClass->bases);
 	    result == TCL_OK && elem != NULL;
 	    elem = Itcl_PrevListElem(elem)) {
 	    
-	Tcl_HashEntry *entry;
         ItclClass *iclsPtr = (ItclClass*)Itcl_GetListValue(elem);
+        int i = ItclBaseIndex(contextObj->iclsPtr, iclsPtr);
 
-        if (Tcl_FindHashEntry(contextObj->constructed,
-		(char *)iclsPtr->namePtr)) {
+        if ((i < 0) || ITCL_BASE_BIT_ISSET(contextObj->constructed, i)) {
 
-	    /* Already constructed, nothing to do. */
+	    /* Already constructed or not a base of the object. */
 	    continue;
 	}
 
-        entry = Tcl_FindHashEntry(&iclsPtr->functions, (char *)objPtr);
-        if (entry) {
+        planPtr = ItclGetInstancePlan(contextObj->iclsPtr);
+        if (ITCL_BASE_BIT_ISSET(planPtr->hasConstructor, i)) {
             void *callbackPtr = Itcl_GetCurrentCallbackPtr(interp);
             Tcl_NRAddCallback(interp, CallInvokeMethodIfExists, iclsPtr,
 	            contextObj, INT2PTR(0), NULL);
@@ -1927,7 +2104,6 @@ Itcl_ConstructBase(
             result = Itcl_ConstructBase(interp, contextObj, iclsPtr);
         }
     }
-    Tcl_DecrRefCount(objPtr);
     return result;
 }
 
@@ -2112,6 +2288,7 @@ Itcl_CmdAliasProc(
 {
     Tcl_HashEntry *hPtr;
     Tcl_Obj *objPtr;
+    Tcl_Command cmd;
     ItclObjectInfo *infoPtr;
     ItclClass *iclsPtr;
     ItclObject *ioPtr;
@@ -2133,79 +2310,15 @@ Itcl_CmdAliasProc(
 	return NULL;
     }
     iclsPtr = Tcl_GetHashValue(hPtr);
+    cmd = ItclFindBuiltinAlias(interp, infoPtr, cmdName);
+    if (cmd != NULL) {
+        return cmd;
+    }
     objPtr = Tcl_NewStringObj(cmdName, -1);
     hPtr = Tcl_FindHashEntry(&iclsPtr->resolveCmds, (char *)objPtr);
     Tcl_DecrRefCount(objPtr);
     if (hPtr == NULL) {
-	if (strcmp(cmdName, "@itcl-builtin-cget") == 0) {
-	    return Tcl_FindCommand(interp, "::itcl::builtin::cget", NULL, 0);
-	}
-	if (strcmp(cmdName, "@itcl-builtin-configure") == 0) {
-	    return Tcl_FindCommand(interp, "::itcl::builtin::configure", NULL, 0);
-	}
-	if (strcmp(cmdName, "@itcl-builtin-destroy") == 0) {
-	    return Tcl_FindCommand(interp, "::itcl::builtin::destroy", NULL, 0);
-	}
-	if (strncmp(cmdName, "@itcl-builtin-setget", 20) == 0) {
-	    return Tcl_FindCommand(interp, "::itcl::builtin::setget", NULL, 0);
-	}
-	if (strcmp(cmdName, "@itcl-builtin-isa") == 0) {
-	    return Tcl_FindCommand(interp, "::itcl::builtin::isa", NULL, 0);
-	}
-	if (strcmp(cmdName, "@itcl-builtin-createhull") == 0) {
-	    return Tcl_FindCommand(interp, "::itcl::builtin::createhull", NULL, 0);
-	}
-	if (strcmp(cmdName, "@itcl-builtin-keepcomponentoption") == 0) {
-	    return Tcl_FindCommand(interp, "::itcl::builtin::keepcomponentoption", NULL, 0);
-	}
-	if (strcmp(cmdName, "@itcl-builtin-ignorecomponentoption") == 0) {
-	    return Tcl_FindCommand(interp, "::itcl::builtin::removecomponentoption", NULL, 0);
-	}
-	if (strcmp(cmdName, "@itcl-builtin-irgnorecomponentoption") == 0) {
-	    return Tcl_FindCommand(interp, "::itcl::builtin::ignorecomponentoption", NULL, 0);
-	}
-	if (strcmp(cmdName, "@itcl-builtin-setupcomponent") == 0) {
-	    return Tcl_FindCommand(interp, "::itcl::builtin::setupcomponent", NULL, 0);
-	}
-	if (strcmp(cmdName, "@itcl-builtin-initoptions") == 0) {
-	    return Tcl_FindCommand(interp, "::itcl::builtin::initoptions", NULL, 0);
-	}
-	if (strcmp(cmdName, "@itcl-builtin-mytypemethod") == 0) {
-	    return Tcl_FindCommand(interp, "::itcl::builtin::mytypemethod",
-	            NULL, 0);
-	}
-	if (strcmp(cmdName, "@itcl-builtin-mymethod") == 0) {
-	    return Tcl_FindCommand(interp, "::itcl::builtin::mymethod",
-	            NULL, 0);
-	}
-	if (strcmp(cmdName, "@itcl-builtin-myproc") == 0) {
-	    return Tcl_FindCommand(interp, "::itcl::builtin::myproc",
-	            NULL, 0);
-	}
-	if (strcmp(cmdName, "@itcl-builtin-mytypevar") == 0) {
-	    return Tcl_FindCommand(interp, "::itcl::builtin::mytypevar",
-	            NULL, 0);
-	}
-	if (strcmp(cmdName, "@itcl-builtin-myvar") == 0) {
-	    return Tcl_FindCommand(interp, "::itcl::builtin::myvar",
-	            NULL, 0);
-	}
-	if (strcmp(cmdName, "@itcl-builtin-itcl_hull") == 0) {
-	    return Tcl_FindCommand(interp, "::itcl::builtin::itcl_hull",
-	            NULL, 0);
-	}
-	if (strcmp(cmdName, "@itcl-builtin-callinstance") == 0) {
-	    return Tcl_FindCommand(interp, "::itcl::builtin::callinstance",
-	            NULL, 0);
-	}
-	if (strcmp(cmdName, "@itcl-builtin-getinstancevar") == 0) {
-	    return Tcl_FindCommand(interp, "::itcl::builtin::getinstancevar",
-	            NULL, 0);
-	}
-	if (strcmp(cmdName, "@itcl-builtin-classunknown") == 0) {
-	    return Tcl_FindCommand(interp, "::itcl::builtin::classunknown", NULL, 0);
-	}
-        return NULL;
+	return NULL;
     }
     clookup = (ItclCmdLookup *)Tcl_GetHashValue(hPtr);
     imPtr = clookup->imPtr;
@@ -2265,24 +2378,21 @@ Itcl_VarAliasProc(
     }
 
     if (ioPtr != NULL) {
-        hPtr = Tcl_FindHashEntry(&ioPtr->objectVariables,
-	        (char *)ivlPtr->ivPtr);
+        varPtr = ItclGetObjectVar(ioPtr, ivlPtr->ivPtr);
     } else {
         hPtr = Tcl_FindHashEntry(&iclsPtr->classCommons,
 	        (char *)ivlPtr->ivPtr);
-        if (hPtr == NULL) {
+        if (hPtr != NULL) {
+            varPtr = Tcl_GetHashValue(hPtr);
+        } else {
 	    if (callContextPtr != NULL) {
 	        ioPtr = callContextPtr->ioPtr;
 	    }
 	    if (ioPtr != NULL) {
-                hPtr = Tcl_FindHashEntry(&ioPtr->objectVariables,
-	                (char *)ivlPtr->ivPtr);
+                varPtr = ItclGetObjectVar(ioPtr, ivlPtr->ivPtr);
 	    }
 	}
     }
-    if (hPtr != NULL) {
-        varPtr = Tcl_GetHashValue(hPtr);
-    }
     return varPtr;
 }
 
@@ -2316,6 +2426,51 @@ ItclCheckCallProc(
     return result;
 }
 
+/*
+ * ------------------------------------------------------------------------
+ *  GetCallContextSlot()
+ *
+ *  Returns the place where the object "ioPtr" keeps its reusable call
+ *  context for the member function "imPtr", or NULL if the object has
+ *  none for it.  The slots are numbered per class by
+ *  Itcl_BuildVirtualTables, the array is allocated on the first method
+ *  call, so objects that never call a method pay nothing for it.
+ * ------------------------------------------------------------------------
+ */
+static ItclCallContext **
+GetCallContextSlot(
+    ItclObject *ioPtr,
+    ItclMemberFunc *imPtr)
+{
+    ItclClass *iclsPtr = ioPtr->iclsPtr;
+    int slot;
+    int i;
+
+    for (i = 0; i < iclsPtr->numSlotBases; i++) {
+        if (iclsPtr->slotBases[i].iclsPtr == imPtr->iclsPtr) {
+	    break;
+	}
+    }
+    if (i >= iclsPtr->numSlotBases) {
+        return NULL;
+    }
+    slot = iclsPtr->slotBases[i].offset + imPtr->slot;
+    if (ioPtr->callContexts == NULL) {
+        if (iclsPtr->numMethodSlots == 0) {
+	    return NULL;
+	}
+        ioPtr->numCallContexts = iclsPtr->numMethodSlots;
+	ioPtr->callContexts = (ItclCallContext **)ckalloc(
+	        ioPtr->numCallContexts * sizeof(ItclCallContext *));
+	memset(ioPtr->callContexts, 0,
+	        ioPtr->numCallContexts * sizeof(ItclCallContext *));
+    }
+    if (slot >= ioPtr->numCallContexts) {
+        return NULL;
+    }
+    return &ioPtr->callContexts[slot];
+}
+
 /*
  * ------------------------------------------------------------------------
  *  ItclCheckCallMethod()
@@ -2331,25 +2486,19 @@ ItclCheckCallMethod(
     Tcl_CallFrame *framePtr,
     int *isFinished)
 {
-    Itcl_Stack *stackPtr;
-
     Tcl_Object oPtr;
     ItclObject *ioPtr;
-    Tcl_HashEntry *hPtr;
     Tcl_Obj *const * cObjv;
     Tcl_Namespace *currNsPtr;
     ItclCallContext *callContextPtr;
     ItclCallContext *callContextPtr2;
+    ItclCallContext **slotPtr;
     ItclMemberFunc *imPtr;
     int result;
-    int isNew;
     int cObjc;
     int min_allowed_args;
 
-    ItclObjectInfo *infoPtr;
-
     oPtr = NULL;
-    hPtr = NULL;
     imPtr = (ItclMemberFunc *)clientData;
     ItclPreserveIMF(imPtr);
     if (imPtr->flags & ITCL_CONSTRUCTOR) {
@@ -2405,7 +2554,7 @@ ItclCheckCallMethod(
     if (min_allowed_args < imPtr->argcount) {
 	Tcl_AppendResult(interp, "wrong # args: should be \"",
 		Tcl_GetString(cObjv[0]), " ", Tcl_GetString(imPtr->namePtr),
-		" ", Tcl_GetString(imPtr->usagePtr), "\"", NULL);
+		" ", Tcl_GetString(ItclMemberFuncUsage(imPtr)), "\"", NULL);
         if (isFinished != NULL) {
             *isFinished = 1;
         }
@@ -2413,22 +2562,29 @@ ItclCheckCallMethod(
 	goto finishReturn;
     }
   }
-    isNew = 0;
     callContextPtr = NULL;
     currNsPtr = Tcl_GetCurrentNamespace(interp);
     if (ioPtr != NULL) {
-        hPtr = Tcl_CreateHashEntry(&ioPtr->contextCache, (char *)imPtr, &isNew);
-        if (!isNew) {
-	    callContextPtr2 = Tcl_GetHashValue(hPtr);
+        slotPtr = GetCallContextSlot(ioPtr, imPtr);
+        if (slotPtr != NULL) {
+	    callContextPtr2 = *slotPtr;
+	    if (callContextPtr2 == NULL) {
+	        callContextPtr2 = (ItclCallContext *)ckalloc(
+		        sizeof(ItclCallContext));
+	        callContextPtr2->refCount = 0;
+	        callContextPtr2->slot = (int)(slotPtr - ioPtr->callContexts);
+		*slotPtr = callContextPtr2;
+	    }
 	    if (callContextPtr2->refCount == 0) {
 	        callContextPtr = callContextPtr2;
                 callContextPtr->objectFlags = ioPtr->flags;
-                callContextPtr->nsPtr = Tcl_GetCurrentNamespace(interp);
+                callContextPtr->nsPtr = currNsPtr;
                 callContextPtr->ioPtr = ioPtr;
                 callContextPtr->imPtr = imPtr;
                 callContextPtr->refCount = 1;
 	    } else {
-	      if ((callContextPtr2->objectFlags == ioPtr->flags) 
+	      if ((callContextPtr2->imPtr == imPtr)
+	            && (callContextPtr2->objectFlags == ioPtr->flags)
 		    && (callContextPtr2->nsPtr == currNsPtr)) {
 	        callContextPtr = callContextPtr2;
                 callContextPtr->refCount++;
@@ -2446,45 +2602,19 @@ ItclCheckCallMethod(
             callContextPtr->objectFlags = ioPtr->flags;
             callContextPtr->ioPtr = ioPtr;
 	}
-        callContextPtr->nsPtr = Tcl_GetCurrentNamespace(interp);
+        callContextPtr->nsPtr = currNsPtr;
         callContextPtr->imPtr = imPtr;
         callContextPtr->refCount = 1;
-    }
-    if (isNew) {
-        Tcl_SetHashValue(hPtr, callContextPtr);
+        callContextPtr->slot = -1;
     }
 
     if (framePtr == NULL) {
 	framePtr = Itcl_GetUplevelCallFrame(interp, 0);
     }
 
-    isNew = 0;
-    infoPtr = imPtr->iclsPtr->infoPtr;
-    hPtr = Tcl_CreateHashEntry(&infoPtr->frameContext,
-	    (char *)framePtr, &isNew);
-    if (isNew) {
-	stackPtr = (Itcl_Stack *)ckalloc(sizeof(Itcl_Stack));
-	Itcl_InitStack(stackPtr);
-        Tcl_SetHashValue(hPtr, stackPtr);
-    } else {
-	stackPtr = (Itcl_Stack *)Tcl_GetHashValue(hPtr);
-    }
-
     assert (callContextPtr) ;
-    Itcl_PushStack(callContextPtr, stackPtr);
-
-    /* Ugly abuse alert.  Two maps in one table */
-    hPtr = Tcl_CreateHashEntry(&infoPtr->frameContext,
-	    (char *)contextPtr, &isNew);
-    if (isNew) {
-	stackPtr = (Itcl_Stack *)ckalloc(sizeof(Itcl_Stack));
-	Itcl_InitStack(stackPtr);
-        Tcl_SetHashValue(hPtr, stackPtr);
-    } else {
-	stackPtr = (Itcl_Stack *)Tcl_GetHashValue(hPtr);
-    }
-
-    Itcl_PushStack(framePtr, stackPtr);
+    ItclPushFrameContext(imPtr->iclsPtr->infoPtr, framePtr, contextPtr,
+            callContextPtr);
 
     if (ioPtr != NULL) {
         ioPtr->callRefCount++;
@@ -2520,39 +2650,16 @@ ItclAfterCallMethod(
     Tcl_Namespace *nsPtr,
     int call_result)
 {
-    Tcl_HashEntry *hPtr;
     ItclObject *ioPtr;
     ItclMemberFunc *imPtr;
     ItclCallContext *callContextPtr;
-    int newEntry;
     int result;
 
     imPtr = (ItclMemberFunc *)clientData;
     callContextPtr = NULL;
     if (contextPtr != NULL) {
-    ItclObjectInfo *infoPtr = imPtr->infoPtr;
-    Tcl_CallFrame *framePtr;
-    Itcl_Stack *stackPtr;
-	
-    hPtr = Tcl_FindHashEntry(&infoPtr->frameContext, (char *)contextPtr);
-    assert(hPtr);
-    stackPtr = (Itcl_Stack *)Tcl_GetHashValue(hPtr);
-    framePtr = Itcl_PopStack(stackPtr);
-    if (Itcl_GetStackSize(stackPtr) == 0) {
-	Itcl_DeleteStack(stackPtr);
-	ckfree((char *) stackPtr);
-	Tcl_DeleteHashEntry(hPtr);
-    }
-
-    hPtr = Tcl_FindHashEntry(&infoPtr->frameContext, (char *)framePtr);
-    assert(hPtr);
-    stackPtr = (Itcl_Stack *)Tcl_GetHashValue(hPtr);
-    callContextPtr = Itcl_PopStack(stackPtr);
-    if (Itcl_GetStackSize(stackPtr) == 0) {
-	Itcl_DeleteStack(stackPtr);
-	ckfree((char *) stackPtr);
-	Tcl_DeleteHashEntry(hPtr);
-    }
+        callContextPtr = ItclPopFrameContext(imPtr->infoPtr, NULL, contextPtr);
+        assert(callContextPtr);
     }
     if (callContextPtr == NULL) {
         if ((imPtr->flags & ITCL_COMMON) ||
@@ -2577,15 +2684,15 @@ ItclAfterCallMethod(
       if (imPtr->iclsPtr) {
         imPtr->iclsPtr->callRefCount--;
         if (imPtr->flags & (ITCL_CONSTRUCTOR | ITCL_DESTRUCTOR)) {
+            int i = ItclBaseIndex(ioPtr->iclsPtr, imPtr->iclsPtr);
+
             if ((imPtr->flags & ITCL_DESTRUCTOR) && ioPtr &&
-                 ioPtr->destructed) {
-                Tcl_CreateHashEntry(ioPtr->destructed,
-                    (char *)imPtr->iclsPtr->namePtr, &newEntry);
+                 ioPtr->destructed && (i >= 0)) {
+                ITCL_BASE_BIT_SET(ioPtr->destructed, i);
             }
             if ((imPtr->flags & ITCL_CONSTRUCTOR) && ioPtr &&
-                 ioPtr->constructed) {
-                Tcl_CreateHashEntry(ioPtr->constructed,
-                    (char *)imPtr->iclsPtr->namePtr, &newEntry);
+                 ioPtr->constructed && (i >= 0)) {
+                ITCL_BASE_BIT_SET(ioPtr->constructed, i);
             }
         }
       }
@@ -2598,9 +2705,7 @@ ItclAfterCallMethod(
     callContextPtr->refCount--;
     if (callContextPtr->refCount == 0) {
         if (callContextPtr->ioPtr != NULL) {
-	    hPtr = Tcl_FindHashEntry(&callContextPtr->ioPtr->contextCache,
-	            (char *)callContextPtr->imPtr);
-            if (hPtr == NULL) {
+            if (callContextPtr->slot < 0) {
                 ckfree((char *)callContextPtr);
 	    }
 	    ItclReleaseObject(ioPtr);
@@ -2627,23 +2732,14 @@ ItclProcErrorProc(
     ItclObject *contextIoPtr;
     ItclClass *currIclsPtr;
     char num[20];
-    Itcl_Stack *stackPtr;
 
     /* Fetch the current call frame.  That determines context. */
     Tcl_CallFrame *framePtr = Itcl_GetUplevelCallFrame(interp, 0);
 
-    /* Try to map it to a context stack. */
+    /* Try to map it to a context. */
     infoPtr = (ItclObjectInfo *)Tcl_GetAssocData(interp,
             ITCL_INTERP_DATA, NULL);
-    hPtr = Tcl_FindHashEntry(&infoPtr->frameContext, (char *)framePtr);
-    if (hPtr == NULL) {
-	/* Can this happen? */
-	return;
-    }
-
-    /* Frame maps to a context stack. */
-    stackPtr = (Itcl_Stack *)Tcl_GetHashValue(hPtr);
-    callContextPtr = Itcl_PeekStack(stackPtr);
+    callContextPtr = ItclPeekFrameContext(infoPtr, framePtr);
 
     if (callContextPtr == NULL) {
 	return;
@@ -2668,7 +2764,7 @@ ItclProcErrorProc(
             }
         }
 	if (imPtr->flags & ITCL_DESTRUCTOR) {
-	    contextIoPtr->flags = 0;
+	    contextIoPtr->flags &= ITCL_OBJECT_STORAGE_FLAGS;
 	    Tcl_AppendToObj(objPtr, "while deleting object \"", -1);
             Tcl_GetCommandFullName(interp, contextIoPtr->accessCmd, objPtr);
             Tcl_AppendToObj(objPtr, "\" in ", -1);
@@ -86,6 +86,203 @@ Itcl_ReleaseVar(
     TclCleanupVar(varPtr, NULL);
 }
 
+struct TclVarHashTable *
+Itcl_NewVarTable(
+    Tcl_Interp *interp)
+{
+    TclVarHashTable *tablePtr;
+
+    /*
+     * The variables belong to the global namespace, so with keys
+     * relative to it Tcl_GetVariableFullName returns real names.
+     */
+    tablePtr = (TclVarHashTable *)ckalloc(sizeof(TclVarHashTable));
+    TclInitVarHashTable(tablePtr, ((Interp *)interp)->globalNsPtr);
+    return tablePtr;
+}
+
+Tcl_Var
+Itcl_NewTableVar(
+    struct TclVarHashTable *tablePtr,
+    const char *varName,
+    Tcl_Obj *valuePtr)
+{
+    Var *varPtr;
+    int new;
+
+    varPtr = TclVarHashCreateVar(tablePtr, varName, &new);
+    TclSetVarNamespaceVar(varPtr);
+    if (new && (valuePtr != NULL)) {
+	/* a new variable has no traces, so just store the value */
+        varPtr->value.objPtr = valuePtr;
+	Tcl_IncrRefCount(valuePtr);
+    }
+    return (Tcl_Var)varPtr;
+}
+
+/*
+ *  Stores a value in a scalar variable without running its traces.
+ *  Used for the built-in variables like "this", whose traces only
+ *  guard against writes by scripts.
+ */
+void
+Itcl_SetVarValue(
+    Tcl_Var var,
+    Tcl_Obj *valuePtr)
+{
+    Var *varPtr = (Var *)var;
+
+    if (TclIsVarArray(varPtr) || TclIsVarLink(varPtr)
+            || TclIsVarDeadHash(varPtr)) {
+        return;
+    }
+    Tcl_IncrRefCount(valuePtr);
+    if (varPtr->value.objPtr != NULL) {
+        Tcl_DecrRefCount(varPtr->value.objPtr);
+    }
+    varPtr->value.objPtr = valuePtr;
+}
+
+/*
+ *  Read and write a scalar variable through its handle, running its
+ *  traces like Tcl_ObjGetVar2 and Tcl_ObjSetVar2 would.  "namePtr" is
+ *  the name passed to the traces and used in error messages.
+ */
+Tcl_Obj *
+Itcl_GetVarObj(
+    Tcl_Interp *interp,
+    Tcl_Var var,
+    Tcl_Obj *namePtr,
+    int flags)
+{
+    return TclPtrGetVar(interp, var, NULL, namePtr, NULL, flags);
+}
+
+Tcl_Obj *
+Itcl_SetVarObj(
+    Tcl_Interp *interp,
+    Tcl_Var var,
+    Tcl_Obj *namePtr,
+    Tcl_Obj *valuePtr,
+    int flags)
+{
+    return TclPtrSetVar(interp, var, NULL, namePtr, NULL, valuePtr, flags);
+}
+
+/*
+ *  Returns the value of the element "name2" of the array variable
+ *  "var", looked up through the handle of the array.  Returns NULL
+ *  if the variable is no array, has no such element, or either of
+ *  them has read traces.  Then the caller has to read the element
+ *  the usual way to run the traces or get the error message.
+ */
+Tcl_Obj *
+Itcl_GetVarElementValue(
+    Tcl_Var var,
+    const char *name2)
+{
+    Var *arrayPtr = (Var *)var;
+    Var *varPtr;
+
+    if (!TclIsVarArray(arrayPtr) || (arrayPtr->flags & VAR_TRACED_READ)) {
+        return NULL;
+    }
+    varPtr = TclVarHashFindVar(arrayPtr->value.tablePtr, name2);
+    if ((varPtr == NULL) || !TclIsVarScalar(varPtr)
+            || TclIsVarUndefined(varPtr)
+	    || (varPtr->flags & VAR_TRACED_READ)) {
+        return NULL;
+    }
+    return varPtr->value.objPtr;
+}
+
+/*
+ *  Evaluates objv the way TclOO runs the target of a forwarded method:
+ *  objv[0] is looked up in the namespace nsPtr before the global one,
+ *  and no "invoked from within" lines are added to the error info.
+ */
+int
+Itcl_EvalForwardObjv(
+    Tcl_Interp *interp,
+    Tcl_Namespace *nsPtr,
+    int objc,
+    Tcl_Obj *const objv[])
+{
+    ((Interp *)interp)->lookupNsPtr = (Namespace *)nsPtr;
+    return Tcl_EvalObjv(interp, objc, objv, TCL_EVAL_NOERR);
+}
+
+void
+Itcl_DeleteVarTable(
+    Tcl_Interp *interp,
+    struct TclVarHashTable *tablePtr)
+{
+    TclDeleteVars((Interp *)interp, tablePtr);
+    ckfree((char *)tablePtr);
+}
+
+/*
+ *  Sizes of Tcl structures for "itcl::memory".  They count the storage
+ *  of the tables and their entries, not that of the keys and values.
+ */
+size_t
+Itcl_HashTableSize(
+    Tcl_HashTable *tablePtr)
+{
+    size_t size;
+
+    size = tablePtr->numEntries * sizeof(Tcl_HashEntry);
+    if (tablePtr->buckets != tablePtr->staticBuckets) {
+        size += tablePtr->numBuckets * sizeof(Tcl_HashEntry *);
+    }
+    return size;
+}
+
+static size_t
+VarHashTableSize(
+    TclVarHashTable *tablePtr)
+{
+    size_t size;
+
+    size = tablePtr->table.numEntries * sizeof(VarInHash);
+    if (tablePtr->table.buckets != tablePtr->table.staticBuckets) {
+        size += tablePtr->table.numBuckets * sizeof(Tcl_HashEntry *);
+    }
+    return size;
+}
+
+size_t
+Itcl_VarTableSize(
+    struct TclVarHashTable *tablePtr)
+{
+    return sizeof(TclVarHashTable) + VarHashTableSize(tablePtr);
+}
+
+size_t
+Itcl_NamespaceSize(
+    Tcl_Namespace *nsPtr)
+{
+    Namespace *namespacePtr = (Namespace *)nsPtr;
+    size_t size;
+
+    size = sizeof(Namespace) + strlen(namespacePtr->name) + 1
+            + strlen(namespacePtr->fullName) + 1;
+    size += VarHashTableSize(&namespacePtr->varTable);
+    size += Itcl_HashTableSize(&namespacePtr->cmdTable)
+            + namespacePtr->cmdTable.numEntries * sizeof(Command);
+    return size;
+}
+
+int
+Itcl_UpVar(
+    Tcl_Interp *interp,
+    Tcl_Var var,
+    const char *myName,
+    int myFlags)
+{
+    return TclPtrMakeUpvar(interp, (Var *)var, myName, myFlags, -1);
+}
+
 Tcl_CallFrame *
 Itcl_GetUplevelCallFrame(
     Tcl_Interp *interp,
@@ -105,6 +302,13 @@ Itcl_GetUplevelCallFrame(
     return (Tcl_CallFrame *)framePtr;
 }
 
+int
+Itcl_GetCallFrameLevel(
+    Tcl_CallFrame *framePtr)
+{
+    return ((CallFrame *)framePtr)->level;
+}
+
 Tcl_CallFrame *
 Itcl_ActivateCallFrame(
     Tcl_Interp *interp,
@@ -77,8 +77,29 @@ MODULE_SCOPE Tcl_Var Tcl_NewNamespaceVar(Tcl_Interp *interp, Tcl_Namespace *nsPt
 	const char *varName);
 MODULE_SCOPE void Itcl_PreserveVar(Tcl_Var var);
 MODULE_SCOPE void Itcl_ReleaseVar(Tcl_Var var);
+struct TclVarHashTable;
+MODULE_SCOPE struct TclVarHashTable *Itcl_NewVarTable(Tcl_Interp *interp);
+MODULE_SCOPE Tcl_Var Itcl_NewTableVar(struct TclVarHashTable *tablePtr,
+        const char *varName, Tcl_Obj *valuePtr);
+MODULE_SCOPE void Itcl_SetVarValue(Tcl_Var var, Tcl_Obj *valuePtr);
+MODULE_SCOPE Tcl_Obj *Itcl_GetVarObj(Tcl_Interp *interp, Tcl_Var var,
+        Tcl_Obj *namePtr, int flags);
+MODULE_SCOPE Tcl_Obj *Itcl_SetVarObj(Tcl_Interp *interp, Tcl_Var var,
+        Tcl_Obj *namePtr, Tcl_Obj *valuePtr, int flags);
+MODULE_SCOPE Tcl_Obj *Itcl_GetVarElementValue(Tcl_Var var,
+        const char *name2);
+MODULE_SCOPE int Itcl_EvalForwardObjv(Tcl_Interp *interp,
+        Tcl_Namespace *nsPtr, int objc, Tcl_Obj *const objv[]);
+MODULE_SCOPE void Itcl_DeleteVarTable(Tcl_Interp *interp,
+        struct TclVarHashTable *tablePtr);
+MODULE_SCOPE size_t Itcl_HashTableSize(Tcl_HashTable *tablePtr);
+MODULE_SCOPE size_t Itcl_VarTableSize(struct TclVarHashTable *tablePtr);
+MODULE_SCOPE size_t Itcl_NamespaceSize(Tcl_Namespace *nsPtr);
+MODULE_SCOPE int Itcl_UpVar(Tcl_Interp *interp, Tcl_Var var,
+        const char *myName, int myFlags);
 MODULE_SCOPE int Itcl_IsCallFrameArgument(Tcl_Interp *interp, const char *name);
 MODULE_SCOPE int Itcl_GetCallVarFrameObjc(Tcl_Interp *interp);
+MODULE_SCOPE int Itcl_GetCallFrameLevel(Tcl_CallFrame *framePtr);
 MODULE_SCOPE int Itcl_IsVarLink(Tcl_Var var);
 MODULE_SCOPE int Itcl_IsCallFrameLinkVar(Tcl_Interp *interp, const char *name);
 MODULE_SCOPE Tcl_Obj * const * Itcl_GetCallVarFrameObjv(Tcl_Interp *interp);
@@ -45,8 +45,6 @@ static char* ItclTraceSelfnsVar(ClientData cdata, Tcl_Interp *interp,
 	const char *name1, const char *name2, int flags);
 static char* ItclTraceWinVar(ClientData cdata, Tcl_Interp *interp,
 	const char *name1, const char *name2, int flags);
-static char* ItclTraceOptionVar(ClientData cdata, Tcl_Interp *interp,
-	const char *name1, const char *name2, int flags);
 static char* ItclTraceComponentVar(ClientData cdata, Tcl_Interp *interp,
 	const char *name1, const char *name2, int flags);
 static char* ItclTraceItclHullVar(ClientData cdata, Tcl_Interp *interp,
@@ -54,21 +52,49 @@ static char* ItclTraceItclHullVar(ClientData cdata, Tcl_Interp *interp,
 
 static void ItclDestroyObject(ClientData clientData);
 static void ItclFreeObject(char * clientData);
+static void ItclRemoveDestructedObject(Tcl_Interp *interp,
+        ItclObject *contextIoPtr);
+static Tcl_TimerProc DeferredDeletionProc;
+static void ItclForgetDeferredObject(ItclObject *ioPtr);
+
+/*
+ *  Entry of ItclObjectInfo.deferredObjects.
+ */
+typedef struct DeferredObject {
+    ItclObject *ioPtr;           /* object waiting to be deleted */
+    Tcl_Obj *namePtr;            /* full name of its access command before
+                                  * it was taken out of reach */
+} DeferredObject;
 
 static int ItclDestructBase(Tcl_Interp *interp, ItclObject *contextObj,
         ItclClass *contextClass, int flags);
 
+static int ItclInitCompactObjectVariables(Tcl_Interp *interp,
+        ItclObject *ioPtr, ItclInstancePlan *planPtr);
+static Tcl_Var NewCompactVar(ItclObject *ioPtr, ItclVariable *ivPtr,
+        Tcl_Obj *valuePtr);
 static int ItclInitObjectVariables(Tcl_Interp *interp, ItclObject *ioPtr,
-        ItclClass *iclsPtr);
+        ItclClass *iclsPtr, ItclInstancePlan *planPtr);
 static int ItclInitObjectCommands(Tcl_Interp *interp, ItclObject *ioPtr,
         ItclClass *iclsPtr, const char *name);
 static int ItclInitExtendedClassOptions(Tcl_Interp *interp, ItclObject *ioPtr);
 static int ItclInitObjectOptions(Tcl_Interp *interp, ItclObject *ioPtr,
         ItclClass *iclsPtr);
+static Tcl_Obj *ItclBuiltinVarValue(ItclObject *ioPtr, ItclVariable *ivPtr);
+static void ItclSetObjectNameVars(ItclObject *ioPtr);
 static const char * GetConstructorVar(Tcl_Interp *interp, ItclClass *iclsPtr,
         const char *varName);
 static ItclClass * GetClassFromClassName(Tcl_Interp *interp,
 	const char *className, ItclClass *iclsPtr);
+static Tcl_MethodCallProc DelegatedMethodCall;
+
+static const Tcl_MethodType itclDelegatedMethodType = {
+    TCL_OO_METHOD_VERSION_CURRENT,
+    "itcl delegated method",
+    DelegatedMethodCall,
+    NULL,
+    NULL
+};
 
 void
 ItclPreserveObject(
@@ -137,6 +163,9 @@ ObjectRenamedTrace(
 
     if (newName != NULL) {
 	/* FIXME should enter the new name in the hashtables for objects etc. */
+        if (!(ioPtr->flags & ITCL_OBJECT_CLASS_DESTRUCTED)) {
+            ItclSetObjectNameVars(ioPtr);
+        }
         return;
     }
     if (ioPtr->flags & ITCL_OBJECT_CLASS_DESTRUCTED) {
@@ -193,6 +222,122 @@ Itcl_CreateObject(
     return result;
 }
 
+/*
+ * ------------------------------------------------------------------------
+ *  Itcl_CreateObjects()
+ *
+ *  Creates "count" objects of the given class in the current namespace,
+ *  each named as if by "<className> #auto" and constructed with the
+ *  same arguments.  The class lookup, the name prefix and the
+ *  instantiation plan are shared by all of them.  Only classes
+ *  created by itcl::class or itcl::extendedclass are supported.
+ *
+ *  Returns TCL_OK and, if "namesPtrPtr" is not NULL, a new list of
+ *  the object names there.  If any object cannot be created, the
+ *  objects created so far are deleted again, and TCL_ERROR is
+ *  returned along with the error message of the failing object.
+ * ------------------------------------------------------------------------
+ */
+int
+Itcl_CreateObjects(
+    Tcl_Interp *interp,      /* interpreter mananging new objects */
+    ItclClass *iclsPtr,      /* class for new objects */
+    int count,               /* number of objects to create */
+    int objc,                /* number of constructor arguments */
+    Tcl_Obj *const objv[],   /* constructor arguments */
+    Tcl_Obj **namesPtrPtr)   /* returns: list of object names, or NULL */
+{
+    Tcl_DString buffer;
+    Tcl_CmdInfo dummy;
+    Tcl_Obj **namev;
+    Itcl_InterpState istate;
+    char unique[TCL_INTEGER_SPACE];
+    int prefixLen;
+    int result;
+    int i;
+
+    if (namesPtrPtr != NULL) {
+        *namesPtrPtr = NULL;
+    }
+    if (iclsPtr->flags & (ITCL_TYPE|ITCL_WIDGET|ITCL_WIDGETADAPTOR
+            |ITCL_NWIDGET)) {
+        Tcl_AppendResult(interp, "cannot create objects of \"",
+	        Tcl_GetString(iclsPtr->fullNamePtr), "\" in bulk: ",
+		"not an itcl::class or itcl::extendedclass", NULL);
+        return TCL_ERROR;
+    }
+    if (count < 0) {
+        count = 0;
+    }
+
+    /*
+     *  All names start with the class name with its first letter
+     *  in lower case, like those of "#auto".
+     */
+    Tcl_DStringInit(&buffer);
+    Tcl_DStringAppend(&buffer, Tcl_GetString(iclsPtr->namePtr), -1);
+    if (Tcl_DStringLength(&buffer) > 200) {
+        Tcl_DStringSetLength(&buffer, 200);
+    }
+    Tcl_DStringValue(&buffer)[0] = tolower(UCHAR(Tcl_DStringValue(&buffer)[0]));
+    prefixLen = Tcl_DStringLength(&buffer);
+
+    ItclGetInstancePlan(iclsPtr);
+    namev = (Tcl_Obj **)ckalloc((count + 1) * sizeof(Tcl_Obj *));
+    result = TCL_OK;
+    for (i = 0; i < count; i++) {
+	/*
+	 * [Fix 227811] Check for any command with the
+	 * given name, not only objects.
+	 */
+        do {
+            sprintf(unique, "%d", iclsPtr->unique++);
+            Tcl_DStringSetLength(&buffer, prefixLen);
+            Tcl_DStringAppend(&buffer, unique, -1);
+        } while (Tcl_GetCommandInfo(interp, Tcl_DStringValue(&buffer),
+	        &dummy) != 0);
+
+        result = ItclCreateObject(interp, Tcl_DStringValue(&buffer), iclsPtr,
+	        objc, objv);
+        if (result != TCL_OK) {
+            break;
+        }
+        namev[i] = Tcl_NewStringObj(Tcl_DStringValue(&buffer),
+	        Tcl_DStringLength(&buffer));
+        Tcl_IncrRefCount(namev[i]);
+    }
+    Tcl_DStringFree(&buffer);
+
+    if (result != TCL_OK) {
+	/*
+	 *  Take back the objects created before the failing one.  Errors
+	 *  of their destructors are ignored in favour of the original
+	 *  error.
+	 */
+        count = i;
+        istate = Itcl_SaveInterpState(interp, result);
+        for (i = 0; i < count; i++) {
+            Tcl_Command cmd;
+
+            cmd = Tcl_FindCommand(interp, Tcl_GetString(namev[i]), NULL, 0);
+            if ((cmd != NULL) && Itcl_IsObject(cmd)) {
+                Tcl_DeleteCommandFromToken(interp, cmd);
+            }
+        }
+        result = Itcl_RestoreInterpState(interp, istate);
+    } else {
+        Tcl_ResetResult(interp);
+        if (namesPtrPtr != NULL) {
+            *namesPtrPtr = Tcl_NewListObj(count, namev);
+        }
+    }
+    for (i = 0; i < count; i++) {
+        Tcl_DecrRefCount(namev[i]);
+    }
+    ckfree((char *)namev);
+    return result;
+}
+
 /*
  * ------------------------------------------------------------------------
  *  ItclCreateObject()
@@ -232,9 +377,12 @@ ItclCreateObject(
     ItclObjectInfo *infoPtr;
     ItclObject *saveCurrIoPtr;
     ItclObject *ioPtr;
+    ItclInstancePlan *planPtr;
     Itcl_InterpState istate;
     const char *nsName;
     const char *objName;
+    int hasConstructor;
+    int anyConstructor;
     char unique[256];    /* buffer used for unique part of object names */
     int newEntry;
     ItclResolveInfo *resolveInfoPtr;
@@ -270,14 +418,30 @@ ItclCreateObject(
     ioPtr->iclsPtr = iclsPtr;
     ioPtr->interp = interp;
     ioPtr->infoPtr = infoPtr;
+    if (iclsPtr->flags & ITCL_CLASS_LAZY_VARS) {
+        ioPtr->flags |= ITCL_OBJECT_COMPACT_VARS|ITCL_OBJECT_LAZY_VARS;
+    } else if (iclsPtr->flags & ITCL_CLASS_COMPACT_VARS) {
+        ioPtr->flags |= ITCL_OBJECT_COMPACT_VARS;
+    } else if ((infoPtr != NULL) && infoPtr->lazyVars
+            && (iclsPtr->flags & ITCL_CLASS)
+	    && !(iclsPtr->flags & ITCL_CLASS_NAMESPACE_VARS)) {
+        ioPtr->flags |= ITCL_OBJECT_COMPACT_VARS|ITCL_OBJECT_LAZY_VARS;
+    }
     ItclPreserveClass(iclsPtr);
 
-    ioPtr->constructed = (Tcl_HashTable*)ckalloc(sizeof(Tcl_HashTable));
-    Tcl_InitObjHashTable(ioPtr->constructed);
+    /*
+     *  Constructors may add members to classes, which throws the plan
+     *  away, so it must not be used once they have been called.
+     */
+    planPtr = ItclGetInstancePlan(iclsPtr);
+    hasConstructor = ITCL_BASE_BIT_ISSET(planPtr->hasConstructor, 0);
+    anyConstructor = planPtr->anyConstructor;
+    ioPtr->constructed = ItclNewBaseBits(ioPtr, ioPtr->constructedSpace);
 
     ioPtr->oPtr = Tcl_NewObjectInstance(interp, iclsPtr->clsPtr, NULL,
             /* nsName */ NULL, /* objc */ -1, /* objv */ NULL, /* skip */ 0);
     if (ioPtr->oPtr == NULL) {
+        ItclFreeBaseBits(ioPtr->constructed, ioPtr->constructedSpace);
 	ckfree(ioPtr);
         return TCL_ERROR;
     }
@@ -309,14 +473,6 @@ ItclCreateObject(
     Tcl_IncrRefCount(ioPtr->varNsNamePtr);
     Tcl_DStringFree(&buffer);
 
-    Tcl_InitHashTable(&ioPtr->objectVariables, TCL_ONE_WORD_KEYS);
-    Tcl_InitObjHashTable(&ioPtr->objectOptions);
-    Tcl_InitObjHashTable(&ioPtr->objectComponents);
-    Tcl_InitObjHashTable(&ioPtr->objectDelegatedOptions);
-    Tcl_InitObjHashTable(&ioPtr->objectDelegatedFunctions);
-    Tcl_InitObjHashTable(&ioPtr->objectMethodVariables);
-    Tcl_InitHashTable(&ioPtr->contextCache, TCL_ONE_WORD_KEYS);
-
     ItclPreserveObject(ioPtr);
 
     /*
@@ -329,7 +485,7 @@ ItclCreateObject(
      * and set all the init values for variables
      */
 
-    if (ItclInitObjectVariables(interp, ioPtr, iclsPtr) != TCL_OK) {
+    if (ItclInitObjectVariables(interp, ioPtr, iclsPtr, planPtr) != TCL_OK) {
 	ioPtr->hadConstructorError = 11;    
 	result = TCL_ERROR;
         goto errorReturn;
@@ -457,6 +613,7 @@ ItclCreateObject(
     cmdInfo.deleteProc = (void *)ItclDestroyObject;
     cmdInfo.deleteData = ioPtr;
     Tcl_SetCommandInfoFromToken(ioPtr->accessCmd, &cmdInfo);
+    ItclSetObjectNameVars(ioPtr);
     ioPtr->resolvePtr = (Tcl_Resolve *)ckalloc(sizeof(Tcl_Resolve));
     ioPtr->resolvePtr->cmdProcPtr = Itcl_CmdAliasProc;
     ioPtr->resolvePtr->varProcPtr = Itcl_VarAliasProc;
@@ -477,6 +634,7 @@ ItclCreateObject(
     hPtr = Tcl_CreateHashEntry(&iclsPtr->infoPtr->objects,
         (char*)ioPtr, &newEntry);
     Tcl_SetHashValue(hPtr, (ClientData)ioPtr);
+    ItclAddInstance(ioPtr);
 
     /* Use the TclOO object namespaces as a unique key in case the
      * object is renamed. Used by mytypemethod, etc. */
@@ -496,8 +654,11 @@ ItclCreateObject(
      */
     ItclShowArgs(1, "OBJECTCONSTRUCTOR", objc, objv);
     ioPtr->hadConstructorError = 0;
-    result = Itcl_InvokeMethodIfExists(interp, "constructor",
-        iclsPtr, ioPtr, objc, objv);
+    if (hasConstructor || (iclsPtr->flags
+            & (ITCL_ECLASS|ITCL_TYPE|ITCL_WIDGET|ITCL_WIDGETADAPTOR))) {
+        result = Itcl_InvokeMethodIfExists(interp, "constructor",
+            iclsPtr, ioPtr, objc, objv);
+    }
     if (ioPtr->hadConstructorError) {
         result = TCL_ERROR;
     }
@@ -523,13 +684,12 @@ ItclCreateObject(
     /*
      *  If there is no constructor, construct the base classes
      *  in case they have constructors.  This will cause the
-     *  same chain reaction.
+     *  same chain reaction.  Nothing to do if none of the classes
+     *  has a constructor.
      */
-    objPtr = Tcl_NewStringObj("constructor", -1);
-    if (Tcl_FindHashEntry(&iclsPtr->functions, (char *)objPtr) == NULL) {
+    if (!hasConstructor && anyConstructor) {
         result = Itcl_ConstructBase(interp, ioPtr, iclsPtr);
     }
-    Tcl_DecrRefCount(objPtr);
 
     if (iclsPtr->flags & ITCL_ECLASS) {
         ItclInitExtendedClassOptions(interp, ioPtr);
@@ -641,6 +801,7 @@ ItclCreateObject(
         hPtr = Tcl_CreateHashEntry(&iclsPtr->infoPtr->objects,
                 (char*)ioPtr, &newEntry);
         Tcl_SetHashValue(hPtr, (ClientData)ioPtr);
+        ItclAddInstance(ioPtr);
 
 	/*
 	 * This is an inelegant hack, left behind until the need for it
@@ -694,15 +855,14 @@ ItclCreateObject(
      */
     /*
      *  At this point, the object is fully constructed.
-     *  Destroy the "constructed" table in the object data, since
+     *  Destroy the "constructed" bitmap in the object data, since
      *  it is no longer needed.
      */
     if (infoPtr != NULL) {
         infoPtr->currIoPtr = saveCurrIoPtr;
     }
     infoPtr->lastIoPtr = ioPtr;
-    Tcl_DeleteHashTable(ioPtr->constructed);
-    ckfree((char*)ioPtr->constructed);
+    ItclFreeBaseBits(ioPtr->constructed, ioPtr->constructedSpace);
     ioPtr->constructed = NULL;
     ItclAddObjectsDictInfo(interp, ioPtr);
     ItclReleaseObject(ioPtr);
@@ -711,7 +871,7 @@ ItclCreateObject(
 errorReturn:
     /*
      *  At this point, the object is not constructed as there was an error.
-     *  Destroy the "constructed" table in the object data, since
+     *  Destroy the "constructed" bitmap in the object data, since
      *  it is no longer needed.
      */
 	if (saveNsNamePtr) {
@@ -725,8 +885,7 @@ errorReturn:
         infoPtr->currIoPtr = saveCurrIoPtr;
     }
     if (ioPtr->constructed != NULL) {
-        Tcl_DeleteHashTable(ioPtr->constructed);
-        ckfree((char*)ioPtr->constructed);
+        ItclFreeBaseBits(ioPtr->constructed, ioPtr->constructedSpace);
         ioPtr->constructed = NULL;
     }
     ItclDeleteObjectVariablesNamespace(interp, ioPtr);
@@ -760,17 +919,16 @@ ItclInitObjectCommands(
     Tcl_Namespace *nsPtr;
     ItclClass *iclsPtr2;
     ItclClass *lastIclsPtr;
-    ItclHierIter hier;
     ItclMemberFunc *imPtr;
     ItclCmdLookup *clookup;
     ItclCmdLookup *info_clookup;
+    int hierIdx;
 
     info_clookup = NULL;
     lastIclsPtr = NULL;
     Tcl_ResetResult(interp);
-    Itcl_InitHierIter(&hier, iclsPtr);
-    iclsPtr2 = Itcl_AdvanceHierIter(&hier);
-    while (iclsPtr2 != NULL) {
+    for (hierIdx = 0; hierIdx < iclsPtr->numHierarchy; hierIdx++) {
+        iclsPtr2 = iclsPtr->hierarchy[hierIdx];
         entry = Tcl_FirstHashEntry(&iclsPtr2->functions, &place);
         while (entry) {
             imPtr = (ItclMemberFunc *)Tcl_GetHashValue(entry);
@@ -791,13 +949,11 @@ ItclInitObjectCommands(
             entry = Tcl_NextHashEntry(&place);
         }
         lastIclsPtr = iclsPtr2;
-        iclsPtr2 = Itcl_AdvanceHierIter(&hier);
     }
 
     /* add some builtin functions to every class!! */
-    Itcl_InitHierIter(&hier, iclsPtr);
-    iclsPtr2 = Itcl_AdvanceHierIter(&hier);
-    while (iclsPtr2 != NULL) {
+    for (hierIdx = 0; hierIdx < iclsPtr->numHierarchy; hierIdx++) {
+        iclsPtr2 = iclsPtr->hierarchy[hierIdx];
 	objPtr = Tcl_NewStringObj("info", -1);
 	hPtr = Tcl_FindHashEntry(&iclsPtr2->resolveCmds, objPtr);
 	Tcl_DecrRefCount(objPtr);
@@ -822,13 +978,144 @@ ItclInitObjectCommands(
 	    cmdPtr = Itcl_RegisterObjectCommand(interp, ioPtr, "setget",
 	            clookup->classCmdInfoPtr, cmdPtr, iclsPtr->nsPtr);
 	}
-        iclsPtr2 = Itcl_AdvanceHierIter(&hier);
     }
-    Itcl_DeleteHierIter(&hier);
 #endif
     return TCL_OK;
 }
 
+/*
+ * ------------------------------------------------------------------------
+ *  NewCompactVar()
+ *
+ *  Creates the variable for the data member "ivPtr" in the variable
+ *  table of an object with compact variable storage.  It is keyed by
+ *  the name it has in the ::itcl::internal::variables namespaces, so
+ *  "namespace which -variable" and traces report that name.
+ * ------------------------------------------------------------------------
+ */
+static Tcl_Var
+NewCompactVar(
+    ItclObject *ioPtr,
+    ItclVariable *ivPtr,
+    Tcl_Obj *valuePtr)
+{
+    Tcl_DString buffer;
+    Tcl_Var varPtr;
+
+    /* the table belongs to the global namespace, so skip the "::" */
+    Tcl_DStringInit(&buffer);
+    Tcl_DStringAppend(&buffer, Tcl_GetString(ioPtr->varNsNamePtr) + 2, -1);
+    Tcl_DStringAppend(&buffer, Tcl_GetString(ivPtr->fullNamePtr), -1);
+    varPtr = Itcl_NewTableVar(ioPtr->varTablePtr, Tcl_DStringValue(&buffer),
+            valuePtr);
+    Tcl_DStringFree(&buffer);
+    return varPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclInitCompactObjectVariables()
+ *
+ *  Creates the instance variables of an object of a class declared with
+ *  "varstorage compact".  The variables live in a table owned by the
+ *  object instead of the ::itcl::internal::variables namespaces, and
+ *  are only reachable through the object's variable slots.  Variables
+ *  which need more than an initial value are set up by name, linked
+ *  into a temporary call frame.
+ *
+ *  With "varstorage lazy" only those are created here, all others are
+ *  created by ItclGetObjectVar() when they are accessed first.
+ * ------------------------------------------------------------------------
+ */
+static int
+ItclInitCompactObjectVariables(
+   Tcl_Interp *interp,
+   ItclObject *ioPtr,
+   ItclInstancePlan *planPtr)
+{
+    Tcl_CallFrame frame;
+    Tcl_Var varPtr;
+    ItclPlanVar *pvPtr;
+    ItclPlanVar *endPtr;
+    ItclVariable *ivPtr;
+    const char *varName;
+    int framePushed;
+    int base;
+    int i;
+
+    ioPtr->varTablePtr = Itcl_NewVarTable(interp);
+    for (base = 0; base < planPtr->numBases; base++) {
+	/*
+	 *  The call frame for linking variables by name is only needed
+	 *  for "this" and array variables, and each class gets its own.
+	 */
+	framePushed = 0;
+	pvPtr = planPtr->vars + planPtr->firstVar[base];
+	endPtr = planPtr->vars + planPtr->firstVar[base + 1];
+	for ( ; pvPtr < endPtr; pvPtr++) {
+	    ivPtr = pvPtr->ivPtr;
+	    if (ivPtr->flags & ITCL_COMMON) {
+		if (pvPtr->commonVarPtr == NULL) {
+		    goto errorCleanup;
+		}
+		ItclSetObjectVar(ioPtr, ivPtr, pvPtr->commonVarPtr);
+		continue;
+	    }
+	    if (!(ivPtr->flags & ITCL_THIS_VAR)
+		    && (ivPtr->arrayInitPtr == NULL)) {
+		if (!(ioPtr->flags & ITCL_OBJECT_LAZY_VARS)) {
+		    varPtr = NewCompactVar(ioPtr, ivPtr, ivPtr->init);
+		    ItclSetObjectVar(ioPtr, ivPtr, varPtr);
+		}
+		/* else ItclGetObjectVar creates it on first access */
+		continue;
+	    }
+	    if (!framePushed) {
+		if (Itcl_PushCallFrame(interp, &frame,
+			Tcl_GetGlobalNamespace(interp),
+			/*isProcCallFrame*/1) != TCL_OK) {
+		    return TCL_ERROR;
+		}
+		framePushed = 1;
+	    }
+	    varPtr = NewCompactVar(ioPtr, ivPtr, NULL);
+	    ItclSetObjectVar(ioPtr, ivPtr, varPtr);
+	    varName = Tcl_GetString(ivPtr->namePtr);
+	    if (Itcl_UpVar(interp, varPtr, varName, 0) != TCL_OK) {
+		goto errorCleanup;
+	    }
+	    if (ivPtr->flags & ITCL_THIS_VAR) {
+		if (Tcl_SetVar2Ex(interp, varName, NULL,
+			ItclBuiltinVarValue(ioPtr, ivPtr), 0) == NULL) {
+		    goto errorCleanup;
+		}
+		Tcl_TraceVar2(interp, varName, NULL, TCL_TRACE_WRITES,
+			ItclTraceThisVar, (ClientData)ioPtr);
+		continue;
+	    }
+	    for (i = 0; i < ivPtr->arrayInitc; i += 2) {
+		if (Tcl_SetVar2Ex(interp, varName,
+			Tcl_GetString(ivPtr->arrayInitv[i]),
+			ivPtr->arrayInitv[i + 1], 0) == NULL) {
+		    Tcl_AppendStringsToObj(Tcl_GetObjResult(interp),
+			"cannot initialize variable \"", varName, "\"",
+			(char*)NULL);
+		    goto errorCleanup;
+		}
+	    }
+	}
+	if (framePushed) {
+	    Itcl_PopCallFrame(interp);
+	}
+    }
+    return TCL_OK;
+errorCleanup:
+    if (framePushed) {
+	Itcl_PopCallFrame(interp);
+    }
+    return TCL_ERROR;
+}
+
 /*
  * ------------------------------------------------------------------------
  *  ItclInitObjectVariables()
@@ -842,19 +1129,17 @@ static int
 ItclInitObjectVariables(
    Tcl_Interp *interp,
    ItclObject *ioPtr,
-   ItclClass *iclsPtr)
+   ItclClass *iclsPtr,
+   ItclInstancePlan *planPtr)
 {
     Tcl_DString buffer;
-    Tcl_DString buffer2;
-    Tcl_HashEntry *hPtr;
     Tcl_HashEntry *hPtr2;
-    Tcl_HashSearch place;
     Tcl_Namespace *varNsPtr;
-    Tcl_Namespace *varNsPtr2;
     Tcl_CallFrame frame;
     Tcl_Var varPtr;
     ItclClass *iclsPtr2;
-    ItclHierIter hier;
+    ItclPlanVar *pvPtr;
+    ItclPlanVar *endPtr;
     ItclVariable *ivPtr;
     ItclComponent *icPtr;
 #ifdef NEW_PROTO_RESOLVER
@@ -863,8 +1148,14 @@ ItclInitObjectVariables(
     const char *varName;
     const char *inheritComponentName;
     int itclOptionsIsSet;
+    int traceFlags;
     int isNew;
+    int prefixLen;
+    int base;
 
+    if (ioPtr->flags & ITCL_OBJECT_COMPACT_VARS) {
+        return ItclInitCompactObjectVariables(interp, ioPtr, planPtr);
+    }
     ivPtr = NULL;
     /*
      * create all the variables for each class in the
@@ -873,14 +1164,15 @@ ItclInitObjectVariables(
      */
     itclOptionsIsSet = 0;
     inheritComponentName = NULL;
-    Itcl_InitHierIter(&hier, iclsPtr);
-    iclsPtr2 = Itcl_AdvanceHierIter(&hier);
     Tcl_ResetResult(interp);
-    while (iclsPtr2 != NULL) {
-	Tcl_DStringInit(&buffer);
-	Tcl_DStringAppend(&buffer, ITCL_VARIABLES_NAMESPACE, -1);
-	Tcl_DStringAppend(&buffer,
-		(Tcl_GetObjectNamespace(ioPtr->oPtr))->fullName, -1);
+    Tcl_DStringInit(&buffer);
+    Tcl_DStringAppend(&buffer, ITCL_VARIABLES_NAMESPACE, -1);
+    Tcl_DStringAppend(&buffer,
+	    (Tcl_GetObjectNamespace(ioPtr->oPtr))->fullName, -1);
+    prefixLen = Tcl_DStringLength(&buffer);
+    for (base = 0; base < planPtr->numBases; base++) {
+	iclsPtr2 = iclsPtr->slotBases[base].iclsPtr;
+	Tcl_DStringSetLength(&buffer, prefixLen);
 	Tcl_DStringAppend(&buffer, iclsPtr2->nsPtr->fullName, -1);
 	varNsPtr = Tcl_FindNamespace(interp, Tcl_DStringValue(&buffer),
 	        NULL, 0);
@@ -893,52 +1185,24 @@ ItclInitObjectVariables(
                 /*isProcCallFrame*/0) != TCL_OK) {
 	    goto errorCleanup2;
         }
-        hPtr = Tcl_FirstHashEntry(&iclsPtr2->variables, &place);
-        while (hPtr) {
-            ivPtr = (ItclVariable*)Tcl_GetHashValue(hPtr);
+	pvPtr = planPtr->vars + planPtr->firstVar[base];
+	endPtr = planPtr->vars + planPtr->firstVar[base + 1];
+	for ( ; pvPtr < endPtr; pvPtr++) {
+            ivPtr = pvPtr->ivPtr;
 	    varName = Tcl_GetString(ivPtr->namePtr);
             if ((ivPtr->flags & ITCL_OPTIONS_VAR) && !itclOptionsIsSet) {
                 /* this is the special code for the "itcl_options" variable */
 		itclOptionsIsSet = 1;
-                Tcl_DStringInit(&buffer2);
-	        Tcl_DStringAppend(&buffer2, ITCL_VARIABLES_NAMESPACE, -1);
-		Tcl_DStringAppend(&buffer,
-			(Tcl_GetObjectNamespace(ioPtr->oPtr))->fullName, -1);
-	        varNsPtr2 = Tcl_FindNamespace(interp,
-		        Tcl_DStringValue(&buffer2), NULL, 0);
-	        if (varNsPtr2 == NULL) {
-	            varNsPtr2 = Tcl_CreateNamespace(interp,
-		            Tcl_DStringValue(&buffer2), NULL, 0);
-	        }
-                Tcl_DStringFree(&buffer2);
-	        Itcl_PopCallFrame(interp);
-	        /* now initialize the variables which have an init value */
-                if (Itcl_PushCallFrame(interp, &frame, varNsPtr2,
-                        /*isProcCallFrame*/0) != TCL_OK) {
-		    goto errorCleanup2;
-                }
-                Tcl_TraceVar2(interp, "itcl_options",
-                        NULL,
-                        TCL_TRACE_READS|TCL_TRACE_WRITES,
-                        ItclTraceOptionVar, (ClientData)ioPtr);
-	        Itcl_PopCallFrame(interp);
-                if (Itcl_PushCallFrame(interp, &frame, varNsPtr,
-                        /*isProcCallFrame*/0) != TCL_OK) {
-		    goto errorCleanup2;
-                }
-                hPtr = Tcl_NextHashEntry(&place);
 	        continue;
             }
             if (ivPtr->flags & ITCL_COMPONENT_VAR) {
-		hPtr2 = Tcl_FindHashEntry(&ivPtr->iclsPtr->components,
-		        (char *)ivPtr->namePtr);
-		if (hPtr2 == NULL) {
+		icPtr = pvPtr->icPtr;
+		if (icPtr == NULL) {
 		    Tcl_AppendResult(interp, "cannot find component \"",
 		            Tcl_GetString(ivPtr->namePtr), "\" in class \"",
 			    Tcl_GetString(ivPtr->iclsPtr->namePtr), NULL);
 		    goto errorCleanup;
 		}
-		icPtr = Tcl_GetHashValue(hPtr2);
 		if (icPtr->flags & ITCL_COMPONENT_INHERIT) {
 		    if (inheritComponentName != NULL) {
 		        Tcl_AppendResult(interp, "object \"",
@@ -954,7 +1218,8 @@ ItclInitObjectVariables(
 		        inheritComponentName = Tcl_GetString(icPtr->namePtr);
 		    }
 		}
-                hPtr2 = Tcl_CreateHashEntry(&ioPtr->objectComponents,
+                hPtr2 = Tcl_CreateHashEntry(
+                        ITCL_OBJECT_TABLE_FOR_WRITE(ioPtr, objectComponents),
                         (char *)ivPtr->namePtr, &isNew);
 		if (isNew) {
 		    Tcl_SetHashValue(hPtr2, icPtr);
@@ -969,12 +1234,11 @@ ItclInitObjectVariables(
 		    goto errorCleanup;
                 }
 	    }
-            hPtr2 = Tcl_FindHashEntry(&ivPtr->iclsPtr->resolveVars, varName);
-            if (hPtr2 == NULL) {
-                hPtr = Tcl_NextHashEntry(&place);
+            if (!pvPtr->isResolved) {
 	        continue;
             }
 #ifdef NEW_PROTO_RESOLVER
+            hPtr2 = Tcl_FindHashEntry(&ivPtr->iclsPtr->resolveVars, varName);
 	    vlookup = Tcl_GetHashValue(hPtr2);
 #endif
 	    if ((ivPtr->flags & ITCL_COMMON) == 0) {
@@ -986,127 +1250,78 @@ ItclInitObjectVariables(
 		        Tcl_GetString(ivPtr->namePtr), vlookup->classVarInfoPtr,
 			NULL, varNsPtr);
 #endif
-	        hPtr2 = Tcl_CreateHashEntry(&ioPtr->objectVariables,
-		        (char *)ivPtr, &isNew);
-	        if (isNew) {
-		    Itcl_PreserveVar(varPtr);
-		    Tcl_SetHashValue(hPtr2, varPtr);
-		} else {
-		}
+	        ItclSetObjectVar(ioPtr, ivPtr, varPtr);
 	        if (ivPtr->flags & (ITCL_THIS_VAR|ITCL_TYPE_VAR|
 		        ITCL_SELF_VAR|ITCL_SELFNS_VAR|ITCL_WIN_VAR)) {
-                    int isDone = 0;
-		    if (Tcl_SetVar2(interp, varName, NULL,
-		        "", TCL_NAMESPACE_ONLY) == NULL) {
+		    if (Tcl_SetVar2Ex(interp, varName, NULL,
+		            ItclBuiltinVarValue(ioPtr, ivPtr),
+			    TCL_NAMESPACE_ONLY) == NULL) {
                         Tcl_AppendResult(interp, "INTERNAL ERROR cannot set",
 			        " variable \"", varNsPtr->fullName, "::",
 				varName, "\"\n", NULL);
 		        goto errorCleanup;
 	            }
-	        if (ivPtr->flags & ITCL_THIS_VAR) {
-	            Tcl_TraceVar2(interp, varName, NULL,
-		        TCL_TRACE_READS|TCL_TRACE_WRITES, ItclTraceThisVar,
-		        (ClientData)ioPtr);
-                    isDone = 1;
-		}
-	        if (!isDone && ivPtr->flags & ITCL_TYPE_VAR) {
-	            Tcl_TraceVar2(interp, varName, NULL,
-		        TCL_TRACE_READS|TCL_TRACE_WRITES, ItclTraceTypeVar,
-		        (ClientData)ioPtr);
-                    isDone = 1;
-		}
-	        if (!isDone && ivPtr->flags & ITCL_SELF_VAR) {
-	            Tcl_TraceVar2(interp, varName, NULL,
-		        TCL_TRACE_READS|TCL_TRACE_WRITES, ItclTraceSelfVar,
-		        (ClientData)ioPtr);
-                    isDone = 1;
-		}
-	        if (!isDone && ivPtr->flags & ITCL_SELFNS_VAR) {
-	            Tcl_TraceVar2(interp, varName, NULL,
-		        TCL_TRACE_READS|TCL_TRACE_WRITES, ItclTraceSelfnsVar,
-		        (ClientData)ioPtr);
-                    isDone = 1;
-		}
-	        if (!isDone && ivPtr->flags & ITCL_WIN_VAR) {
-	            Tcl_TraceVar2(interp, varName, NULL,
-		        TCL_TRACE_READS|TCL_TRACE_WRITES, ItclTraceWinVar,
-		        (ClientData)ioPtr);
-                    isDone = 1;
-		}
+		    /*
+		     *  Only "self" of a widget follows the "itcl_hull"
+		     *  variable, all others are just guarded against writes.
+		     */
+		    traceFlags = TCL_TRACE_WRITES;
+		    if ((ivPtr->flags & ITCL_SELF_VAR) && (iclsPtr->flags
+		            & (ITCL_WIDGET|ITCL_WIDGETADAPTOR))) {
+		        traceFlags |= TCL_TRACE_READS;
+		    }
+		    /* "type" is restored from the class it belongs to */
+	            Tcl_TraceVar2(interp, varName, NULL, traceFlags,
+		            pvPtr->traceProc, (ivPtr->flags & ITCL_TYPE_VAR)
+			    ? (ClientData)ivPtr->iclsPtr : (ClientData)ioPtr);
 		} else {
-	            if (ivPtr->flags & ITCL_HULL_VAR) {
+	            if (pvPtr->traceProc != NULL) {
 	                Tcl_TraceVar2(interp, varName, NULL,
-		            TCL_TRACE_READS|TCL_TRACE_WRITES,
-			    ItclTraceItclHullVar,
+		            TCL_TRACE_WRITES, pvPtr->traceProc,
 		            (ClientData)ioPtr);
 		    } else {
 	              if (ivPtr->init != NULL) {
-			if (Tcl_SetVar(interp,
-			        Tcl_GetString(ivPtr->namePtr),
-			        Tcl_GetString(ivPtr->init),
+			/* all objects share the init value until written */
+			if (Tcl_SetVar2Ex(interp, varName, NULL, ivPtr->init,
 				TCL_NAMESPACE_ONLY) == NULL) {
 			    goto errorCleanup;
 	                }
 	              }
-	              if (ivPtr->arrayInitPtr != NULL) {
-			Tcl_DString buffer3;
+	              if (ivPtr->arrayInitv != NULL) {
 	                int i;
-	                int argc;
-	                const char **argv;
-	                const char *val;
-
-			Tcl_DStringInit(&buffer3);
-                        Tcl_DStringAppend(&buffer3, varNsPtr->fullName, -1);
-                        Tcl_DStringAppend(&buffer3, "::", -1);
-                        Tcl_DStringAppend(&buffer3,
-			        Tcl_GetString(ivPtr->namePtr), -1);
-	                Tcl_SplitList(interp,
-			        Tcl_GetString(ivPtr->arrayInitPtr),
-	                        &argc, &argv);
-	                for (i = 0; i < argc; i++) {
-                            val = Tcl_SetVar2(interp,
-			            Tcl_DStringValue(&buffer3), argv[i],
-                                    argv[i + 1], TCL_NAMESPACE_ONLY);
-                            if (!val) {
+
+	                for (i = 0; i < ivPtr->arrayInitc; i += 2) {
+                            if (Tcl_SetVar2Ex(interp, varName,
+			            Tcl_GetString(ivPtr->arrayInitv[i]),
+                                    ivPtr->arrayInitv[i + 1],
+				    TCL_NAMESPACE_ONLY) == NULL) {
                                 Tcl_AppendStringsToObj(Tcl_GetObjResult(interp),
                                     "cannot initialize variable \"",
                                     Tcl_GetString(ivPtr->namePtr), "\"",
                                     (char*)NULL);
-                                return TCL_ERROR;
+			        goto errorCleanup;
                             }
-	                    i++;
                         }
-			Tcl_DStringFree(&buffer3);
-		        ckfree((char *)argv);
-		        }
+		      }
 		      }
 		    }
 	        } else {
 	            if (ivPtr->flags & ITCL_HULL_VAR) {
 	                Tcl_TraceVar2(interp, varName, NULL,
-		            TCL_TRACE_READS|TCL_TRACE_WRITES,
-			    ItclTraceItclHullVar,
+		            TCL_TRACE_WRITES, ItclTraceItclHullVar,
 		            (ClientData)ioPtr);
 		    }
-	            hPtr2 = Tcl_FindHashEntry(&iclsPtr2->classCommons,
-		            (char *)ivPtr);
-		    if (hPtr2 == NULL) {
+		    varPtr = pvPtr->commonVarPtr;
+		    if (varPtr == NULL) {
 		        goto errorCleanup;
 		    }
-		    varPtr = Tcl_GetHashValue(hPtr2);
-	            hPtr2 = Tcl_CreateHashEntry(&ioPtr->objectVariables,
-		            (char *)ivPtr, &isNew);
-	            if (isNew) {
-			Itcl_PreserveVar(varPtr);
-		        Tcl_SetHashValue(hPtr2, varPtr);
-		    } else {
+	            ItclSetObjectVar(ioPtr, ivPtr, varPtr);
 #ifdef NEW_PROTO_RESOLVER
 		    varPtr = Itcl_RegisterObjectVariable(interp, ioPtr,
 		            Tcl_GetString(ivPtr->namePtr),
 			    vlookup->classVarInfoPtr,
 			    varPtr, varNsPtr);
 #endif
-	        }
 	        if (ivPtr->flags & ITCL_COMPONENT_VAR) {
 	            if (ivPtr->flags & ITCL_COMMON) {
                         Tcl_Obj *objPtr2;
@@ -1137,17 +1352,15 @@ ItclInitObjectVariables(
 	            }
 	        }
 	    }
-            hPtr = Tcl_NextHashEntry(&place);
         }
 	Itcl_PopCallFrame(interp);
-        iclsPtr2 = Itcl_AdvanceHierIter(&hier);
     }
     Tcl_DStringFree(&buffer);
-    Itcl_DeleteHierIter(&hier);
     return TCL_OK;
 errorCleanup:
     Itcl_PopCallFrame(interp);
 errorCleanup2:
+    Tcl_DStringFree(&buffer);
     varNsPtr = Tcl_FindNamespace(interp, Tcl_GetString(ioPtr->varNsNamePtr),
             NULL, 0);
     if (varNsPtr != NULL) {
@@ -1183,20 +1396,20 @@ ItclInitObjectOptions(
     Tcl_CallFrame frame;
     Tcl_Namespace *varNsPtr;
     ItclClass *iclsPtr2;
-    ItclHierIter hier;
     ItclOption *ioptPtr;
     ItclDelegatedOption *idoPtr;
+    int hierIdx;
     int isNew;
 
     ioptPtr = NULL;
-    Itcl_InitHierIter(&hier, iclsPtr);
-    iclsPtr2 = Itcl_AdvanceHierIter(&hier);
-    while (iclsPtr2 != NULL) {
+    for (hierIdx = 0; hierIdx < iclsPtr->numHierarchy; hierIdx++) {
+        iclsPtr2 = iclsPtr->hierarchy[hierIdx];
 	/* now initialize the options which have an init value */
         hPtr = Tcl_FirstHashEntry(&iclsPtr2->options, &place);
         while (hPtr) {
             ioptPtr = (ItclOption*)Tcl_GetHashValue(hPtr);
-	    hPtr2 = Tcl_CreateHashEntry(&ioPtr->objectOptions,
+	    hPtr2 = Tcl_CreateHashEntry(
+                    ITCL_OBJECT_TABLE_FOR_WRITE(ioPtr, objectOptions),
 	            (char *)ioptPtr->namePtr, &isNew);
 	    if (isNew) {
 		Tcl_SetHashValue(hPtr2, ioptPtr);
@@ -1225,10 +1438,6 @@ ItclInitObjectOptions(
 	                Itcl_PopCallFrame(interp);
 		        return TCL_ERROR;
                     }
-                    Tcl_TraceVar2(interp, "itcl_options",
-                            NULL,
-                            TCL_TRACE_READS|TCL_TRACE_WRITES,
-                            ItclTraceOptionVar, (ClientData)ioPtr);
 		}
 	        Itcl_PopCallFrame(interp);
             }
@@ -1238,16 +1447,15 @@ ItclInitObjectOptions(
         hPtr = Tcl_FirstHashEntry(&iclsPtr2->delegatedOptions, &place);
         while (hPtr) {
             idoPtr = (ItclDelegatedOption*)Tcl_GetHashValue(hPtr);
-	    hPtr2 = Tcl_CreateHashEntry(&ioPtr->objectDelegatedOptions,
+	    hPtr2 = Tcl_CreateHashEntry(
+                    ITCL_OBJECT_TABLE_FOR_WRITE(ioPtr, objectDelegatedOptions),
 	            (char *)idoPtr->namePtr, &isNew);
 	    if (isNew) {
 		Tcl_SetHashValue(hPtr2, idoPtr);
 	    }
             hPtr = Tcl_NextHashEntry(&place);
         }
-        iclsPtr2 = Itcl_AdvanceHierIter(&hier);
     }
-    Itcl_DeleteHierIter(&hier);
     return TCL_OK;
 }
 
@@ -1269,150 +1477,724 @@ ItclInitObjectMethodVariables(
    const char *name)
 {
     ItclClass *iclsPtr2;
-    ItclHierIter hier;
     ItclMethodVariable *imvPtr;
     Tcl_HashEntry *hPtr;
     Tcl_HashEntry *hPtr2;
     Tcl_HashSearch place;
+    int hierIdx;
     int isNew;
 
     imvPtr = NULL;
-    Itcl_InitHierIter(&hier, iclsPtr);
-    iclsPtr2 = Itcl_AdvanceHierIter(&hier);
-    while (iclsPtr2 != NULL) {
+    for (hierIdx = 0; hierIdx < iclsPtr->numHierarchy; hierIdx++) {
+        iclsPtr2 = iclsPtr->hierarchy[hierIdx];
         hPtr = Tcl_FirstHashEntry(&iclsPtr2->methodVariables, &place);
         while (hPtr) {
             imvPtr = (ItclMethodVariable*)Tcl_GetHashValue(hPtr);
-	    hPtr2 = Tcl_CreateHashEntry(&ioPtr->objectMethodVariables,
+	    hPtr2 = Tcl_CreateHashEntry(
+                    ITCL_OBJECT_TABLE_FOR_WRITE(ioPtr, objectMethodVariables),
 	            (char *)imvPtr->namePtr, &isNew);
 	    if (isNew) {
 		Tcl_SetHashValue(hPtr2, imvPtr);
             }
             hPtr = Tcl_NextHashEntry(&place);
         }
-        iclsPtr2 = Itcl_AdvanceHierIter(&hier);
     }
-    Itcl_DeleteHierIter(&hier);
     return TCL_OK;
 }
 
 /*
  * ------------------------------------------------------------------------
- *  Itcl_DeleteObject()
+ *  ItclAddInstance()
  *
- *  Attempts to delete an object by invoking its destructor.
- *
- *  If the destructor is successful, then the object is deleted by
- *  removing its access command, and this procedure returns TCL_OK.
- *  Otherwise, the object will remain alive, and this procedure
- *  returns TCL_ERROR (along with an error message in the interpreter).
+ *  Appends an object to the instance list of its most-specific class,
+ *  so that the instances of a class can be found without scanning all
+ *  objects of the interpreter.  An object is listed while it is in
+ *  the global object list.
  * ------------------------------------------------------------------------
  */
-int
-Itcl_DeleteObject(
-    Tcl_Interp *interp,      /* interpreter mananging object */
-    ItclObject *contextIoPtr)  /* object to be deleted */
+void
+ItclAddInstance(
+    ItclObject *ioPtr)
 {
-    Tcl_CmdInfo cmdInfo;
-    Tcl_HashEntry *hPtr;
-
-
-    Tcl_GetCommandInfoFromToken(contextIoPtr->accessCmd, &cmdInfo);
-
-    contextIoPtr->flags |= ITCL_OBJECT_IS_DELETED;
-    ItclPreserveObject(contextIoPtr);
-
-    /*
-     *  Invoke the object's destructors.
-     */
-    if (Itcl_DestructObject(interp, contextIoPtr, 0) != TCL_OK) {
-	ItclReleaseObject(contextIoPtr);
-	contextIoPtr->flags |=
-	        ITCL_TCLOO_OBJECT_IS_DELETED|ITCL_OBJECT_DESTRUCT_ERROR;
-        return TCL_ERROR;
-    }
-    /*
-     *  Remove the object from the global list.
-     */
-    hPtr = Tcl_FindHashEntry(&contextIoPtr->infoPtr->objects,
-        (char*)contextIoPtr);
+    ItclClass *iclsPtr = ioPtr->iclsPtr;
 
-    if (hPtr) {
-        Tcl_DeleteHashEntry(hPtr);
+    if (ioPtr->flags & ITCL_OBJECT_IS_INSTANCE) {
+        return;
     }
-
-    /*
-     *  Change the object's access command so that it can be
-     *  safely deleted without attempting to destruct the object
-     *  again.  Then delete the access command.  If this is
-     *  the last use of the object data, the object will die here.
-     */
-    if ((contextIoPtr->accessCmd != NULL) && (!(contextIoPtr->flags &
-            (ITCL_OBJECT_IS_RENAMED)))) {
-    if (Tcl_GetCommandInfoFromToken(contextIoPtr->accessCmd, &cmdInfo) == 1) {
-        cmdInfo.deleteProc = ItclReleaseObject;
-	Tcl_SetCommandInfoFromToken(contextIoPtr->accessCmd, &cmdInfo);
-
-        Tcl_DeleteCommandFromToken(interp, contextIoPtr->accessCmd);
+    ioPtr->flags |= ITCL_OBJECT_IS_INSTANCE;
+    ioPtr->nextInstancePtr = NULL;
+    ioPtr->prevInstancePtr = iclsPtr->lastInstancePtr;
+    if (iclsPtr->lastInstancePtr != NULL) {
+        iclsPtr->lastInstancePtr->nextInstancePtr = ioPtr;
+    } else {
+        iclsPtr->firstInstancePtr = ioPtr;
     }
+    iclsPtr->lastInstancePtr = ioPtr;
+    iclsPtr->numInstances++;
+    if (iclsPtr->numInstances > iclsPtr->maxInstances) {
+        iclsPtr->maxInstances = iclsPtr->numInstances;
     }
-    contextIoPtr->oPtr = NULL;
-    contextIoPtr->accessCmd = NULL;
-
-    ItclReleaseObject(contextIoPtr);
-
-    return TCL_OK;
 }
-
+
 /*
  * ------------------------------------------------------------------------
- *  ItclDeleteObjectVariablesNamespace()
+ *  ItclRemoveInstance()
  *
+ *  Takes an object out of the instance list of its class again.  Does
+ *  nothing if the object is not listed.
  * ------------------------------------------------------------------------
  */
 void
-ItclDeleteObjectVariablesNamespace(
-    Tcl_Interp *interp,
+ItclRemoveInstance(
     ItclObject *ioPtr)
 {
-    Tcl_Namespace *varNsPtr;
+    ItclClass *iclsPtr = ioPtr->iclsPtr;
 
-    if (ioPtr->callRefCount < 1) {
-        /* free the object's variables namespace and variables in it */
-	ioPtr->flags &= ~ITCL_OBJECT_SHOULD_VARNS_DELETE;
-        varNsPtr = Tcl_FindNamespace(interp, Tcl_GetString(ioPtr->varNsNamePtr),
-	        NULL, 0);
-        if (varNsPtr != NULL) {
-            Tcl_DeleteNamespace(varNsPtr);
-        }
+    if (!(ioPtr->flags & ITCL_OBJECT_IS_INSTANCE)) {
+        return;
+    }
+    ioPtr->flags &= ~ITCL_OBJECT_IS_INSTANCE;
+    if (ioPtr->prevInstancePtr != NULL) {
+        ioPtr->prevInstancePtr->nextInstancePtr = ioPtr->nextInstancePtr;
     } else {
-        ioPtr->flags |= ITCL_OBJECT_SHOULD_VARNS_DELETE;
+        iclsPtr->firstInstancePtr = ioPtr->nextInstancePtr;
     }
-}
-
-static int
-FinalizeDeleteObject(
-    ClientData data[],
-    Tcl_Interp *interp,
-    int result)
-{
-    ItclObject *contextIoPtr = data[0];
-    if (result == TCL_OK) {
-	ItclDeleteObjectVariablesNamespace(interp, contextIoPtr);
-        Tcl_ResetResult(interp);
+    if (ioPtr->nextInstancePtr != NULL) {
+        ioPtr->nextInstancePtr->prevInstancePtr = ioPtr->prevInstancePtr;
+    } else {
+        iclsPtr->lastInstancePtr = ioPtr->prevInstancePtr;
     }
-
-    Tcl_DeleteHashTable(contextIoPtr->destructed);
-    ckfree((char*)contextIoPtr->destructed);
-    contextIoPtr->destructed = NULL;
-    return result;
+    ioPtr->prevInstancePtr = NULL;
+    ioPtr->nextInstancePtr = NULL;
+    iclsPtr->numInstances--;
 }
 
-static int
-CallDestructBase(
-    ClientData data[],
-    Tcl_Interp *interp,
-    int result)
+/*
+ * ------------------------------------------------------------------------
+ *  ItclGetInstancePlan()
+ *
+ *  Returns the instantiation plan of a class, making it first if there
+ *  is none, see ItclInvalidateInstancePlans.
+ *  The plan lists the data members of all classes in the hierarchy
+ *  together with the traces, common variables and components they
+ *  need, so that creating an object does no lookups by name.
+ * ------------------------------------------------------------------------
+ */
+ItclInstancePlan *
+ItclGetInstancePlan(
+    ItclClass *iclsPtr)
+{
+    Tcl_HashEntry *hPtr;
+    Tcl_HashSearch place;
+    Tcl_Obj *ctorPtr;
+    Tcl_Obj *dtorPtr;
+    ItclInstancePlan *planPtr;
+    ItclPlanVar *pvPtr;
+    ItclClass *iclsPtr2;
+    ItclVariable *ivPtr;
+    int numBytes;
+    int i;
+
+    planPtr = iclsPtr->planPtr;
+    if (planPtr != NULL) {
+        return planPtr;
+    }
+    if (iclsPtr->slotBases == NULL) {
+        Itcl_BuildVirtualTables(iclsPtr);
+    }
+
+    numBytes = ITCL_BASE_BITS_SIZE(iclsPtr->numSlotBases);
+    planPtr = (ItclInstancePlan *)ckalloc(sizeof(ItclInstancePlan));
+    planPtr->numBases = iclsPtr->numSlotBases;
+    planPtr->firstVar = (int *)ckalloc((planPtr->numBases + 1) * sizeof(int));
+    planPtr->hasConstructor = (unsigned char *)ckalloc(2 * numBytes);
+    planPtr->hasDestructor = planPtr->hasConstructor + numBytes;
+    memset(planPtr->hasConstructor, 0, 2 * numBytes);
+    planPtr->anyConstructor = 0;
+    planPtr->numVars = 0;
+    for (i = 0; i < planPtr->numBases; i++) {
+        planPtr->numVars += iclsPtr->slotBases[i].iclsPtr->variables.numEntries;
+    }
+    planPtr->vars = (ItclPlanVar *)ckalloc(
+            (planPtr->numVars + 1) * sizeof(ItclPlanVar));
+
+    ctorPtr = Tcl_NewStringObj("constructor", -1);
+    dtorPtr = Tcl_NewStringObj("destructor", -1);
+    pvPtr = planPtr->vars;
+    for (i = 0; i < planPtr->numBases; i++) {
+        iclsPtr2 = iclsPtr->slotBases[i].iclsPtr;
+        if (Tcl_FindHashEntry(&iclsPtr2->functions, (char *)ctorPtr)) {
+            ITCL_BASE_BIT_SET(planPtr->hasConstructor, i);
+            planPtr->anyConstructor = 1;
+        }
+        if (Tcl_FindHashEntry(&iclsPtr2->functions, (char *)dtorPtr)) {
+            ITCL_BASE_BIT_SET(planPtr->hasDestructor, i);
+        }
+        planPtr->firstVar[i] = pvPtr - planPtr->vars;
+        hPtr = Tcl_FirstHashEntry(&iclsPtr2->variables, &place);
+        while (hPtr) {
+            ivPtr = (ItclVariable*)Tcl_GetHashValue(hPtr);
+            hPtr = Tcl_NextHashEntry(&place);
+            pvPtr->ivPtr = ivPtr;
+            pvPtr->traceProc = NULL;
+            pvPtr->commonVarPtr = NULL;
+            pvPtr->icPtr = NULL;
+            if (ivPtr->flags & ITCL_THIS_VAR) {
+                pvPtr->traceProc = ItclTraceThisVar;
+            } else if (ivPtr->flags & ITCL_TYPE_VAR) {
+                pvPtr->traceProc = ItclTraceTypeVar;
+            } else if (ivPtr->flags & ITCL_SELF_VAR) {
+                pvPtr->traceProc = ItclTraceSelfVar;
+            } else if (ivPtr->flags & ITCL_SELFNS_VAR) {
+                pvPtr->traceProc = ItclTraceSelfnsVar;
+            } else if (ivPtr->flags & ITCL_WIN_VAR) {
+                pvPtr->traceProc = ItclTraceWinVar;
+            } else if (ivPtr->flags & ITCL_HULL_VAR) {
+                pvPtr->traceProc = ItclTraceItclHullVar;
+            }
+            if (ivPtr->flags & ITCL_COMMON) {
+                Tcl_HashEntry *hPtr2;
+
+                hPtr2 = Tcl_FindHashEntry(&iclsPtr2->classCommons,
+                        (char *)ivPtr);
+                if (hPtr2 != NULL) {
+                    pvPtr->commonVarPtr = Tcl_GetHashValue(hPtr2);
+                }
+            }
+            if (ivPtr->flags & ITCL_COMPONENT_VAR) {
+                Tcl_HashEntry *hPtr2;
+
+                hPtr2 = Tcl_FindHashEntry(&ivPtr->iclsPtr->components,
+                        (char *)ivPtr->namePtr);
+                if (hPtr2 != NULL) {
+                    pvPtr->icPtr = Tcl_GetHashValue(hPtr2);
+                }
+            }
+            pvPtr->isResolved = (Tcl_FindHashEntry(&ivPtr->iclsPtr->resolveVars,
+                    Tcl_GetString(ivPtr->namePtr)) != NULL);
+            pvPtr++;
+        }
+    }
+    planPtr->firstVar[planPtr->numBases] = pvPtr - planPtr->vars;
+
+    planPtr->numNameVars = 0;
+    for (i = 0; i < planPtr->numVars; i++) {
+        if (planPtr->vars[i].ivPtr->flags & (ITCL_THIS_VAR|ITCL_SELF_VAR)) {
+	    planPtr->numNameVars++;
+	}
+    }
+    planPtr->nameVars = (ItclVariable **)ckalloc(
+            (planPtr->numNameVars + 1) * sizeof(ItclVariable *));
+    planPtr->numNameVars = 0;
+    for (i = 0; i < planPtr->numVars; i++) {
+        ivPtr = planPtr->vars[i].ivPtr;
+        if (ivPtr->flags & (ITCL_THIS_VAR|ITCL_SELF_VAR)) {
+	    planPtr->nameVars[planPtr->numNameVars++] = ivPtr;
+	}
+    }
+    Tcl_DecrRefCount(ctorPtr);
+    Tcl_DecrRefCount(dtorPtr);
+    iclsPtr->planPtr = planPtr;
+    return planPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclFreeInstancePlan()
+ *
+ *  Throws away the instantiation plan of a class, if it has one.
+ * ------------------------------------------------------------------------
+ */
+void
+ItclFreeInstancePlan(
+    ItclClass *iclsPtr)
+{
+    ItclInstancePlan *planPtr = iclsPtr->planPtr;
+
+    if (planPtr == NULL) {
+        return;
+    }
+    iclsPtr->planPtr = NULL;
+    ckfree((char *)planPtr->firstVar);
+    ckfree((char *)planPtr->hasConstructor);
+    ckfree((char *)planPtr->vars);
+    ckfree((char *)planPtr->nameVars);
+    ckfree((char *)planPtr);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclInvalidateInstancePlans()
+ *
+ *  Throws away the instantiation plans of a class and of all classes
+ *  derived from it, after the class got new members.  The plans of
+ *  unrelated classes stay valid.
+ * ------------------------------------------------------------------------
+ */
+void
+ItclInvalidateInstancePlans(
+    ItclClass *iclsPtr)
+{
+    Itcl_ListElem *elem;
+
+    ItclFreeInstancePlan(iclsPtr);
+    elem = Itcl_FirstListElem(&iclsPtr->derived);
+    while (elem != NULL) {
+        ItclInvalidateInstancePlans((ItclClass *)Itcl_GetListValue(elem));
+        elem = Itcl_NextListElem(elem);
+    }
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclBaseIndex()
+ *
+ *  Returns the position of "baseClsPtr" in the hierarchy of "iclsPtr",
+ *  the index of its entry in iclsPtr->slotBases, or -1 if it is not a
+ *  base class of "iclsPtr" (or "iclsPtr" itself).
+ * ------------------------------------------------------------------------
+ */
+int
+ItclBaseIndex(
+    ItclClass *iclsPtr,
+    ItclClass *baseClsPtr)
+{
+    int i;
+
+    for (i = 0; i < iclsPtr->numSlotBases; i++) {
+        if (iclsPtr->slotBases[i].iclsPtr == baseClsPtr) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclNewBaseBits()
+ *
+ *  Returns a cleared bitmap with one bit for each class in the hierarchy
+ *  of an object, such as ItclObject.constructed.  Uses the storage at
+ *  "space" unless the hierarchy has more than ITCL_INLINE_BASE_BITS
+ *  classes.  Free it with ItclFreeBaseBits().
+ * ------------------------------------------------------------------------
+ */
+unsigned char *
+ItclNewBaseBits(
+    ItclObject *ioPtr,
+    unsigned char *space)
+{
+    unsigned char *bits = space;
+    int numBytes;
+
+    numBytes = ITCL_BASE_BITS_SIZE(ioPtr->iclsPtr->numSlotBases);
+    if (ioPtr->iclsPtr->numSlotBases > ITCL_INLINE_BASE_BITS) {
+        bits = (unsigned char *)ckalloc(numBytes);
+    }
+    memset(bits, 0, numBytes);
+    return bits;
+}
+
+void
+ItclFreeBaseBits(
+    unsigned char *bits,
+    unsigned char *space)
+{
+    if (bits != space) {
+        ckfree((char *)bits);
+    }
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclGetObjectTables()
+ *
+ *  Returns the option, component and delegation tables of an object,
+ *  creating them when the first entry is about to be added.  Use the
+ *  ITCL_OBJECT_TABLE macro for lookups, it does not allocate.
+ * ------------------------------------------------------------------------
+ */
+ItclObjectTables *
+ItclGetObjectTables(
+    ItclObject *ioPtr)
+{
+    ItclObjectTables *tablesPtr;
+
+    tablesPtr = ioPtr->tablesPtr;
+    if (tablesPtr == NULL) {
+        tablesPtr = (ItclObjectTables *)ckalloc(sizeof(ItclObjectTables));
+        Tcl_InitObjHashTable(&tablesPtr->objectOptions);
+        Tcl_InitObjHashTable(&tablesPtr->objectComponents);
+        Tcl_InitObjHashTable(&tablesPtr->objectMethodVariables);
+        Tcl_InitObjHashTable(&tablesPtr->objectDelegatedOptions);
+        Tcl_InitObjHashTable(&tablesPtr->objectDelegatedFunctions);
+	ioPtr->tablesPtr = tablesPtr;
+    }
+    return tablesPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  Itcl_DeleteObject()
+ *
+ *  Attempts to delete an object by invoking its destructor.
+ *
+ *  If the destructor is successful, then the object is deleted by
+ *  removing its access command, and this procedure returns TCL_OK.
+ *  Otherwise, the object will remain alive, and this procedure
+ *  returns TCL_ERROR (along with an error message in the interpreter).
+ * ------------------------------------------------------------------------
+ */
+int
+Itcl_DeleteObject(
+    Tcl_Interp *interp,      /* interpreter mananging object */
+    ItclObject *contextIoPtr)  /* object to be deleted */
+{
+    Tcl_CmdInfo cmdInfo;
+
+
+    Tcl_GetCommandInfoFromToken(contextIoPtr->accessCmd, &cmdInfo);
+
+    contextIoPtr->flags |= ITCL_OBJECT_IS_DELETED;
+    ItclPreserveObject(contextIoPtr);
+
+    /*
+     *  Invoke the object's destructors.
+     */
+    if (Itcl_DestructObject(interp, contextIoPtr, 0) != TCL_OK) {
+	ItclReleaseObject(contextIoPtr);
+	contextIoPtr->flags |=
+	        ITCL_TCLOO_OBJECT_IS_DELETED|ITCL_OBJECT_DESTRUCT_ERROR;
+        return TCL_ERROR;
+    }
+    ItclRemoveDestructedObject(interp, contextIoPtr);
+    ItclReleaseObject(contextIoPtr);
+
+    return TCL_OK;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclRemoveDestructedObject()
+ *
+ *  Second half of Itcl_DeleteObject():  takes an object whose
+ *  destructors have run out of the object registry and deletes its
+ *  access command.  The caller must hold a reference to the object.
+ * ------------------------------------------------------------------------
+ */
+static void
+ItclRemoveDestructedObject(
+    Tcl_Interp *interp,      /* interpreter mananging object */
+    ItclObject *contextIoPtr)  /* object to be removed */
+{
+    Tcl_CmdInfo cmdInfo;
+    Tcl_HashEntry *hPtr;
+
+    /*
+     *  Remove the object from the global list.
+     */
+    hPtr = Tcl_FindHashEntry(&contextIoPtr->infoPtr->objects,
+        (char*)contextIoPtr);
+
+    if (hPtr) {
+        Tcl_DeleteHashEntry(hPtr);
+    }
+    ItclRemoveInstance(contextIoPtr);
+
+    /*
+     *  Change the object's access command so that it can be
+     *  safely deleted without attempting to destruct the object
+     *  again.  Then delete the access command.  If this is
+     *  the last use of the object data, the object will die when
+     *  the caller releases it.
+     */
+    if ((contextIoPtr->accessCmd != NULL) && (!(contextIoPtr->flags &
+            (ITCL_OBJECT_IS_RENAMED)))) {
+    if (Tcl_GetCommandInfoFromToken(contextIoPtr->accessCmd, &cmdInfo) == 1) {
+        cmdInfo.deleteProc = ItclReleaseObject;
+	Tcl_SetCommandInfoFromToken(contextIoPtr->accessCmd, &cmdInfo);
+
+        Tcl_DeleteCommandFromToken(interp, contextIoPtr->accessCmd);
+    }
+    }
+    contextIoPtr->oPtr = NULL;
+    contextIoPtr->accessCmd = NULL;
+    ItclSetObjectNameVars(contextIoPtr);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclDeferObjectDeletion()
+ *
+ *  Takes an object out of reach right away and queues it to be
+ *  destructed and freed later from the event loop, see
+ *  ItclRunDeferredDeletions().  The object is removed from the instance
+ *  list of its class and its access command is moved to the
+ *  ::itcl::internal::deferred namespace.  Right before the destructors
+ *  run, the command gets its original name back, unless that name has
+ *  been taken in the meantime.  If the access command is deleted
+ *  before, e.g. with the class of the object, the object is destructed
+ *  right then and leaves the queue, see ItclForgetDeferredObject().
+ *
+ *  Returns TCL_OK, or TCL_ERROR along with an error message if the
+ *  object is already being deleted.
+ * ------------------------------------------------------------------------
+ */
+int
+ItclDeferObjectDeletion(
+    Tcl_Interp *interp,      /* interpreter mananging object */
+    ItclObject *ioPtr)       /* object to be deleted */
+{
+    ItclObjectInfo *infoPtr = ioPtr->infoPtr;
+    DeferredObject *doPtr;
+    Tcl_Obj *oldNamePtr;
+    char newName[64];
+    int result;
+
+    if (ioPtr->destructorHasBeenCalled
+            || (ioPtr->flags & ITCL_OBJECT_IS_DELETED)
+	    || (ioPtr->accessCmd == NULL)) {
+	Tcl_AppendResult(interp, "can't delete an object while it is ",
+	        "being destructed", NULL);
+        return TCL_ERROR;
+    }
+    if (Tcl_FindNamespace(interp, ITCL_NAMESPACE"::internal::deferred",
+            NULL, 0) == NULL) {
+        if (Tcl_CreateNamespace(interp,
+	        ITCL_NAMESPACE"::internal::deferred", NULL, NULL) == NULL) {
+	    return TCL_ERROR;
+	}
+    }
+    oldNamePtr = Tcl_NewObj();
+    Tcl_IncrRefCount(oldNamePtr);
+    Tcl_GetCommandFullName(interp, ioPtr->accessCmd, oldNamePtr);
+    sprintf(newName, ITCL_NAMESPACE"::internal::deferred::obj%d",
+            infoPtr->deferredCounter++);
+    result = Itcl_RenameCommand(interp, Tcl_GetString(oldNamePtr), newName);
+    if (result != TCL_OK) {
+        Tcl_DecrRefCount(oldNamePtr);
+        return TCL_ERROR;
+    }
+
+    ioPtr->flags |= ITCL_OBJECT_IS_DELETED|ITCL_OBJECT_IS_DEFERRED;
+    ItclPreserveObject(ioPtr);
+    ItclRemoveInstance(ioPtr);
+    ItclDeleteObjectsDictInfo(interp, ioPtr);
+    doPtr = (DeferredObject *)ckalloc(sizeof(DeferredObject));
+    doPtr->ioPtr = ioPtr;
+    doPtr->namePtr = oldNamePtr;
+    ioPtr->deferredElem = Itcl_AppendList(&infoPtr->deferredObjects, doPtr);
+    if (infoPtr->deferredTimer == NULL) {
+        infoPtr->deferredTimer = Tcl_CreateTimerHandler(0,
+	        DeferredDeletionProc, infoPtr);
+    }
+    return TCL_OK;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  DeferredDeletionProc()
+ *
+ *  Timer handler running one slice of deferred object deletions.
+ *  Schedules the next slice if objects are left.
+ * ------------------------------------------------------------------------
+ */
+static void
+DeferredDeletionProc(
+    ClientData clientData)   /* the ItclObjectInfo */
+{
+    ItclObjectInfo *infoPtr = (ItclObjectInfo *)clientData;
+
+    infoPtr->deferredTimer = NULL;
+    ItclRunDeferredDeletions(infoPtr, infoPtr->deferredBudget);
+    if ((infoPtr->deferredTimer == NULL)
+            && (Itcl_GetListLength(&infoPtr->deferredObjects) > 0)) {
+        infoPtr->deferredTimer = Tcl_CreateTimerHandler(0,
+	        DeferredDeletionProc, infoPtr);
+    }
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclRunDeferredDeletions()
+ *
+ *  Destructs and frees objects queued by ItclDeferObjectDeletion(), in
+ *  the order they were queued, until the queue is empty or "budget"
+ *  microseconds have passed.  At least one object is handled.  A
+ *  negative budget handles all objects.  Errors of destructors are
+ *  reported as background errors, the object is removed anyway.
+ *
+ *  Returns the number of objects handled.
+ * ------------------------------------------------------------------------
+ */
+int
+ItclRunDeferredDeletions(
+    ItclObjectInfo *infoPtr,  /* object management info */
+    int budget)               /* time limit in microseconds or -1 */
+{
+    Tcl_Interp *interp = infoPtr->interp;
+    Itcl_InterpState istate;
+    Itcl_ListElem *elem;
+    DeferredObject *doPtr;
+    ItclObject *ioPtr;
+    Tcl_Obj *namePtr;
+    Tcl_Time start;
+    Tcl_Time now;
+    int count;
+    int result;
+
+    Tcl_GetTime(&start);
+    Tcl_Preserve(interp);
+    count = 0;
+    while ((elem = Itcl_FirstListElem(&infoPtr->deferredObjects)) != NULL) {
+        doPtr = (DeferredObject *)Itcl_GetListValue(elem);
+	Itcl_DeleteListElem(elem);
+	ioPtr = doPtr->ioPtr;
+	ioPtr->deferredElem = NULL;
+	if ((ioPtr->accessCmd != NULL)
+	        && !(ioPtr->flags & ITCL_OBJECT_IS_DESTROYED)) {
+	    istate = Itcl_SaveInterpState(interp, TCL_OK);
+
+	    /*
+	     *  Give the object its name back, so that the destructors
+	     *  see it as "this".  If the name is taken by now, the
+	     *  object keeps its name in ::itcl::internal::deferred.
+	     */
+	    if (Tcl_FindCommand(interp, Tcl_GetString(doPtr->namePtr), NULL,
+	            TCL_GLOBAL_ONLY) == NULL) {
+		namePtr = Tcl_NewObj();
+		Tcl_IncrRefCount(namePtr);
+		Tcl_GetCommandFullName(interp, ioPtr->accessCmd, namePtr);
+		if (Itcl_RenameCommand(interp, Tcl_GetString(namePtr),
+		        Tcl_GetString(doPtr->namePtr)) != TCL_OK) {
+		    Tcl_ResetResult(interp);
+		}
+		Tcl_DecrRefCount(namePtr);
+	    }
+	    result = Itcl_DestructObject(interp, ioPtr, 0);
+	    if ((result != TCL_OK) && !Tcl_InterpDeleted(interp)) {
+	        Tcl_AddErrorInfo(interp,
+		        "\n    (deferred deletion of an object)");
+		Tcl_BackgroundException(interp, result);
+	    }
+	    Itcl_RestoreInterpState(interp, istate);
+	    if (ioPtr->accessCmd != NULL) {
+	        ItclRemoveDestructedObject(interp, ioPtr);
+	    }
+	}
+	ItclReleaseObject(ioPtr);
+	Tcl_DecrRefCount(doPtr->namePtr);
+	ckfree((char *)doPtr);
+	count++;
+	if (budget >= 0) {
+	    Tcl_GetTime(&now);
+	    if ((now.sec - start.sec) * 1000000L
+	            + (now.usec - start.usec) >= budget) {
+	        break;
+	    }
+	}
+    }
+    Tcl_Release(interp);
+    return count;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclForgetDeferredObject()
+ *
+ *  Takes an object out of the queue of deferred deletions when it is
+ *  destroyed before its turn, so that it is no longer counted as
+ *  pending.  Releases the claim the queue had on the object.
+ * ------------------------------------------------------------------------
+ */
+static void
+ItclForgetDeferredObject(
+    ItclObject *ioPtr)        /* object destroyed before its turn */
+{
+    DeferredObject *doPtr;
+
+    if (ioPtr->deferredElem == NULL) {
+        return;
+    }
+    doPtr = (DeferredObject *)Itcl_GetListValue(ioPtr->deferredElem);
+    Itcl_DeleteListElem(ioPtr->deferredElem);
+    ioPtr->deferredElem = NULL;
+    Tcl_DecrRefCount(doPtr->namePtr);
+    ckfree((char *)doPtr);
+    ItclReleaseObject(ioPtr);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclCancelDeferredDeletions()
+ *
+ *  Called when [incr Tcl] is removed from an interpreter.  Stops the
+ *  timer and deletes all objects still queued right away.
+ * ------------------------------------------------------------------------
+ */
+void
+ItclCancelDeferredDeletions(
+    ItclObjectInfo *infoPtr)  /* object management info */
+{
+    if (infoPtr->deferredTimer != NULL) {
+        Tcl_DeleteTimerHandler(infoPtr->deferredTimer);
+	infoPtr->deferredTimer = NULL;
+    }
+    ItclRunDeferredDeletions(infoPtr, -1);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclDeleteObjectVariablesNamespace()
+ *
+ * ------------------------------------------------------------------------
+ */
+void
+ItclDeleteObjectVariablesNamespace(
+    Tcl_Interp *interp,
+    ItclObject *ioPtr)
+{
+    Tcl_Namespace *varNsPtr;
+
+    if (ioPtr->callRefCount < 1) {
+        /* free the object's variables namespace and variables in it */
+	ioPtr->flags &= ~ITCL_OBJECT_SHOULD_VARNS_DELETE;
+        varNsPtr = Tcl_FindNamespace(interp, Tcl_GetString(ioPtr->varNsNamePtr),
+	        NULL, 0);
+        if (varNsPtr != NULL) {
+            Tcl_DeleteNamespace(varNsPtr);
+        }
+	if (ioPtr->varTablePtr != NULL) {
+	    Itcl_DeleteVarTable(interp, ioPtr->varTablePtr);
+	    ioPtr->varTablePtr = NULL;
+	}
+    } else {
+        ioPtr->flags |= ITCL_OBJECT_SHOULD_VARNS_DELETE;
+    }
+}
+
+static int
+FinalizeDeleteObject(
+    ClientData data[],
+    Tcl_Interp *interp,
+    int result)
+{
+    ItclObject *contextIoPtr = data[0];
+    if (result == TCL_OK) {
+	ItclDeleteObjectVariablesNamespace(interp, contextIoPtr);
+        Tcl_ResetResult(interp);
+    }
+
+    ItclFreeBaseBits(contextIoPtr->destructed, contextIoPtr->destructedSpace);
+    contextIoPtr->destructed = NULL;
+    return result;
+}
+
+static int
+CallDestructBase(
+    ClientData data[],
+    Tcl_Interp *interp,
+    int result)
 {
     Tcl_Obj *objPtr;
     ItclObject *contextIoPtr = data[0];
@@ -1462,7 +2244,7 @@ Itcl_DestructObject(
     }
     contextIoPtr->flags |= ITCL_OBJECT_IS_DESTRUCTED;
     /*
-     *  If there is a "destructed" table, then this object is already
+     *  If there is a "destructed" bitmap, then this object is already
      *  being destructed.  Flag an error, unless errors are being
      *  ignored.
      */
@@ -1480,13 +2262,13 @@ Itcl_DestructObject(
     if (contextIoPtr->oPtr != NULL) {
         void *callbackPtr;
         /*
-         *  Create a "destructed" table to keep track of which destructors
+         *  Create a "destructed" bitmap to keep track of which destructors
          *  have been invoked.  This is used in ItclDestructBase to make
          *  sure that all base class destructors have been called,
          *  explicitly or implicitly.
          */
-        contextIoPtr->destructed = (Tcl_HashTable*)ckalloc(sizeof(Tcl_HashTable));
-        Tcl_InitObjHashTable(contextIoPtr->destructed);
+        contextIoPtr->destructed = ItclNewBaseBits(contextIoPtr,
+                contextIoPtr->destructedSpace);
 
         /*
          *  Destruct the object starting from the most-specific class.
@@ -1525,8 +2307,10 @@ ItclDestructBase(
     int flags)                  /* flags: ITCL_IGNORE_ERRS */
 {
     int result;
+    int i;
     Itcl_ListElem *elem;
     ItclClass *iclsPtr;
+    ItclInstancePlan *planPtr;
 
     if (contextIoPtr->flags & ITCL_OBJECT_CLASS_DESTRUCTED) {
         return TCL_OK;
@@ -1535,8 +2319,10 @@ ItclDestructBase(
      *  Look for a destructor in this class, and if found,
      *  invoke it.
      */
-    if (Tcl_FindHashEntry(contextIoPtr->destructed,
-            (char *)contextIclsPtr->namePtr) == NULL) {
+    planPtr = ItclGetInstancePlan(contextIoPtr->iclsPtr);
+    i = ItclBaseIndex(contextIoPtr->iclsPtr, contextIclsPtr);
+    if ((i < 0) || (ITCL_BASE_BIT_ISSET(planPtr->hasDestructor, i)
+            && !ITCL_BASE_BIT_ISSET(contextIoPtr->destructed, i))) {
         result = Itcl_InvokeMethodIfExists(interp, "destructor",
             contextIclsPtr, contextIoPtr, 0, (Tcl_Obj* const*)NULL);
         if (result != TCL_OK) {
@@ -1678,30 +2464,319 @@ Itcl_ObjectIsa(
     ItclObject *contextIoPtr, /* object being tested */
     ItclClass *iclsPtr)       /* class to test for "is-a" relationship */
 {
-    Tcl_HashEntry *entry;
-
     if (contextIoPtr == NULL) {
         return 0;
     }
-    entry = Tcl_FindHashEntry(&contextIoPtr->iclsPtr->heritage, (char*)iclsPtr);
-    return (entry != NULL);
+    return ITCL_CLASS_ISA(contextIoPtr->iclsPtr, iclsPtr);
 }
 
 /*
  * ------------------------------------------------------------------------
- *  ItclGetInstanceVar()
+ *  ObjectVarIndex()
+ *
+ *  Returns the index into the objectVars of "ioPtr" that belongs to the
+ *  data member "ivPtr", or -1 if the class of the object has no slot
+ *  for it.  The slots are laid out per class by Itcl_BuildVirtualTables.
+ * ------------------------------------------------------------------------
+ */
+static int
+ObjectVarIndex(
+    ItclObject *ioPtr,
+    ItclVariable *ivPtr)
+{
+    ItclClass *iclsPtr = ioPtr->iclsPtr;
+    int i;
+
+    if (iclsPtr->slotBases == NULL) {
+        return -1;
+    }
+    if (iclsPtr->slotBases[0].iclsPtr == ivPtr->iclsPtr) {
+	/* members added later on to this class go to the end */
+        return iclsPtr->slotBases[0].varOffset + ivPtr->slot;
+    }
+    for (i = 1; i < iclsPtr->numSlotBases; i++) {
+        if (iclsPtr->slotBases[i].iclsPtr == ivPtr->iclsPtr) {
+	    if (ivPtr->slot >= iclsPtr->slotBases[i].numVars) {
+	        return -1;
+	    }
+	    return iclsPtr->slotBases[i].varOffset + ivPtr->slot;
+	}
+    }
+    return -1;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclGetObjectVar()
+ *
+ *  Returns the variable the object "ioPtr" uses for the data member
+ *  "ivPtr", or NULL if the object has none.  Objects with lazy
+ *  variable storage get the variable created, with its initial value,
+ *  on first access.
+ * ------------------------------------------------------------------------
+ */
+Tcl_Var
+ItclGetObjectVar(
+    ItclObject *ioPtr,
+    ItclVariable *ivPtr)
+{
+    Tcl_Var varPtr;
+    int idx;
+
+    idx = ObjectVarIndex(ioPtr, ivPtr);
+    if (idx < 0) {
+        return NULL;
+    }
+    if ((idx < ioPtr->numObjectVars) && (ioPtr->objectVars[idx] != NULL)) {
+        return ioPtr->objectVars[idx];
+    }
+    if (!(ioPtr->flags & ITCL_OBJECT_LAZY_VARS)
+            || (ioPtr->varTablePtr == NULL)
+	    || (ivPtr->flags & ITCL_COMMON)) {
+        return NULL;
+    }
+    varPtr = NewCompactVar(ioPtr, ivPtr, ivPtr->init);
+    ItclSetObjectVar(ioPtr, ivPtr, varPtr);
+    return varPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclSetObjectVar()
+ *
+ *  Makes "varPtr" the variable the object "ioPtr" uses for the data
+ *  member "ivPtr", unless it already has one.  The variable is
+ *  preserved until the object is freed.
+ * ------------------------------------------------------------------------
+ */
+void
+ItclSetObjectVar(
+    ItclObject *ioPtr,
+    ItclVariable *ivPtr,
+    Tcl_Var varPtr)
+{
+    int idx;
+    int numVars;
+
+    idx = ObjectVarIndex(ioPtr, ivPtr);
+    if (idx < 0) {
+        return;
+    }
+    if (idx >= ioPtr->numObjectVars) {
+        numVars = ioPtr->iclsPtr->numObjectVarSlots;
+	if (idx >= numVars) {
+	    numVars = idx + 1;
+	}
+        ioPtr->objectVars = (Tcl_Var *)ckrealloc((char *)ioPtr->objectVars,
+	        numVars * sizeof(Tcl_Var));
+	memset(ioPtr->objectVars + ioPtr->numObjectVars, 0,
+	        (numVars - ioPtr->numObjectVars) * sizeof(Tcl_Var));
+	ioPtr->numObjectVars = numVars;
+    }
+    if (ioPtr->objectVars[idx] == NULL) {
+	Itcl_PreserveVar(varPtr);
+        ioPtr->objectVars[idx] = varPtr;
+    }
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclGetObjectVarValue()
+ *
+ *  Returns the value of the variable the object "ioPtr" uses for the
+ *  data member "ivPtr", or of its element "name2" if that is not NULL.
+ *  Works like Tcl_GetVar2Ex, but needs no qualified name for the
+ *  variable, so objects with compact variable storage don't have to
+ *  create their variable namespaces for it.
+ * ------------------------------------------------------------------------
+ */
+Tcl_Obj *
+ItclGetObjectVarValue(
+    Tcl_Interp *interp,
+    ItclObject *ioPtr,
+    ItclVariable *ivPtr,
+    const char *name2,
+    int flags)
+{
+    return ItclSetObjectVarValue(interp, ioPtr, ivPtr, name2, NULL, flags);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclSetObjectVarValue()
+ *
+ *  Sets the variable the object "ioPtr" uses for the data member
+ *  "ivPtr" (or its element "name2") to "valuePtr" and returns the new
+ *  value like Tcl_SetVar2Ex.  A NULL "valuePtr" only reads the value.
+ * ------------------------------------------------------------------------
+ */
+Tcl_Obj *
+ItclSetObjectVarValue(
+    Tcl_Interp *interp,
+    ItclObject *ioPtr,
+    ItclVariable *ivPtr,
+    const char *name2,
+    Tcl_Obj *valuePtr,
+    int flags)
+{
+    Tcl_CallFrame frame;
+    Tcl_Obj *namePtr;
+    Tcl_Obj *resultPtr;
+    Tcl_Var varPtr;
+    const char *varName;
+
+    varPtr = ItclGetObjectVar(ioPtr, ivPtr);
+    if (varPtr == NULL) {
+        if (flags & TCL_LEAVE_ERR_MSG) {
+	    Tcl_SetObjResult(interp, Tcl_ObjPrintf(
+	            "can't %s \"%s\": no such variable",
+		    (valuePtr == NULL) ? "read" : "set",
+		    Tcl_GetString(ivPtr->namePtr)));
+	}
+        return NULL;
+    }
+    if (name2 == NULL) {
+	/* scalars are accessed through the handle, without any name */
+	if (valuePtr == NULL) {
+	    return Itcl_GetVarObj(interp, varPtr, ivPtr->namePtr, flags);
+	}
+	return Itcl_SetVarObj(interp, varPtr, ivPtr->namePtr, valuePtr,
+	        flags);
+    }
+    if (valuePtr == NULL) {
+	resultPtr = Itcl_GetVarElementValue(varPtr, name2);
+	if (resultPtr != NULL) {
+	    return resultPtr;
+	}
+    }
+    if (!(ioPtr->flags & ITCL_OBJECT_COMPACT_VARS)) {
+	namePtr = Tcl_NewObj();
+	Tcl_IncrRefCount(namePtr);
+	Tcl_GetVariableFullName(interp, varPtr, namePtr);
+	varName = Tcl_GetString(namePtr);
+	if (valuePtr == NULL) {
+	    resultPtr = Tcl_GetVar2Ex(interp, varName, name2, flags);
+	} else {
+	    resultPtr = Tcl_SetVar2Ex(interp, varName, name2, valuePtr,
+	            flags);
+	}
+	Tcl_DecrRefCount(namePtr);
+	return resultPtr;
+    }
+
+    /*
+     *  Compact variables have no name outside of the object, so link
+     *  the variable into a temporary call frame to access it.
+     */
+    if (Itcl_PushCallFrame(interp, &frame, Tcl_GetGlobalNamespace(interp),
+            /*isProcCallFrame*/1) != TCL_OK) {
+        return NULL;
+    }
+    varName = Tcl_GetString(ivPtr->namePtr);
+    resultPtr = NULL;
+    if (Itcl_UpVar(interp, varPtr, varName, 0) == TCL_OK) {
+	if (valuePtr == NULL) {
+	    resultPtr = Tcl_GetVar2Ex(interp, varName, name2, flags);
+	} else {
+	    resultPtr = Tcl_SetVar2Ex(interp, varName, name2, valuePtr,
+	            flags);
+	}
+    }
+    Itcl_PopCallFrame(interp);
+    return resultPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclLinkObjectVarNamespaces()
+ *
+ *  Creates the ::itcl::internal::variables namespaces of an object with
+ *  compact variable storage on demand, for commands like "itcl::scope"
+ *  which have to hand out a qualified variable name.  The namespaces
+ *  only hold links to the object's variables.
+ * ------------------------------------------------------------------------
+ */
+int
+ItclLinkObjectVarNamespaces(
+    Tcl_Interp *interp,
+    ItclObject *ioPtr)
+{
+    Tcl_DString buffer;
+    Tcl_HashEntry *hPtr;
+    Tcl_HashSearch place;
+    Tcl_Namespace *varNsPtr;
+    Tcl_CallFrame frame;
+    Tcl_Var varPtr;
+    ItclClass *iclsPtr2;
+    ItclVariable *ivPtr;
+    int hierIdx;
+    int result;
+
+    if (!(ioPtr->flags & ITCL_OBJECT_COMPACT_VARS)
+            || (ioPtr->flags & ITCL_OBJECT_VARNS_LINKED)
+	    || (ioPtr->varTablePtr == NULL)) {
+        return TCL_OK;
+    }
+    result = TCL_OK;
+    Tcl_DStringInit(&buffer);
+    for (hierIdx = 0; (hierIdx < ioPtr->iclsPtr->numHierarchy)
+            && (result == TCL_OK); hierIdx++) {
+        iclsPtr2 = ioPtr->iclsPtr->hierarchy[hierIdx];
+	Tcl_DStringSetLength(&buffer, 0);
+	Tcl_DStringAppend(&buffer, Tcl_GetString(ioPtr->varNsNamePtr), -1);
+	Tcl_DStringAppend(&buffer, iclsPtr2->nsPtr->fullName, -1);
+	varNsPtr = Tcl_FindNamespace(interp, Tcl_DStringValue(&buffer),
+	        NULL, 0);
+	if (varNsPtr == NULL) {
+	    varNsPtr = Tcl_CreateNamespace(interp, Tcl_DStringValue(&buffer),
+	            NULL, 0);
+	}
+        if ((varNsPtr == NULL) || (Itcl_PushCallFrame(interp, &frame,
+	        varNsPtr, /*isProcCallFrame*/0) != TCL_OK)) {
+	    result = TCL_ERROR;
+	    break;
+	}
+        hPtr = Tcl_FirstHashEntry(&iclsPtr2->variables, &place);
+        while (hPtr) {
+            ivPtr = (ItclVariable*)Tcl_GetHashValue(hPtr);
+	    hPtr = Tcl_NextHashEntry(&place);
+	    if (ivPtr->flags & ITCL_COMMON) {
+	        continue;
+	    }
+	    varPtr = ItclGetObjectVar(ioPtr, ivPtr);
+	    if ((varPtr != NULL) && (Itcl_UpVar(interp, varPtr,
+	            Tcl_GetString(ivPtr->namePtr), TCL_NAMESPACE_ONLY)
+		    != TCL_OK)) {
+		result = TCL_ERROR;
+		break;
+	    }
+	}
+	Itcl_PopCallFrame(interp);
+    }
+    Tcl_DStringFree(&buffer);
+    if (result == TCL_OK) {
+        ioPtr->flags |= ITCL_OBJECT_VARNS_LINKED;
+    }
+    return result;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclGetInstanceVarObj()
  *
  *  Returns the current value for an object data member.  The member
  *  name is interpreted with respect to the given class scope, which
  *  is usually the most-specific class for the object.
  *
- *  If successful, this procedure returns a pointer to a string value
- *  which remains alive until the variable changes it value.  If
- *  anything goes wrong, this returns NULL.
+ *  If successful, this procedure returns the value object of the
+ *  variable, without creating its string representation.  The caller
+ *  must hold a reference to it if the variable may change while the
+ *  value is used.  If anything goes wrong, this returns NULL and
+ *  leaves an error message in the interpreter.
  * ------------------------------------------------------------------------
  */
-const char*
-ItclGetInstanceVar(
+Tcl_Obj*
+ItclGetInstanceVarObj(
     Tcl_Interp *interp,        /* current interpreter */
     const char *name1,         /* name of desired instance variable */
     const char *name2,         /* array element or NULL */
@@ -1716,7 +2791,8 @@ ItclGetInstanceVar(
     ItclClass *iclsPtr;
     ItclVariable *ivPtr;
     ItclVarLookup *vlookup;
-    const char *val;
+    Tcl_Var varPtr;
+    Tcl_Obj *valuePtr;
     int isItclOptions;
     int doAppend;
 
@@ -1747,17 +2823,12 @@ ItclGetInstanceVar(
      *  Install the object context and access the data member
      *  like any other variable.
      */
-    hPtr = Tcl_FindHashEntry(&contextIoPtr->objectVariables, (char *)ivPtr);
-    if (hPtr) {
-	Tcl_Obj *varName = Tcl_NewObj();
-	Tcl_Var varPtr = Tcl_GetHashValue(hPtr);
-	Tcl_GetVariableFullName(interp, varPtr, varName);
-
-	val = Tcl_GetVar2(interp, Tcl_GetString(varName), name2,
+    varPtr = ItclGetObjectVar(contextIoPtr, ivPtr);
+    if (varPtr != NULL) {
+	valuePtr = ItclGetObjectVarValue(interp, contextIoPtr, ivPtr, name2,
 		TCL_LEAVE_ERR_MSG);
-	Tcl_DecrRefCount(varName);
-	if (val) {
-	    return val;
+	if (valuePtr != NULL) {
+	    return valuePtr;
 	}
     }
     }
@@ -1793,16 +2864,46 @@ ItclGetInstanceVar(
     }
     nsPtr = Tcl_FindNamespace(interp, Tcl_DStringValue(&buffer), NULL, 0);
     Tcl_DStringFree(&buffer);
-    val = NULL;
+    valuePtr = NULL;
     if (nsPtr != NULL) {
 	framePtr = &frame;
 	Itcl_PushCallFrame(interp, framePtr, nsPtr, /*isProcCallFrame*/0);
-        val = Tcl_GetVar2(interp, (const char *)name1, (char*)name2,
+        valuePtr = Tcl_GetVar2Ex(interp, (const char *)name1, (char*)name2,
 	        TCL_LEAVE_ERR_MSG);
         Itcl_PopCallFrame(interp);
     }
 
-    return val;
+    return valuePtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclGetInstanceVar()
+ *
+ *  Returns the current value for an object data member like
+ *  ItclGetInstanceVarObj(), but as a string.
+ *
+ *  If successful, this procedure returns a pointer to a string value
+ *  which remains alive until the variable changes it value.  If
+ *  anything goes wrong, this returns NULL.
+ * ------------------------------------------------------------------------
+ */
+const char*
+ItclGetInstanceVar(
+    Tcl_Interp *interp,        /* current interpreter */
+    const char *name1,         /* name of desired instance variable */
+    const char *name2,         /* array element or NULL */
+    ItclObject *contextIoPtr,  /* current object */
+    ItclClass *contextIclsPtr) /* name is interpreted in this scope */
+{
+    Tcl_Obj *valuePtr;
+
+    valuePtr = ItclGetInstanceVarObj(interp, name1, name2, contextIoPtr,
+            contextIclsPtr);
+    if (valuePtr == NULL) {
+        return NULL;
+    }
+    return Tcl_GetString(valuePtr);
 }
 
 /*
@@ -1902,6 +3003,27 @@ Itcl_GetInstanceVar(
     return ItclGetInstanceVar(interp, name, NULL, contextIoPtr,
             contextIclsPtr);
 }
+
+/*
+ * ------------------------------------------------------------------------
+ *  Itcl_GetInstanceVarObj()
+ *
+ *  Returns the value object of an object data member, or NULL if
+ *  anything goes wrong, see ItclGetInstanceVarObj().  The member
+ *  name is interpreted with respect to the given class scope, which
+ *  is usually the most-specific class for the object.
+ * ------------------------------------------------------------------------
+ */
+Tcl_Obj*
+Itcl_GetInstanceVarObj(
+    Tcl_Interp *interp,        /* current interpreter */
+    const char *name,          /* name of desired instance variable */
+    ItclObject *contextIoPtr,  /* current object */
+    ItclClass *contextIclsPtr) /* name is interpreted in this scope */
+{
+    return ItclGetInstanceVarObj(interp, name, NULL, contextIoPtr,
+            contextIclsPtr);
+}
 
 /*
  * ------------------------------------------------------------------------
@@ -1933,6 +3055,7 @@ ItclSetInstanceVar(
     ItclVariable *ivPtr;
     ItclVarLookup *vlookup;
     ItclClass *iclsPtr;
+    Tcl_Var varPtr;
     const char *val;
     int isItclOptions;
     int doAppend;
@@ -1967,16 +3090,16 @@ ItclSetInstanceVar(
      *  like any other variable.
      */
 
-    hPtr = Tcl_FindHashEntry(&contextIoPtr->objectVariables, (char *)ivPtr);
-    if (hPtr) {
-	Tcl_Obj *varName = Tcl_NewObj();
-	Tcl_Var varPtr = Tcl_GetHashValue(hPtr);
-	Tcl_GetVariableFullName(interp, varPtr, varName);
+    varPtr = ItclGetObjectVar(contextIoPtr, ivPtr);
+    if (varPtr != NULL) {
+	Tcl_Obj *valuePtr;
 
-	val = Tcl_SetVar2(interp, Tcl_GetString(varName), name2, value,
-		TCL_LEAVE_ERR_MSG);
-	Tcl_DecrRefCount(varName);
-	return val;
+	valuePtr = ItclSetObjectVarValue(interp, contextIoPtr, ivPtr, name2,
+		Tcl_NewStringObj(value, -1), TCL_LEAVE_ERR_MSG);
+	if (valuePtr == NULL) {
+	    return NULL;
+	}
+	return Tcl_GetString(valuePtr);
     }
 
     isItclOptions = 0;
@@ -2169,17 +3292,89 @@ ItclReportObjectUsage(
 
 /*
  * ------------------------------------------------------------------------
- *  ItclTraceThisVar()
+ *  ItclBuiltinVarValue()
  *
- *  Invoked to handle read/write traces on the "this" variable built
- *  into each object.
+ *  Returns the value of one of the built-in variables "this", "type",
+ *  "self", "selfns" and "win" of an object.  The values are stored
+ *  in the variables when the object is created, and those depending
+ *  on the object name again when it is renamed, so that reading them
+ *  is a plain variable access.  Their traces only guard against
+ *  writes.
+ * ------------------------------------------------------------------------
+ */
+static Tcl_Obj *
+ItclBuiltinVarValue(
+    ItclObject *ioPtr,       /* object owning the variable */
+    ItclVariable *ivPtr)     /* built-in variable */
+{
+    Tcl_DString buffer;
+    Tcl_Obj *objPtr;
+    const char *head;
+    const char *tail;
+
+    objPtr = Tcl_NewStringObj("", -1);
+    if (ivPtr->flags & (ITCL_THIS_VAR|ITCL_SELF_VAR)) {
+        if (ioPtr->accessCmd != NULL) {
+            Tcl_GetCommandFullName(ioPtr->iclsPtr->interp,
+                    ioPtr->accessCmd, objPtr);
+        }
+    } else if (ivPtr->flags & ITCL_TYPE_VAR) {
+        Tcl_SetStringObj(objPtr, ivPtr->iclsPtr->nsPtr->fullName, -1);
+    } else if (ivPtr->flags & ITCL_SELFNS_VAR) {
+        Tcl_AppendObjToObj(objPtr, ioPtr->varNsNamePtr);
+        Tcl_AppendObjToObj(objPtr, ioPtr->iclsPtr->fullNamePtr);
+    } else if (ivPtr->flags & ITCL_WIN_VAR) {
+        /* a window path name must not contain namespace parts !! */
+        Itcl_ParseNamespPath(Tcl_GetString(ioPtr->origNamePtr), &buffer,
+                &head, &tail);
+        if (tail != NULL) {
+            Tcl_SetStringObj(objPtr, tail, -1);
+        }
+        Tcl_DStringFree(&buffer);
+    }
+    return objPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclSetObjectNameVars()
+ *
+ *  Stores the current name of an object in its "this" and "self"
+ *  variables, as listed by the instantiation plan of its class.
+ *  Invoked when the access command of the object is created and
+ *  whenever it is renamed.
+ * ------------------------------------------------------------------------
+ */
+static void
+ItclSetObjectNameVars(
+    ItclObject *ioPtr)       /* object whose name has changed */
+{
+    ItclInstancePlan *planPtr;
+    Tcl_Var varPtr;
+    ItclVariable *ivPtr;
+    int i;
+
+    planPtr = ItclGetInstancePlan(ioPtr->iclsPtr);
+    for (i = 0; i < planPtr->numNameVars; i++) {
+        ivPtr = planPtr->nameVars[i];
+        varPtr = ItclGetObjectVar(ioPtr, ivPtr);
+        if (varPtr != NULL) {
+            Itcl_SetVarValue(varPtr, ItclBuiltinVarValue(ioPtr, ivPtr));
+        }
+    }
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclTraceThisVar()
  *
- *  On read, this procedure updates the "this" variable to contain the
- *  current object name.  This is done dynamically, since an object's
- *  identity can change if its access command is renamed.
+ *  Invoked to handle write traces on the "this" variable built
+ *  into each object.  Its value is kept up to date by
+ *  ItclSetObjectNameVars(), since an object's identity can change
+ *  if its access command is renamed.
  *
- *  On write, this procedure returns an error string, warning that
- *  the "this" variable cannot be set.
+ *  On write, this procedure restores the object name and returns an
+ *  error string, warning that the "this" variable cannot be set.
  * ------------------------------------------------------------------------
  */
 /* ARGSUSED */
@@ -2200,9 +3395,9 @@ ItclTraceThisVar(
      */
 
     /*
-     *  Handle read traces on "this"
+     *  Handle write traces on "this"
      */
-    if ((flags & TCL_TRACE_READS) != 0) {
+    if ((flags & TCL_TRACE_WRITES) != 0) {
         objPtr = Tcl_NewStringObj("", -1);
         if (contextIoPtr->accessCmd) {
             Tcl_GetCommandFullName(contextIoPtr->iclsPtr->interp,
@@ -2212,13 +3407,6 @@ ItclTraceThisVar(
         Tcl_SetVar(interp, (const char *)name1, objName, 0);
 
         Tcl_DecrRefCount(objPtr);
-        return NULL;
-    }
-
-    /*
-     *  Handle write traces on "this"
-     */
-    if ((flags & TCL_TRACE_WRITES) != 0) {
         return "variable \"this\" cannot be modified";
     }
     return NULL;
@@ -2228,15 +3416,12 @@ ItclTraceThisVar(
  * ------------------------------------------------------------------------
  *  ItclTraceWinVar()
  *
- *  Invoked to handle read/write traces on the "win" variable built
- *  into each object.
- *
- *  On read, this procedure updates the "win" variable to contain the
- *  current object name.  This is done dynamically, since an object's
- *  identity can change if its access command is renamed.
+ *  Invoked to handle write traces on the "win" variable built
+ *  into each object.  Its value is set when the object is created.
  *
- *  On write, this procedure returns an error string, warning that
- *  the "win" variable cannot be set.
+ *  On write, this procedure restores the value.  Unless the object
+ *  belongs to an extendedclass, it returns an error string, warning
+ *  that the "win" variable cannot be set.
  * ------------------------------------------------------------------------
  */
 /* ARGSUSED */
@@ -2250,33 +3435,21 @@ ItclTraceWinVar(
 {
     ItclObject *contextIoPtr = (ItclObject*)cdata;
     Tcl_DString buffer;
-    Tcl_Obj *objPtr;
-    const char *objName;
     const char *head;
     const char *tail;
 
     /*
-     *  Handle read traces on "win"
+     *  Handle write traces on "win"
      */
-    if ((flags & TCL_TRACE_READS) != 0) {
-        objPtr = Tcl_NewStringObj("", -1);
+    if ((flags & TCL_TRACE_WRITES) != 0) {
         /* a window path name must not contain namespace parts !! */
         Itcl_ParseNamespPath(Tcl_GetString(contextIoPtr->origNamePtr), &buffer, &head, &tail);
 	if (tail == NULL) {
+	    Tcl_DStringFree(&buffer);
 	    return " INTERNAL ERROR tail == NULL in ItclTraceThisVar for win";
 	}
-        Tcl_SetStringObj(objPtr, tail, -1);
-        objName = Tcl_GetString(objPtr);
-        Tcl_SetVar(interp, (const char *)name1, objName, 0);
-
-        Tcl_DecrRefCount(objPtr);
-        return NULL;
-    }
-
-    /*
-     *  Handle write traces on "win"
-     */
-    if ((flags & TCL_TRACE_WRITES) != 0) {
+        Tcl_SetVar(interp, (const char *)name1, tail, 0);
+	Tcl_DStringFree(&buffer);
         if (!(contextIoPtr->iclsPtr->flags & ITCL_ECLASS)) {
             return "variable \"win\" cannot be modified";
         }
@@ -2288,48 +3461,31 @@ ItclTraceWinVar(
  * ------------------------------------------------------------------------
  *  ItclTraceTypeVar()
  *
- *  Invoked to handle read/write traces on the "type" variable built
- *  into each object.
- *
- *  On read, this procedure updates the "type" variable to contain the
- *  current object name.  This is done dynamically, since an object's
- *  identity can change if its access command is renamed.
+ *  Invoked to handle write traces on the "type" variable built
+ *  into each object.  Its value, the namespace of the class the
+ *  variable belongs to, is set when the object is created, see
+ *  ItclBuiltinVarValue().
  *
- *  On write, this procedure returns an error string, warning that
- *  the "type" variable cannot be set.
+ *  On write, this procedure restores the value and returns an error
+ *  string, warning that the "type" variable cannot be set.
  * ------------------------------------------------------------------------
  */
 /* ARGSUSED */
 static char*
 ItclTraceTypeVar(
-    ClientData cdata,	  /* object instance data */
+    ClientData cdata,	  /* class of the variable */
     Tcl_Interp *interp,	  /* interpreter managing this variable */
     const char *name1,    /* variable name */
     const char *name2,    /* unused */
     int flags)		    /* flags indicating read/write */
 {
-    ItclObject *contextIoPtr = (ItclObject*)cdata;
-    Tcl_Obj *objPtr;
-    const char *objName;
-
-    /*
-     *  Handle read traces on "type"
-     */
-    if ((flags & TCL_TRACE_READS) != 0) {
-        objPtr = Tcl_NewStringObj("", -1);
-        Tcl_SetStringObj(objPtr,
-        Tcl_GetCurrentNamespace(contextIoPtr->iclsPtr->interp)->fullName, -1);
-        objName = Tcl_GetString(objPtr);
-        Tcl_SetVar(interp, (const char *)name1, objName, 0);
-
-        Tcl_DecrRefCount(objPtr);
-        return NULL;
-    }
+    ItclClass *iclsPtr = (ItclClass*)cdata;
 
     /*
      *  Handle write traces on "type"
      */
     if ((flags & TCL_TRACE_WRITES) != 0) {
+        Tcl_SetVar(interp, (const char *)name1, iclsPtr->nsPtr->fullName, 0);
         return "variable \"type\" cannot be modified";
     }
     return NULL;
@@ -2342,12 +3498,13 @@ ItclTraceTypeVar(
  *  Invoked to handle read/write traces on the "self" variable built
  *  into each object.
  *
- *  On read, this procedure updates the "self" variable to contain the
- *  current object name.  This is done dynamically, since an object's
- *  identity can change if its access command is renamed.
+ *  The "self" variable of a widget names its hull once the hull has
+ *  been installed, so on read this procedure updates it for widgets.
+ *  For other objects its value is kept up to date by
+ *  ItclSetObjectNameVars(), and reads are not traced.
  *
- *  On write, this procedure returns an error string, warning that
- *  the "self" variable cannot be set.
+ *  On write, this procedure restores the value and returns an error
+ *  string, warning that the "self" variable cannot be set.
  * ------------------------------------------------------------------------
  */
 /* ARGSUSED */
@@ -2363,35 +3520,29 @@ ItclTraceSelfVar(
     Tcl_Obj *objPtr;
     const char *objName;
 
-    /*
-     *  Handle read traces on "self"
-     */
-    if ((flags & TCL_TRACE_READS) != 0) {
-        objPtr = Tcl_NewStringObj("", -1);
-        if (contextIoPtr->iclsPtr->flags &
-                (ITCL_WIDGET|ITCL_WIDGETADAPTOR)) {
-            const char *objectName;
-
-            objectName = ItclGetInstanceVar(
-                    contextIoPtr->iclsPtr->interp,
-                    "itcl_hull", NULL, contextIoPtr,
-                    contextIoPtr->iclsPtr);
-            if (strlen(objectName) == 0) {
-	        objPtr = contextIoPtr->namePtr;
-	        Tcl_IncrRefCount(objPtr);
-            } else {
-                Tcl_SetStringObj(objPtr, objectName, -1);
-            }
+    objPtr = Tcl_NewStringObj("", -1);
+    if (contextIoPtr->iclsPtr->flags &
+            (ITCL_WIDGET|ITCL_WIDGETADAPTOR)) {
+        const char *objectName;
+
+        objectName = ItclGetInstanceVar(
+                contextIoPtr->iclsPtr->interp,
+                "itcl_hull", NULL, contextIoPtr,
+                contextIoPtr->iclsPtr);
+        if (strlen(objectName) == 0) {
+	    Tcl_DecrRefCount(objPtr);
+	    objPtr = contextIoPtr->namePtr;
+	    Tcl_IncrRefCount(objPtr);
         } else {
-            Tcl_GetCommandFullName(contextIoPtr->iclsPtr->interp,
-                    contextIoPtr->accessCmd, objPtr);
+            Tcl_SetStringObj(objPtr, objectName, -1);
         }
-        objName = Tcl_GetString(objPtr);
-        Tcl_SetVar(interp, (const char *)name1, objName, 0);
-
-        Tcl_DecrRefCount(objPtr);
-        return NULL;
+    } else if (contextIoPtr->accessCmd) {
+        Tcl_GetCommandFullName(contextIoPtr->iclsPtr->interp,
+                contextIoPtr->accessCmd, objPtr);
     }
+    objName = Tcl_GetString(objPtr);
+    Tcl_SetVar(interp, (const char *)name1, objName, 0);
+    Tcl_DecrRefCount(objPtr);
 
     /*
      *  Handle write traces on "self"
@@ -2406,15 +3557,11 @@ ItclTraceSelfVar(
  * ------------------------------------------------------------------------
  *  ItclTraceSelfnsVar()
  *
- *  Invoked to handle read/write traces on the "selfns" variable built
- *  into each object.
- *
- *  On read, this procedure updates the "selfns" variable to contain the
- *  current object name.  This is done dynamically, since an object's
- *  identity can change if its access command is renamed.
+ *  Invoked to handle write traces on the "selfns" variable built
+ *  into each object.  Its value is set when the object is created.
  *
- *  On write, this procedure returns an error string, warning that
- *  the "selfns" variable cannot be set.
+ *  On write, this procedure restores the value and returns an error
+ *  string, warning that the "selfns" variable cannot be set.
  * ------------------------------------------------------------------------
  */
 /* ARGSUSED */
@@ -2431,9 +3578,9 @@ ItclTraceSelfnsVar(
     const char *objName;
 
     /*
-     *  Handle read traces on "selfns"
+     *  Handle write traces on "selfns"
      */
-    if ((flags & TCL_TRACE_READS) != 0) {
+    if ((flags & TCL_TRACE_WRITES) != 0) {
         objPtr = Tcl_NewStringObj("", -1);
         Tcl_SetStringObj(objPtr, Tcl_GetString(contextIoPtr->varNsNamePtr), -1);
         Tcl_AppendToObj(objPtr,
@@ -2442,69 +3589,11 @@ ItclTraceSelfnsVar(
         Tcl_SetVar(interp, (const char *)name1, objName, 0);
 
         Tcl_DecrRefCount(objPtr);
-        return NULL;
-    }
-
-    /*
-     *  Handle write traces on "selfns"
-     */
-    if ((flags & TCL_TRACE_WRITES) != 0) {
         return "variable \"selfns\" cannot be modified";
     }
     return NULL;
 }
-
-/*
- * ------------------------------------------------------------------------
- *  ItclTraceOptionVar()
- *
- *  Invoked to handle read/write traces on "option" variables
- *
- *  On read, this procedure checks if there is a cgetMethodPtr and calls it
- *  On write, this procedure checks if there is a configureMethodPtr
- *  or validateMethodPtr and calls it
- * ------------------------------------------------------------------------
- */
-/* ARGSUSED */
-static char*
-ItclTraceOptionVar(
-    ClientData cdata,	    /* object instance data */
-    Tcl_Interp *interp,	    /* interpreter managing this variable */
-    const char *name1,      /* variable name */
-    const char *name2,      /* unused */
-    int flags)		    /* flags indicating read/write */
-{
-    ItclObject *ioPtr;
-    ItclOption *ioptPtr;
 
-/* FIXME !!! */
-/* don't know yet if ItclTraceOptionVar is really needed !! */
-/* FIXME should free memory on unset or rename!! */
-    if (cdata != NULL) {
-        ioPtr = (ItclObject*)cdata;
-	if (ioPtr == NULL) {
-	}
-    } else {
-        ioptPtr = (ItclOption*)cdata;
-	if (ioptPtr == NULL) {
-	}
-        /*
-         *  Handle read traces "itcl_options"
-         */
-        if ((flags & TCL_TRACE_READS) != 0) {
-            return NULL;
-        }
-    
-        /*
-         *  Handle write traces "itcl_options"
-         */
-        if ((flags & TCL_TRACE_WRITES) != 0) {
-            return NULL;
-        }
-    }
-    return NULL;
-}
-
 /*
  * ------------------------------------------------------------------------
  *  ItclTraceComponentVar()
@@ -2531,7 +3620,7 @@ ItclTraceComponentVar(
     ItclObject *ioPtr;
     ItclComponent *icPtr;
     ItclDelegatedFunction *idmPtr;
-    const char *val;
+    int valueLen;
 
 /* FIXME should free memory on unset or rename!! */
     if (cdata != NULL) {
@@ -2544,7 +3633,8 @@ ItclTraceComponentVar(
 	    return NULL;
 	}
         objPtr = Tcl_NewStringObj(name1, -1);
-	hPtr = Tcl_FindHashEntry(&ioPtr->objectComponents, (char *)objPtr);
+	hPtr = Tcl_FindHashEntry(
+                ITCL_OBJECT_TABLE(ioPtr, objectComponents), (char *)objPtr);
         Tcl_DecrRefCount(objPtr);
 
         /*
@@ -2559,16 +3649,19 @@ ItclTraceComponentVar(
                 return " INTERNAL ERROR cannot get component to write to";
             }
             icPtr = Tcl_GetHashValue(hPtr);
-	    val = ItclGetInstanceVar(interp, name1, NULL, ioPtr,
-                    ioPtr->iclsPtr);
-	    if ((val == NULL) || (strlen(val) == 0)) {
+	    componentValuePtr = ItclGetInstanceVarObj(interp, name1, NULL,
+	            ioPtr, ioPtr->iclsPtr);
+	    valueLen = 0;
+	    if (componentValuePtr != NULL) {
+	        Tcl_GetStringFromObj(componentValuePtr, &valueLen);
+	    }
+	    if (valueLen == 0) {
 	        return " INTERNAL ERROR cannot get value for component";
 	    }
-	    componentValuePtr = Tcl_NewStringObj(val, -1);
             Tcl_IncrRefCount(componentValuePtr);
 	    namePtr = Tcl_NewStringObj(name1, -1);
             FOREACH_HASH_VALUE(idmPtr, &ioPtr->iclsPtr->delegatedFunctions) {
-                if (idmPtr->icPtr == icPtr) {
+                if ((idmPtr->icPtr == icPtr) && (idmPtr->usingPtr != NULL)) {
 		    hPtr2 = Tcl_FindHashEntry(&idmPtr->exceptions,
 		            (char *)namePtr);
                     if (hPtr2 == NULL) {
@@ -2730,8 +3823,10 @@ ItclDestroyObject(
         if (hPtr) {
             Tcl_DeleteHashEntry(hPtr);
         }
+        ItclRemoveInstance(contextIoPtr);
         contextIoPtr->accessCmd = NULL;
     }
+    ItclForgetDeferredObject(contextIoPtr);
     ItclReleaseObject(contextIoPtr);
 }
 
@@ -2748,11 +3843,9 @@ static void
 ItclFreeObject(
     char * cdata)  /* object instance data */
 {
-    FOREACH_HASH_DECLS;
-    Tcl_HashSearch place;
-    ItclCallContext *callContextPtr;
     ItclObject *ioPtr;
-    Tcl_Var var;
+    ItclClass *iclsPtr;
+    int i;
     
     ioPtr = (ItclObject*)cdata;
 
@@ -2768,39 +3861,45 @@ ItclFreeObject(
      *    from below.
      */
 
-    ItclReleaseClass(ioPtr->iclsPtr);
+    ItclRemoveInstance(ioPtr);
     if (ioPtr->constructed) {
-        Tcl_DeleteHashTable(ioPtr->constructed);
-        ckfree((char*)ioPtr->constructed);
+        ItclFreeBaseBits(ioPtr->constructed, ioPtr->constructedSpace);
     }
     if (ioPtr->destructed) {
-        Tcl_DeleteHashTable(ioPtr->destructed);
-        ckfree((char*)ioPtr->destructed);
+        ItclFreeBaseBits(ioPtr->destructed, ioPtr->destructedSpace);
     }
     ItclDeleteObjectsDictInfo(ioPtr->interp, ioPtr);
     /*
      *  Delete all context definitions.
      */
-    while (1) {
-        hPtr = Tcl_FirstHashEntry(&ioPtr->contextCache, &place);
-        if (hPtr == NULL) {
-            break;
-        }
-        callContextPtr = Tcl_GetHashValue(hPtr);
-	Tcl_DeleteHashEntry(hPtr);
-        ckfree((char *)callContextPtr);
+    if (ioPtr->callContexts != NULL) {
+        for (i = 0; i < ioPtr->numCallContexts; i++) {
+	    if (ioPtr->callContexts[i] != NULL) {
+                ckfree((char *)ioPtr->callContexts[i]);
+	    }
+	}
+        ckfree((char *)ioPtr->callContexts);
     }
-    FOREACH_HASH_VALUE(var, &ioPtr->objectVariables) {
-	Itcl_ReleaseVar(var);
+    if (ioPtr->varTablePtr != NULL) {
+        Itcl_DeleteVarTable(ioPtr->interp, ioPtr->varTablePtr);
+    }
+    if (ioPtr->objectVars != NULL) {
+        for (i = 0; i < ioPtr->numObjectVars; i++) {
+	    if (ioPtr->objectVars[i] != NULL) {
+	        Itcl_ReleaseVar(ioPtr->objectVars[i]);
+	    }
+	}
+        ckfree((char *)ioPtr->objectVars);
+    }
+    if (ioPtr->tablesPtr != NULL) {
+        Tcl_DeleteHashTable(&ioPtr->tablesPtr->objectOptions);
+        Tcl_DeleteHashTable(&ioPtr->tablesPtr->objectComponents);
+        Tcl_DeleteHashTable(&ioPtr->tablesPtr->objectMethodVariables);
+        Tcl_DeleteHashTable(&ioPtr->tablesPtr->objectDelegatedOptions);
+        Tcl_DeleteHashTable(&ioPtr->tablesPtr->objectDelegatedFunctions);
+        ckfree((char *)ioPtr->tablesPtr);
+	ioPtr->tablesPtr = NULL;
     }
-
-    Tcl_DeleteHashTable(&ioPtr->contextCache);
-    Tcl_DeleteHashTable(&ioPtr->objectVariables);
-    Tcl_DeleteHashTable(&ioPtr->objectOptions);
-    Tcl_DeleteHashTable(&ioPtr->objectComponents);
-    Tcl_DeleteHashTable(&ioPtr->objectMethodVariables);
-    Tcl_DeleteHashTable(&ioPtr->objectDelegatedOptions);
-    Tcl_DeleteHashTable(&ioPtr->objectDelegatedFunctions);
     Tcl_DecrRefCount(ioPtr->namePtr);
     Tcl_DecrRefCount(ioPtr->origNamePtr);
     if (ioPtr->createNamePtr != NULL) {
@@ -2814,9 +3913,17 @@ ItclFreeObject(
 	ckfree((char *)ioPtr->resolvePtr->clientData);
         ckfree((char*)ioPtr->resolvePtr);
     }
+    iclsPtr = ioPtr->iclsPtr;
     ckfree((char*)ioPtr);
+    ItclReleaseClass(iclsPtr);
 }
 
+/*
+ *  Number of arguments ItclObjectCmd passes on without allocating
+ *  memory for the argument vector.
+ */
+#define NUM_STATIC_OBJV 8
+
 /*
  * ------------------------------------------------------------------------
  *  ItclObjectCmd()
@@ -2824,23 +3931,6 @@ ItclFreeObject(
  * ------------------------------------------------------------------------
  */
 
-static int
-CallPublicObjectCmd(
-    ClientData data[],
-    Tcl_Interp *interp,
-    int result)
-{
-    Tcl_Object *oPtr = data[0];
-    Tcl_Class clsPtr = data[1];
-    Tcl_Obj *const* objv = data[3];
-    int objc = PTR2INT(data[2]);
-
-    ItclShowArgs(1, "CallPublicObjectCmd", objc, objv);
-    result = Itcl_PublicObjectCmd(oPtr, interp, clsPtr, objc, objv);
-    ItclShowArgs(1, "CallPublicObjectCmd DONE", objc, objv);
-    return result;
-}
-
 int
 ItclObjectCmd(
     ClientData clientData,
@@ -2852,8 +3942,8 @@ ItclObjectCmd(
 {
     Tcl_Obj *methodNamePtr;
     Tcl_Obj **newObjv;
+    Tcl_Obj *staticObjv[NUM_STATIC_OBJV];
     Tcl_DString buffer;
-    Tcl_Obj *myPtr;
     ItclMemberFunc *imPtr;
     ItclClass *iclsPtr;
     Itcl_ListElem *elem;
@@ -2866,13 +3956,14 @@ ItclObjectCmd(
     int incr;
     int result;
     int found;
+    int freeMethodName;
 
     ItclShowArgs(1, "ItclObjectCmd", objc, objv);
 
     incr = 0;
     found = 0;
     isDirectCall = 0;
-    myPtr = NULL;
+    freeMethodName = 0;
     imPtr = (ItclMemberFunc *)clientData;
     iclsPtr = imPtr->iclsPtr;
     if (oPtr == NULL) {
@@ -2897,10 +3988,17 @@ ItclObjectCmd(
     }
     methodNamePtr = NULL;
     if (objv[0] != NULL) {
-        Itcl_ParseNamespPath(Tcl_GetString(objv[0]), &buffer,
-	        &className, &tail);
+	/* only qualified names need to be split up */
+	if (strstr(Tcl_GetString(objv[0]), "::") != NULL) {
+            Itcl_ParseNamespPath(Tcl_GetString(objv[0]), &buffer,
+	            &className, &tail);
+	} else {
+	    className = NULL;
+	}
         if (className != NULL) {
             methodNamePtr = Tcl_NewStringObj(tail, -1);
+            Tcl_IncrRefCount(methodNamePtr);
+	    freeMethodName = 1;
 	    /* look for the class in the hierarchy */
 	    cp = className;
 	    if ((*cp == ':') && (*(cp+1) == ':')) {
@@ -2929,8 +4027,8 @@ ItclObjectCmd(
 		found = 1;
 		clsPtr = iclsPtr->clsPtr;
 	    }
+            Tcl_DStringFree(&buffer);
         }
-        Tcl_DStringFree(&buffer);
     } else {
 	/* Can this happen? */
 	Tcl_Panic("objv[0] is NULL?!");
@@ -2943,8 +4041,9 @@ ItclObjectCmd(
     }
     if (isDirectCall) {
 	if (!found) {
-	    if (methodNamePtr != NULL) {
+	    if (freeMethodName) {
 	        Tcl_DecrRefCount(methodNamePtr);
+		freeMethodName = 0;
 	    }
             methodNamePtr = objv[0];
         }
@@ -2952,76 +4051,72 @@ ItclObjectCmd(
     callbackPtr = Itcl_GetCurrentCallbackPtr(interp);
     newObjv = NULL;
     if (methodNamePtr != NULL) {
-	if (iclsPtr->flags & (ITCL_TYPE|ITCL_WIDGETADAPTOR)) {
-	    char *myName;
-	    /* special handling for mytypemethod, mymethod, myproc */
-	    myName = Tcl_GetString(methodNamePtr);
-	    if (strcmp(myName, "mytypemethod") == 0) {
+	if ((iclsPtr->flags & (ITCL_TYPE|ITCL_WIDGETADAPTOR))
+	        && (imPtr->flags & ITCL_BI_DISPATCH)) {
+	    /* special handling for mytypemethod, mymethod, myproc ... */
+	    switch (imPtr->flags & ITCL_BI_DISPATCH) {
+	    case ITCL_BI_MYTYPEMETHOD:
                 result = Itcl_BiMyTypeMethodCmd(iclsPtr, interp, objc, objv);
-		return result;
-	    }
-	    if (strcmp(myName, "mymethod") == 0) {
+		break;
+	    case ITCL_BI_MYMETHOD:
                 result = Itcl_BiMyMethodCmd(iclsPtr, interp, objc, objv);
-		return result;
-	    }
-	    if (strcmp(myName, "myproc") == 0) {
+		break;
+	    case ITCL_BI_MYPROC:
                 result = Itcl_BiMyProcCmd(iclsPtr, interp, objc, objv);
-		return result;
-	    }
-	    if (strcmp(myName, "mytypevar") == 0) {
+		break;
+	    case ITCL_BI_MYTYPEVAR:
                 result = Itcl_BiMyTypeVarCmd(iclsPtr, interp, objc, objv);
-		return result;
-	    }
-	    if (strcmp(myName, "myvar") == 0) {
+		break;
+	    case ITCL_BI_MYVAR:
                 result = Itcl_BiMyVarCmd(iclsPtr, interp, objc, objv);
-		return result;
-	    }
-	    if (strcmp(myName, "itcl_hull") == 0) {
+		break;
+	    case ITCL_BI_ITCL_HULL:
                 result = Itcl_BiItclHullCmd(iclsPtr, interp, objc, objv);
-		return result;
-	    }
-	    if (strcmp(myName, "callinstance") == 0) {
+		break;
+	    case ITCL_BI_CALLINSTANCE:
                 result = Itcl_BiCallInstanceCmd(iclsPtr, interp, objc, objv);
-		return result;
-	    }
-	    if (strcmp(myName, "getinstancevar") == 0) {
+		break;
+	    case ITCL_BI_GETINSTANCEVAR:
                 result = Itcl_BiGetInstanceVarCmd(iclsPtr, interp, objc, objv);
-		return result;
+		break;
+	    default:
+                result = Itcl_BiInstallComponentCmd(iclsPtr, interp,
+		        objc, objv);
+		break;
 	    }
-	    if (strcmp(myName, "installcomponent") == 0) {
-                result = Itcl_BiInstallComponentCmd(iclsPtr, interp, objc, objv);
-		return result;
+	    if (freeMethodName) {
+	        Tcl_DecrRefCount(methodNamePtr);
 	    }
+	    return result;
 	}
         incr = 1;
-        newObjv = (Tcl_Obj **)ckalloc(sizeof(Tcl_Obj *)*(objc+incr));
-        myPtr = Tcl_NewStringObj("my", 2);
-        Tcl_IncrRefCount(myPtr);
-        Tcl_IncrRefCount(methodNamePtr);
-        newObjv[0] = myPtr;
+	if (objc + incr <= NUM_STATIC_OBJV) {
+	    newObjv = staticObjv;
+	} else {
+            newObjv = (Tcl_Obj **)ckalloc(sizeof(Tcl_Obj *)*(objc+incr));
+	}
+        newObjv[0] = iclsPtr->infoPtr->myPtr;
         newObjv[1] = methodNamePtr;
         memcpy(newObjv+incr+1, objv+1, (sizeof(Tcl_Obj*)*(objc-1)));
 	ItclShowArgs(1, "run CallPublicObjectCmd1", objc+incr, newObjv);
-	Tcl_NRAddCallback(interp, CallPublicObjectCmd, oPtr, clsPtr,
-	        INT2PTR(objc+incr), newObjv);
-
+	result = Itcl_PublicObjectCmd(oPtr, interp, clsPtr, objc+incr,
+	        newObjv);
     } else {
 	ItclShowArgs(1, "run CallPublicObjectCmd2", objc, objv);
-	Tcl_NRAddCallback(interp, CallPublicObjectCmd, oPtr, clsPtr,
-		INT2PTR(objc), (ClientData)objv);
+	result = Itcl_PublicObjectCmd(oPtr, interp, clsPtr, objc, objv);
     }
 
-    result = Itcl_NRRunCallbacks(interp, callbackPtr);
-    if (methodNamePtr != NULL) {
+    /* run the callbacks TclOO left for the method invocation */
+    result = Itcl_NRRunCallbacksResult(interp, result, callbackPtr);
+    if ((newObjv != NULL) && (newObjv != staticObjv)) {
         ckfree((char *)newObjv);
-        Tcl_DecrRefCount(methodNamePtr);
     }
-    if (myPtr != NULL) {
-        Tcl_DecrRefCount(myPtr);
+    if (freeMethodName) {
+        Tcl_DecrRefCount(methodNamePtr);
     }
     return result;
 }
-
+
 /*
  * ------------------------------------------------------------------------
  *  GetClassFromClassName()
@@ -3092,6 +4187,150 @@ GetClassFromClassName(
     return iclsPtr;
 }
 
+/*
+ * ------------------------------------------------------------------------
+ *  FindMethodNameCache()
+ *
+ *  Looks for the result of an earlier mapping of the unqualified
+ *  method name "methodObj" for the object "ioPtr", called from the
+ *  current namespace.  One lookup in the class's name cache replaces
+ *  the parsing and the hash lookups in ItclMapMethodNameProc.  Returns
+ *  the entry for the calling namespace, which is only valid if "*validPtr"
+ *  is set, or NULL if there is none.
+ * ------------------------------------------------------------------------
+ */
+
+static ItclMethodNameCache *
+FindMethodNameCache(
+    Tcl_Interp *interp,
+    ItclObject *ioPtr,
+    Tcl_Obj *methodObj,
+    int *validPtr)
+{
+    ItclClass *iclsPtr;
+    ItclMethodNameCache *cachePtr;
+    Tcl_HashEntry *hPtr;
+    Namespace *nsPtr;
+    int isMethodFrame;
+
+    *validPtr = 0;
+    iclsPtr = ioPtr->iclsPtr;
+    if (iclsPtr->methodNameCache == NULL) {
+        return NULL;
+    }
+    hPtr = Tcl_FindHashEntry(iclsPtr->methodNameCache,
+            Tcl_GetString(methodObj));
+    if (hPtr == NULL) {
+        return NULL;
+    }
+    nsPtr = (Namespace *)Tcl_GetCurrentNamespace(interp);
+    isMethodFrame = Itcl_IsMethodCallFrame(interp);
+    cachePtr = (ItclMethodNameCache *)Tcl_GetHashValue(hPtr);
+    while ((cachePtr != NULL) && ((cachePtr->nsId != nsPtr->nsId) ||
+            (cachePtr->isMethodFrame != isMethodFrame))) {
+        cachePtr = cachePtr->nextPtr;
+    }
+    if ((cachePtr == NULL) ||
+            (cachePtr->generation != iclsPtr->generation) ||
+            (cachePtr->classEpoch != iclsPtr->infoPtr->classEpoch)) {
+        return cachePtr;
+    }
+    /* lookupClsPtr is still alive, as the class epoch did not change */
+    if (cachePtr->lookupGeneration == cachePtr->lookupClsPtr->generation) {
+        *validPtr = 1;
+    }
+    return cachePtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  AddMethodNameCache()
+ *
+ *  Remembers the result of mapping the unqualified method name
+ *  "methodObj" for the object "ioPtr", see FindMethodNameCache().
+ *  "cachePtr" is the outdated entry for the calling namespace returned
+ *  by FindMethodNameCache() or NULL.  Outdated entries are reused, so
+ *  only the first mapping of a name from a namespace allocates.
+ * ------------------------------------------------------------------------
+ */
+
+static void
+AddMethodNameCache(
+    Tcl_Interp *interp,
+    ItclObject *ioPtr,
+    Tcl_Obj *methodObj,
+    ItclMethodNameCache *cachePtr,
+    ItclClass *lookupClsPtr,
+    int found)
+{
+    ItclClass *iclsPtr;
+    Tcl_HashEntry *hPtr;
+    int isNew;
+
+    iclsPtr = ioPtr->iclsPtr;
+    if (cachePtr == NULL) {
+        if (iclsPtr->numMethodNameCache >= ITCL_METHOD_NAME_CACHE_SIZE) {
+            ItclFreeMethodNameCache(iclsPtr);
+        }
+        if (iclsPtr->methodNameCache == NULL) {
+            iclsPtr->methodNameCache = (Tcl_HashTable *)ckalloc(
+                    sizeof(Tcl_HashTable));
+            Tcl_InitHashTable(iclsPtr->methodNameCache, TCL_STRING_KEYS);
+        }
+        hPtr = Tcl_CreateHashEntry(iclsPtr->methodNameCache,
+                Tcl_GetString(methodObj), &isNew);
+        cachePtr = (ItclMethodNameCache *)ckalloc(
+                sizeof(ItclMethodNameCache));
+        cachePtr->nextPtr = isNew ? NULL
+                : (ItclMethodNameCache *)Tcl_GetHashValue(hPtr);
+        Tcl_SetHashValue(hPtr, cachePtr);
+        cachePtr->nsId = ((Namespace *)Tcl_GetCurrentNamespace(interp))->nsId;
+        cachePtr->isMethodFrame = Itcl_IsMethodCallFrame(interp);
+        iclsPtr->numMethodNameCache++;
+    }
+    cachePtr->generation = iclsPtr->generation;
+    cachePtr->classEpoch = iclsPtr->infoPtr->classEpoch;
+    cachePtr->lookupClsPtr = lookupClsPtr;
+    cachePtr->lookupGeneration = lookupClsPtr->generation;
+    cachePtr->found = found;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclFreeMethodNameCache()
+ *
+ *  Releases the method name cache of a class.
+ * ------------------------------------------------------------------------
+ */
+
+void
+ItclFreeMethodNameCache(
+    ItclClass *iclsPtr)
+{
+    Tcl_HashEntry *hPtr;
+    Tcl_HashSearch place;
+    ItclMethodNameCache *cachePtr;
+    ItclMethodNameCache *nextPtr;
+
+    if (iclsPtr->methodNameCache == NULL) {
+        return;
+    }
+    hPtr = Tcl_FirstHashEntry(iclsPtr->methodNameCache, &place);
+    while (hPtr != NULL) {
+        cachePtr = (ItclMethodNameCache *)Tcl_GetHashValue(hPtr);
+        while (cachePtr != NULL) {
+            nextPtr = cachePtr->nextPtr;
+            ckfree((char *)cachePtr);
+            cachePtr = nextPtr;
+        }
+        hPtr = Tcl_NextHashEntry(&place);
+    }
+    Tcl_DeleteHashTable(iclsPtr->methodNameCache);
+    ckfree((char *)iclsPtr->methodNameCache);
+    iclsPtr->methodNameCache = NULL;
+    iclsPtr->numMethodNameCache = 0;
+}
+
 /*
  * ------------------------------------------------------------------------
  *  ItclMapMethodNameProc()
@@ -3117,14 +4356,29 @@ ItclMapMethodNameProc(
     const char *head;
     const char *tail;
     const char *sp;
+    ItclMethodNameCache *cachePtr;
+    int cacheable;
+    int valid;
 
+    cachePtr = NULL;
+    ioPtr = (ItclObject *)Tcl_ObjectGetMetadata(oPtr,
+            &itclObjectMetadataType);
+    if ((ioPtr != NULL) && !(ioPtr->flags & (ITCL_OBJECT_IS_DELETED|
+            ITCL_OBJECT_IS_DESTRUCTED|ITCL_OBJECT_IS_DESTROYED))) {
+        cachePtr = FindMethodNameCache(interp, ioPtr, methodObj, &valid);
+        if (valid) {
+            if (!cachePtr->found) {
+                *startClsPtr = NULL;
+            }
+            return TCL_OK;
+        }
+    }
+    cacheable = 0;
     iclsPtr = NULL;
     iclsPtr2 = NULL;
     methodName = NULL;
     infoPtr = (ItclObjectInfo *)Tcl_GetAssocData(interp,
             ITCL_INTERP_DATA, NULL);
-    ioPtr = (ItclObject *)Tcl_ObjectGetMetadata(oPtr,
-            infoPtr->object_meta_type);
     hPtr = Tcl_FindHashEntry(&infoPtr->objects, (char *)ioPtr);
     if ((hPtr == NULL) || (ioPtr == NULL)) {
         /* try to get the class (if a class is creating an object) */
@@ -3146,6 +4400,8 @@ ItclMapMethodNameProc(
             return TCL_ERROR;
 	}
         iclsPtr = ioPtr->iclsPtr;
+        cacheable = !(ioPtr->flags & (ITCL_OBJECT_IS_DELETED|
+                ITCL_OBJECT_IS_DESTRUCTED|ITCL_OBJECT_IS_DESTROYED));
     }
     sp = Tcl_GetString(methodObj);
     Itcl_ParseNamespPath(sp, &buffer, &head, &tail);
@@ -3190,6 +4446,10 @@ ItclMapMethodNameProc(
 	 * fossil ticket id: 36577626c340ad59615f0a0238d67872c009a8c9
 	 */
         *startClsPtr = NULL;
+        if (cacheable && (head == NULL)) {
+            AddMethodNameCache(interp, ioPtr, methodObj, cachePtr,
+                    iclsPtr, 0);
+        }
     } else {
 	ItclMemberFunc *imPtr;
 	Tcl_Namespace *nsPtr;
@@ -3255,6 +4515,9 @@ ItclMapMethodNameProc(
 
                 }
             }
+        } else if (cacheable && (head == NULL)) {
+            AddMethodNameCache(interp, ioPtr, methodObj, cachePtr,
+                    iclsPtr, 1);
         }
     }
     Tcl_DStringFree(&buffer);
@@ -3491,6 +4754,124 @@ ExpandDelegateAs(
     return TCL_OK;
 }
 
+/*
+ * ------------------------------------------------------------------------
+ *  DelegatedMethodCall()
+ *
+ *  Invoked by TclOO for a method delegated to a component without
+ *  "using".  Works like a forwarded method, but takes the target
+ *  from the component variable of the object on each call, so the
+ *  method is installed once per class and follows changes of the
+ *  component.  The command name of the component is resolved through
+ *  the value of the variable, which caches the command until the
+ *  variable is set to something else or the command goes away.
+ * ------------------------------------------------------------------------
+ */
+static int
+DelegatedMethodCall(
+    ClientData clientData,   /* the ItclDelegatedFunction */
+    Tcl_Interp *interp,      /* current interpreter */
+    Tcl_ObjectContext context, /* the method call context */
+    int objc,                /* number of arguments */
+    Tcl_Obj *const *objv)    /* argument objects */
+{
+    ItclDelegatedFunction *idmPtr = (ItclDelegatedFunction *)clientData;
+    Tcl_Object oPtr;
+    Tcl_Obj *newObjvStorage[8];
+    Tcl_Obj **newObjv;
+    Tcl_Obj **asObjv;
+    Tcl_Obj *componentPtr;
+    ItclObject *ioPtr;
+    int asObjc;
+    int newObjc;
+    int skip;
+    int isRootEnsemble;
+    int componentLen;
+    int result;
+    int i;
+
+    oPtr = Tcl_ObjectContextObject(context);
+    ioPtr = (ItclObject *)Tcl_ObjectGetMetadata(oPtr,
+            &itclObjectMetadataType);
+    componentPtr = NULL;
+    componentLen = 0;
+    if (ioPtr != NULL) {
+        componentPtr = ItclGetObjectVarValue(interp, ioPtr,
+	        idmPtr->icPtr->ivPtr, NULL, 0);
+    }
+    if (componentPtr != NULL) {
+	Tcl_GetStringFromObj(componentPtr, &componentLen);
+    }
+    if (componentLen == 0) {
+	Tcl_ResetResult(interp);
+        Tcl_AppendResult(interp, "component \"",
+	        Tcl_GetString(idmPtr->icPtr->namePtr),
+		"\" is not initialized", NULL);
+        return TCL_ERROR;
+    }
+    if (idmPtr->asPtr != NULL) {
+        if (Tcl_ListObjGetElements(interp, idmPtr->asPtr,
+	        &asObjc, &asObjv) != TCL_OK) {
+            return TCL_ERROR;
+        }
+    } else {
+        asObjc = 1;
+        asObjv = &idmPtr->namePtr;
+    }
+    skip = Tcl_ObjectContextSkippedArgs(context);
+    newObjc = 1 + asObjc + objc - skip;
+    newObjv = newObjvStorage;
+    if (newObjc > (int)(sizeof(newObjvStorage)/sizeof(Tcl_Obj *))) {
+        newObjv = (Tcl_Obj **)ckalloc(sizeof(Tcl_Obj *) * newObjc);
+    }
+
+    /*
+     *  The component value and the words of "as" belong to the variable
+     *  and the delegation, which may both change while the command runs.
+     */
+    newObjv[0] = componentPtr;
+    memcpy(newObjv+1, asObjv, sizeof(Tcl_Obj *) * asObjc);
+    for (i = 0; i <= asObjc; i++) {
+        Tcl_IncrRefCount(newObjv[i]);
+    }
+    memcpy(newObjv+1+asObjc, objv+skip, sizeof(Tcl_Obj *) * (objc-skip));
+    ItclShowArgs(1, "DELEGATED METHOD", newObjc, newObjv);
+    isRootEnsemble = Itcl_InitRewriteEnsemble(interp, skip, 1 + asObjc,
+            objc, objv);
+    result = Itcl_EvalForwardObjv(interp, Tcl_GetObjectNamespace(oPtr),
+            newObjc, newObjv);
+    Itcl_ResetRewriteEnsemble(interp, isRootEnsemble);
+    for (i = 0; i <= asObjc; i++) {
+        Tcl_DecrRefCount(newObjv[i]);
+    }
+    if (newObjv != newObjvStorage) {
+        ckfree((char *)newObjv);
+    }
+    return result;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclInstallDelegatedMethod()
+ *
+ *  Makes a method delegated to a component without "using" known to
+ *  TclOO as a method of the class.  This is done once when the class
+ *  definition is finished, and for methods delegated later on.
+ * ------------------------------------------------------------------------
+ */
+int
+ItclInstallDelegatedMethod(
+    Tcl_Interp *interp,
+    ItclClass *iclsPtr,
+    ItclDelegatedFunction *idmPtr)
+{
+    if (Tcl_NewMethod(interp, iclsPtr->clsPtr, idmPtr->namePtr, 1,
+            &itclDelegatedMethodType, (ClientData)idmPtr) == NULL) {
+        return TCL_ERROR;
+    }
+    return TCL_OK;
+}
+
 /*
  * ------------------------------------------------------------------------
  *  DelegationFunction()
@@ -3510,6 +4891,9 @@ DelegateFunction(
     int result;
     Tcl_Method mPtr;
 
+    if ((idmPtr->usingPtr == NULL) && (idmPtr->icPtr != NULL)) {
+        return ItclInstallDelegatedMethod(interp, iclsPtr, idmPtr);
+    }
     listPtr = Tcl_NewListObj(0, NULL);
     if (componentValuePtr != NULL) {
 	if (idmPtr->usingPtr == NULL) {
@@ -3678,6 +5062,10 @@ DelegationInstall(
     noDelegate = ITCL_CONSTRUCTOR|ITCL_DESTRUCTOR|ITCL_COMPONENT;
     componentValuePtr = NULL;
     FOREACH_HASH_VALUE(idmPtr, &iclsPtr->delegatedFunctions) {
+	if ((idmPtr->usingPtr == NULL) && (idmPtr->icPtr != NULL)) {
+	    /* the class has a method for it, see DelegatedMethodCall */
+	    continue;
+	}
 	methodName = Tcl_GetString(idmPtr->namePtr);
 	if (*methodName == '*') {
 	    delegateAll = 1;
@@ -3811,12 +5199,11 @@ ItclInitExtendedClassOptions(
 {
     ItclClass *iclsPtr;
     ItclOption *ioptPtr;
-    ItclHierIter hier;
+    int hierIdx;
     FOREACH_HASH_DECLS;
 
-    iclsPtr = ioPtr->iclsPtr;
-    Itcl_InitHierIter(&hier, iclsPtr);
-    while ((iclsPtr = Itcl_AdvanceHierIter(&hier)) != NULL) {
+    for (hierIdx = 0; hierIdx < ioPtr->iclsPtr->numHierarchy; hierIdx++) {
+        iclsPtr = ioPtr->iclsPtr->hierarchy[hierIdx];
         FOREACH_HASH_VALUE(ioptPtr, &iclsPtr->options) {
             if (ioptPtr->defaultValuePtr != NULL) {
 		if (ItclGetInstanceVar(interp, "itcl_options",
@@ -3826,7 +5213,6 @@ ItclInitExtendedClassOptions(
             }
 	}
     }
-    Itcl_DeleteHierIter(&hier);
     return TCL_OK;
 }
 
@@ -124,6 +124,7 @@ static Tcl_ObjCmdProc Itcl_ClassTypeVariableCmd;
 static Tcl_ObjCmdProc Itcl_ClassTypeMethodCmd;
 static Tcl_ObjCmdProc Itcl_ClassFilterCmd;
 static Tcl_ObjCmdProc Itcl_ClassMixinCmd;
+static Tcl_ObjCmdProc Itcl_ClassVarStorageCmd;
 static Tcl_ObjCmdProc Itcl_WidgetCmd;
 static Tcl_ObjCmdProc Itcl_WidgetAdaptorCmd;
 static Tcl_ObjCmdProc Itcl_ClassComponentCmd;
@@ -159,6 +160,7 @@ static const struct {
     {"typemethod", Itcl_ClassTypeMethodCmd},
     {"typevariable", Itcl_ClassTypeVariableCmd},
     {"variable", Itcl_ClassVariableCmd},
+    {"varstorage", Itcl_ClassVarStorageCmd},
     {"widgetclass", Itcl_ClassWidgetClassCmd},
     {NULL, NULL}
 };
@@ -296,7 +298,7 @@ Itcl_ParseInit(
     Itcl_PreserveData((ClientData)infoPtr);
 
     if (Itcl_AddEnsemblePart(interp, "::itcl::delete",
-            "object", "name ?name...?",
+            "object", "?-deferred? ?--? name ?name...?",
             Itcl_DelObjectCmd,
             (ClientData)infoPtr, Itcl_ReleaseData) != TCL_OK) {
         return TCL_ERROR;
@@ -311,6 +313,57 @@ Itcl_ParseInit(
     }
     Itcl_PreserveData((ClientData)infoPtr);
 
+    /*
+     *  Create the "itcl::deferred" command to control deferred
+     *  object deletion.
+     */
+    if (Itcl_CreateEnsemble(interp, "::itcl::deferred") != TCL_OK) {
+        return TCL_ERROR;
+    }
+
+    if (Itcl_AddEnsemblePart(interp, "::itcl::deferred",
+            "budget", "?microseconds?", Itcl_DeferredBudgetCmd,
+            (ClientData)infoPtr, Itcl_ReleaseData) != TCL_OK) {
+        return TCL_ERROR;
+    }
+    Itcl_PreserveData((ClientData)infoPtr);
+
+    if (Itcl_AddEnsemblePart(interp, "::itcl::deferred",
+            "flush", "", Itcl_DeferredFlushCmd,
+            (ClientData)infoPtr, Itcl_ReleaseData) != TCL_OK) {
+        return TCL_ERROR;
+    }
+    Itcl_PreserveData((ClientData)infoPtr);
+
+    if (Itcl_AddEnsemblePart(interp, "::itcl::deferred",
+            "pending", "", Itcl_DeferredPendingCmd,
+            (ClientData)infoPtr, Itcl_ReleaseData) != TCL_OK) {
+        return TCL_ERROR;
+    }
+    Itcl_PreserveData((ClientData)infoPtr);
+
+    /*
+     *  Create the "itcl::memory" command to report the memory
+     *  used by objects.
+     */
+    if (Itcl_CreateEnsemble(interp, "::itcl::memory") != TCL_OK) {
+        return TCL_ERROR;
+    }
+
+    if (Itcl_AddEnsemblePart(interp, "::itcl::memory",
+            "class", "className", Itcl_MemoryClassCmd,
+            (ClientData)infoPtr, Itcl_ReleaseData) != TCL_OK) {
+        return TCL_ERROR;
+    }
+    Itcl_PreserveData((ClientData)infoPtr);
+
+    if (Itcl_AddEnsemblePart(interp, "::itcl::memory",
+            "object", "objName", Itcl_MemoryObjectCmd,
+            (ClientData)infoPtr, Itcl_ReleaseData) != TCL_OK) {
+        return TCL_ERROR;
+    }
+    Itcl_PreserveData((ClientData)infoPtr);
+
     /*
      *  Create the "itcl::is" command to test object
      *  and classes existence.
@@ -333,6 +386,13 @@ Itcl_ParseInit(
     }
     Itcl_PreserveData((ClientData)infoPtr);
 
+    /*
+     *  Create the "itcl::new" command to create objects in bulk.
+     */
+    Tcl_CreateObjCommand(interp, "::itcl::new", Itcl_NewCmd,
+        (ClientData)infoPtr, Itcl_ReleaseData);
+    Itcl_PreserveData((ClientData)infoPtr);
+
 
     /*
      *  Add "code" and "scope" commands for handling scoped values.
@@ -737,6 +797,7 @@ ItclClassBaseCmd(
     int result;
     int noCleanup;
     ItclMemberFunc *imPtr;
+    ItclDelegatedFunction *idmPtr;
 
     infoPtr = (ItclObjectInfo*)clientData;
     if (iclsPtrPtr != NULL) {
@@ -1099,6 +1160,17 @@ if (imPtr->codePtr->flags & ITCL_IMPLEMENT_OBJCMD) {
 		ItclPreserveIMF(imPtr);
 	    }
     }
+
+    /* make the methods delegated to components known to TclOO */
+    FOREACH_HASH_VALUE(idmPtr, &iclsPtr->delegatedFunctions) {
+	if ((idmPtr->usingPtr == NULL) && (idmPtr->icPtr != NULL)) {
+	    if (ItclInstallDelegatedMethod(interp, iclsPtr, idmPtr)
+	            != TCL_OK) {
+		result = TCL_ERROR;
+		goto errorReturn;
+	    }
+	}
+    }
     if (iclsPtr->flags & (ITCL_TYPE|ITCL_WIDGETADAPTOR)) {
 	/* initialize the typecomponents and typevariables */
         if (Itcl_PushCallFrame(interp, &frame, iclsPtr->nsPtr,
@@ -1293,7 +1365,6 @@ Itcl_ClassInheritCmd(
     ItclClass *iclsPtr = (ItclClass*)Itcl_PeekStack(&infoPtr->clsStack);
     int result;
     int i;
-    int newEntry;
     int haveClasses;
     const char *token;
     Itcl_ListElem *elem;
@@ -1301,7 +1372,6 @@ Itcl_ClassInheritCmd(
     ItclClass *cdPtr;
     ItclClass *baseClsPtr;
     ItclClass *badCdPtr;
-    ItclHierIter hier;
     Itcl_Stack stack;
     Tcl_CallFrame frame;
     Tcl_DString buffer;
@@ -1424,29 +1494,16 @@ Itcl_ClassInheritCmd(
      *  the heritage for the current class.  Along the way, make
      *  sure that no class appears twice in the heritage.
      */
-    Itcl_InitHierIter(&hier, iclsPtr);
-    cdPtr = Itcl_AdvanceHierIter(&hier);  /* skip the class itself */
-    cdPtr = Itcl_AdvanceHierIter(&hier);
-    while (cdPtr != NULL) {
-        (void) Tcl_CreateHashEntry(&iclsPtr->heritage,
-            (char*)cdPtr, &newEntry);
-
-        if (!newEntry) {
-            break;
-        }
-        cdPtr = Itcl_AdvanceHierIter(&hier);
-    }
-    Itcl_DeleteHierIter(&hier);
+    badCdPtr = ItclBuildHierarchy(iclsPtr);
 
     /*
      *  Same base class found twice in the hierarchy?
      *  Then flag error.  Show the list of multiple paths
      *  leading to the same base class.
      */
-    if (!newEntry) {
+    if (badCdPtr != NULL) {
         Tcl_Obj *resultPtr = Tcl_GetObjResult(interp);
 
-        badCdPtr = cdPtr;
         Tcl_AppendStringsToObj(resultPtr,
             "class \"", Tcl_GetString(iclsPtr->fullNamePtr),
 	    "\" inherits base class \"",
@@ -1541,6 +1598,7 @@ inheritError:
 	ItclReleaseClass( (ItclClass *)Itcl_GetListValue(elem) );
         elem = Itcl_DeleteListElem(elem);
     }
+    ItclBuildHierarchy(iclsPtr);
     return TCL_ERROR;
 }
 
@@ -2070,11 +2128,9 @@ Itcl_ClassVariableCmd(
     if (iclsPtr->flags & (ITCL_TYPE|ITCL_WIDGET|ITCL_WIDGETADAPTOR)) {
         ivPtr->flags |= ITCL_VARIABLE;
     }
-    if (haveArrayInit) {
-        ivPtr->arrayInitPtr = Tcl_NewStringObj(arrayInitStr, -1);
-        Tcl_IncrRefCount(ivPtr->arrayInitPtr);
-    } else {
-        ivPtr->arrayInitPtr = NULL;
+    if (ItclSetVariableArrayInit(interp, ivPtr,
+            haveArrayInit ? arrayInitStr : NULL) != TCL_OK) {
+        return TCL_ERROR;
     }
     iclsPtr->numVariables++;
     ItclAddClassVariableDictInfo(interp, iclsPtr, ivPtr);
@@ -2155,12 +2211,12 @@ ItclInitClassCommon(
     Itcl_BuildVirtualTables(iclsPtr);
 
     if (initStr != NULL) {
-	const char *val;
+	Tcl_Obj *val;
         Tcl_DStringAppend(&buffer, "::", -1);
         Tcl_DStringAppend(&buffer, Tcl_GetString(ivPtr->namePtr), -1);
-        val = Tcl_SetVar(interp,
-	        Tcl_DStringValue(&buffer), initStr,
-                TCL_NAMESPACE_ONLY);
+        val = Tcl_SetVar2Ex(interp, Tcl_DStringValue(&buffer), NULL,
+	        (ivPtr->init != NULL) ? ivPtr->init
+		: Tcl_NewStringObj(initStr, -1), TCL_NAMESPACE_ONLY);
 
         if (!val) {
             Tcl_AppendStringsToObj(Tcl_GetObjResult(interp),
@@ -2170,18 +2226,15 @@ ItclInitClassCommon(
             return TCL_ERROR;
         }
     }
-    if (ivPtr->arrayInitPtr != NULL) {
+    if (ivPtr->arrayInitv != NULL) {
 	int i;
-	int argc;
-	const char **argv;
-	const char *val;
+	Tcl_Obj *val;
         Tcl_DStringAppend(&buffer, "::", -1);
         Tcl_DStringAppend(&buffer, Tcl_GetString(ivPtr->namePtr), -1);
-	result = Tcl_SplitList(interp, Tcl_GetString(ivPtr->arrayInitPtr),
-	        &argc, &argv);
-	for (i = 0; i < argc; i++) {
-            val = Tcl_SetVar2(interp, Tcl_DStringValue(&buffer), argv[i],
-                    argv[i + 1], TCL_NAMESPACE_ONLY);
+	for (i = 0; i < ivPtr->arrayInitc; i += 2) {
+            val = Tcl_SetVar2Ex(interp, Tcl_DStringValue(&buffer),
+	            Tcl_GetString(ivPtr->arrayInitv[i]),
+                    ivPtr->arrayInitv[i + 1], TCL_NAMESPACE_ONLY);
             if (!val) {
                 Tcl_AppendStringsToObj(Tcl_GetObjResult(interp),
                     "cannot initialize common variable \"",
@@ -2189,9 +2242,7 @@ ItclInitClassCommon(
                     (char*)NULL);
                 return TCL_ERROR;
             }
-	    i++;
         }
-        ckfree((char *)argv);
     }
     Tcl_DStringFree(&buffer);
     return result;
@@ -2290,11 +2341,9 @@ ItclClassCommonCmd(
     if (protection != 0) {
         ivPtr->protection = protection;
     }
-    if (haveArrayInit) {
-        ivPtr->arrayInitPtr = Tcl_NewStringObj(arrayInitStr, -1);
-        Tcl_IncrRefCount(ivPtr->arrayInitPtr);
-    } else {
-        ivPtr->arrayInitPtr = NULL;
+    if (ItclSetVariableArrayInit(interp, ivPtr,
+            haveArrayInit ? arrayInitStr : NULL) != TCL_OK) {
+        return TCL_ERROR;
     }
     *ivPtrPtr = ivPtr;
     result =  ItclInitClassCommon(interp, iclsPtr, ivPtr, initStr);
@@ -2417,6 +2466,9 @@ ItclDelObjectInfo(
     Tcl_DeleteHashTable(&infoPtr->objects);
 
     Itcl_DeleteStack(&infoPtr->clsStack);
+    if (infoPtr->frameContexts != NULL) {
+        ckfree((char *)infoPtr->frameContexts);
+    }
 /* FIXME !!!
  free class_meta_type and object_meta_type
 */
@@ -2494,6 +2546,79 @@ Itcl_ClassMixinCmd(
     ItclShowArgs(0, "Itcl_ClassMixinCmd", objc, objv);
     return TCL_OK;
 }
+
+/*
+ * ------------------------------------------------------------------------
+ *  Itcl_ClassVarStorageCmd()
+ *
+ *  Invoked by Tcl during the parsing of a class definition whenever
+ *  the "varstorage" command is invoked to select where the instance
+ *  variables of the objects of this class are kept:
+ *
+ *    varstorage namespace|compact|lazy
+ *
+ *  With "compact" the variables are owned by the object itself and
+ *  the per-class variable namespaces are only created when a command
+ *  like "itcl::scope" needs a variable name.  "lazy" is like "compact",
+ *  but also creates each variable only when it is accessed first.
+ *  "namespace" keeps the classic storage even if lazy storage is
+ *  turned on for all classes by the ITCL_LAZY_VARS environment
+ *  variable.
+ *
+ *  Returns TCL_OK/TCL_ERROR to indicate success/failure.
+ * ------------------------------------------------------------------------
+ */
+static int
+Itcl_ClassVarStorageCmd(
+    ClientData clientData,   /* info for all known objects */
+    Tcl_Interp *interp,      /* current interpreter */
+    int objc,                /* number of arguments */
+    Tcl_Obj *const objv[])   /* argument objects */
+{
+    static const char *storageNames[] = {
+        "compact", "lazy", "namespace", NULL
+    };
+    ItclObjectInfo *infoPtr;
+    ItclClass *iclsPtr;
+    int idx;
+
+    ItclShowArgs(1, "Itcl_ClassVarStorageCmd", objc, objv);
+    infoPtr = (ItclObjectInfo*)clientData;
+    iclsPtr = (ItclClass*)Itcl_PeekStack(&infoPtr->clsStack);
+    if (iclsPtr == NULL) {
+        Tcl_AppendResult(interp, "Error: ::itcl::parser::varstorage called",
+	        " from not within a class", NULL);
+        return TCL_ERROR;
+    }
+    if (!(iclsPtr->flags & ITCL_CLASS)) {
+        Tcl_AppendResult(interp, "\"", Tcl_GetString(iclsPtr->namePtr),
+	        "\" is no ::itcl::class. Only these can have a varstorage",
+		NULL);
+	return TCL_ERROR;
+    }
+    if (objc != 2) {
+        Tcl_WrongNumArgs(interp, 1, objv, "namespace|compact|lazy");
+        return TCL_ERROR;
+    }
+    if (Tcl_GetIndexFromObj(interp, objv[1], storageNames, "storage", 0,
+            &idx) != TCL_OK) {
+        return TCL_ERROR;
+    }
+    iclsPtr->flags &= ~(ITCL_CLASS_COMPACT_VARS|ITCL_CLASS_LAZY_VARS
+            |ITCL_CLASS_NAMESPACE_VARS);
+    switch (idx) {
+    case 0:
+        iclsPtr->flags |= ITCL_CLASS_COMPACT_VARS;
+	break;
+    case 1:
+        iclsPtr->flags |= ITCL_CLASS_COMPACT_VARS|ITCL_CLASS_LAZY_VARS;
+	break;
+    default:
+        iclsPtr->flags |= ITCL_CLASS_NAMESPACE_VARS;
+	break;
+    }
+    return TCL_OK;
+}
 
 /*
  * ------------------------------------------------------------------------
@@ -2660,7 +2785,8 @@ ItclParseOption(
     }
     if (ioPtr != NULL) {
         /* check for already delegated!! */
-        hPtr = Tcl_FindHashEntry(&ioPtr->objectDelegatedOptions,
+        hPtr = Tcl_FindHashEntry(
+                ITCL_OBJECT_TABLE(ioPtr, objectDelegatedOptions),
 	        (char *)objv[1]);
 	if (hPtr != NULL) {
 	    Tcl_AppendResult(interp, "cannot define option \"", optionName,
@@ -3335,11 +3461,11 @@ Itcl_HandleDelegateMethodCmd(
     Tcl_HashEntry *hPtr;
     ItclClass *iclsPtr2;
     ItclComponent *icPtr;
-    ItclHierIter hier;
     const char *usageStr;
     const char *methodName;
     const char *component;
     const char *token;
+    int hierIdx;
     int result;
     int i;
     int foundOpt;
@@ -3410,8 +3536,9 @@ delegate method * ?to <componentName>? ?using <pattern>? ?except <methods>?";
     /* check for already delegated */
     methodNamePtr = Tcl_NewStringObj(methodName, -1);
     if (ioPtr != NULL) {
-        hPtr = Tcl_FindHashEntry(&ioPtr->objectDelegatedFunctions, (char *)
-                methodNamePtr);
+        hPtr = Tcl_FindHashEntry(
+                ITCL_OBJECT_TABLE(ioPtr, objectDelegatedFunctions),
+                (char *)methodNamePtr);
     } else {
         hPtr = Tcl_FindHashEntry(&iclsPtr->delegatedFunctions, (char *)
                 methodNamePtr);
@@ -3420,28 +3547,28 @@ delegate method * ?to <componentName>? ?using <pattern>? ?except <methods>?";
     hPtr = NULL;
     if (ioPtr != NULL) {
 	if (componentPtr != NULL) {
-            Itcl_InitHierIter(&hier, ioPtr->iclsPtr);
-	    while ((iclsPtr = Itcl_AdvanceHierIter(&hier)) != NULL) {
-	        hPtr = Tcl_FindHashEntry(&iclsPtr->components,
+	    iclsPtr = NULL;
+	    for (hierIdx = 0; hierIdx < ioPtr->iclsPtr->numHierarchy;
+	            hierIdx++) {
+	        iclsPtr2 = ioPtr->iclsPtr->hierarchy[hierIdx];
+	        hPtr = Tcl_FindHashEntry(&iclsPtr2->components,
 	                (char *)componentPtr);
                 if (hPtr != NULL) {
+	            iclsPtr = iclsPtr2;
 	            break;
 	        }
 	    }
-	    Itcl_DeleteHierIter(&hier);
         }
     } else {
 	if (componentPtr != NULL) {
-	    iclsPtr2 = iclsPtr;
-            Itcl_InitHierIter(&hier, iclsPtr2);
-	    while ((iclsPtr2 = Itcl_AdvanceHierIter(&hier)) != NULL) {
+	    for (hierIdx = 0; hierIdx < iclsPtr->numHierarchy; hierIdx++) {
+	        iclsPtr2 = iclsPtr->hierarchy[hierIdx];
 	        hPtr = Tcl_FindHashEntry(&iclsPtr2->components,
 	                (char *)componentPtr);
                 if (hPtr != NULL) {
 	            break;
 	        }
 	    }
-	    Itcl_DeleteHierIter(&hier);
         }
     }
     if (hPtr == NULL) {
@@ -3572,7 +3699,6 @@ Itcl_HandleDelegateOptionCmd(
     ItclComponent *icPtr;
     ItclClass *iclsPtr2;
     ItclDelegatedOption *idoPtr;
-    ItclHierIter hier;
     const char *usageStr;
     const char *option;
     const char *component;
@@ -3580,6 +3706,7 @@ Itcl_HandleDelegateOptionCmd(
     const char **argv;
     int foundOpt;
     int argc;
+    int hierIdx;
     int isStarOption;
     int isNew;
     int i;
@@ -3704,8 +3831,9 @@ Itcl_HandleDelegateOptionCmd(
     allOptionNamePtr = Tcl_NewStringObj("*", -1);
     Tcl_IncrRefCount(allOptionNamePtr);
     if (ioPtr != NULL) {
-        hPtr = Tcl_FindHashEntry(&ioPtr->objectDelegatedOptions, (char *)
-                allOptionNamePtr);
+        hPtr = Tcl_FindHashEntry(
+                ITCL_OBJECT_TABLE(ioPtr, objectDelegatedOptions),
+                (char *)allOptionNamePtr);
     } else {
         hPtr = Tcl_FindHashEntry(&iclsPtr->delegatedOptions, (char *)
                 allOptionNamePtr);
@@ -3718,25 +3846,25 @@ Itcl_HandleDelegateOptionCmd(
     }
 
     if (ioPtr != NULL) {
-        Itcl_InitHierIter(&hier, ioPtr->iclsPtr);
-	while ((iclsPtr = Itcl_AdvanceHierIter(&hier)) != NULL) {
-	    hPtr = Tcl_FindHashEntry(&iclsPtr->components,
+	iclsPtr = NULL;
+	for (hierIdx = 0; hierIdx < ioPtr->iclsPtr->numHierarchy; hierIdx++) {
+	    iclsPtr2 = ioPtr->iclsPtr->hierarchy[hierIdx];
+	    hPtr = Tcl_FindHashEntry(&iclsPtr2->components,
 	            (char *)componentPtr);
             if (hPtr != NULL) {
+	        iclsPtr = iclsPtr2;
 	        break;
 	    }
 	}
-	Itcl_DeleteHierIter(&hier);
     } else {
-        Itcl_InitHierIter(&hier, iclsPtr);
-	while ((iclsPtr2 = Itcl_AdvanceHierIter(&hier)) != NULL) {
+	for (hierIdx = 0; hierIdx < iclsPtr->numHierarchy; hierIdx++) {
+	    iclsPtr2 = iclsPtr->hierarchy[hierIdx];
             hPtr = Tcl_FindHashEntry(&iclsPtr2->components,
 	            (char *)componentPtr);
             if (hPtr != NULL) {
 	        break;
 	    }
 	}
-	Itcl_DeleteHierIter(&hier);
     }
     if (hPtr == NULL) {
 	if (componentPtr != NULL) {
@@ -3755,11 +3883,11 @@ Itcl_HandleDelegateOptionCmd(
 	/* FIXME !!! */
         /* check for valid option name */
 	if (ioPtr != NULL) {
-	    hPtr = Tcl_FindHashEntry(&ioPtr->objectOptions,
+	    hPtr = Tcl_FindHashEntry(ITCL_OBJECT_TABLE(ioPtr, objectOptions),
 	            (char *)optionNamePtr);
 	} else {
-            Itcl_InitHierIter(&hier, iclsPtr);
-	    while ((iclsPtr2 = Itcl_AdvanceHierIter(&hier)) != NULL) {
+	    for (hierIdx = 0; hierIdx < iclsPtr->numHierarchy; hierIdx++) {
+	        iclsPtr2 = iclsPtr->hierarchy[hierIdx];
 	        hPtr = Tcl_FindHashEntry(&iclsPtr2->options,
 		        (char *)optionNamePtr);
                 if (hPtr != NULL) {
@@ -4078,6 +4206,7 @@ delegate typemethod * ?to <componentName>? ?using <pattern>? ?except <typemethod
     hPtr = Tcl_CreateHashEntry(&iclsPtr->delegatedFunctions,
             (char *)idmPtr->namePtr, &isNew);
     if (!isNew) {
+        ItclForgetDictInfo(iclsPtr, Tcl_GetHashValue(hPtr));
         ItclDeleteDelegatedFunction((ItclDelegatedFunction *)
 	        Tcl_GetHashValue(hPtr));
     }
@@ -246,6 +246,7 @@ Itcl_ClassVarResolver(
     ItclObject *contextIoPtr;
     Tcl_HashEntry *hPtr;
     ItclVarLookup *vlookup;
+    Tcl_Var objVarPtr;
 
     contextIoPtr = NULL;
     /*
@@ -322,12 +323,16 @@ Itcl_ClassVarResolver(
                 }
             }
         }
-        hPtr = Tcl_FindHashEntry(&contextIoPtr->objectVariables,
-                (char *)vlookup->ivPtr);
+        objVarPtr = ItclGetObjectVar(contextIoPtr, vlookup->ivPtr);
 
-    if (hPtr == NULL) {
+    if (objVarPtr == NULL) {
         return TCL_CONTINUE;
     }
+    if (contextIoPtr->flags & ITCL_OBJECT_COMPACT_VARS) {
+        /* compact objects have no variable namespaces to look into */
+        *rPtr = objVarPtr;
+        return TCL_OK;
+    }
     if (strcmp(name, "this") == 0) {
         Tcl_Var varPtr;
         Tcl_DString buffer;
@@ -383,11 +388,8 @@ Itcl_ClassVarResolver(
 	    return TCL_OK;
         }
     }
-    if (hPtr != NULL) {
-        *rPtr = Tcl_GetHashValue(hPtr);
-        return TCL_OK;
-    }
-    return TCL_CONTINUE;
+    *rPtr = objVarPtr;
+    return TCL_OK;
 }
 
 
@@ -499,6 +501,7 @@ ItclClassRuntimeVarResolver(
     ItclClass *iclsPtr;
     ItclObject *contextIoPtr;
     Tcl_HashEntry *hPtr;
+    Tcl_Var objVarPtr;
 
     /*
      *  If this is a common data member, then the associated
@@ -536,8 +539,10 @@ ItclClassRuntimeVarResolver(
 	        }
 	    }
         }
-        hPtr = Tcl_FindHashEntry(&contextIoPtr->objectVariables,
-                (char *)vlookup->ivPtr);
+        objVarPtr = ItclGetObjectVar(contextIoPtr, vlookup->ivPtr);
+        if (contextIoPtr->flags & ITCL_OBJECT_COMPACT_VARS) {
+	    return objVarPtr;
+        }
         if (strcmp(Tcl_GetString(vlookup->ivPtr->namePtr), "this") == 0) {
             Tcl_Var varPtr;
             Tcl_DString buffer;
@@ -594,10 +599,7 @@ ItclClassRuntimeVarResolver(
 	        return varPtr;
             }
         }
-        if (hPtr != NULL) {
-            return (Tcl_Var)Tcl_GetHashValue(hPtr);
-        }
-    return NULL;
+    return objVarPtr;
 }
 
 /*
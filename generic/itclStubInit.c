@@ -198,6 +198,10 @@ static const ItclIntStubs itclIntStubs = {
     Itcl_SetContext, /* 182 */
     Itcl_UnsetContext, /* 183 */
     ItclGetInstanceVar, /* 184 */
+    Itcl_CreateObjects, /* 185 */
+    0, /* 186 */
+    ItclGetInstanceVarObj, /* 187 */
+    Itcl_GetInstanceVarObj, /* 188 */
 };
 
 static const ItclStubHooks itclStubHooks = {
@@ -997,10 +997,7 @@ Itcl_CanAccess2(
 	}
 	fromIclsPtr = Tcl_GetHashValue(entry);
 
-        entry = Tcl_FindHashEntry(&fromIclsPtr->heritage,
-	        (char*)iclsPtr);
-
-        if (entry) {
+        if (ITCL_CLASS_ISA(fromIclsPtr, iclsPtr)) {
             return 1;
         }
     }
@@ -1080,7 +1077,7 @@ Itcl_CanAccessFunc(
 	}
         fromIclsPtr = Tcl_GetHashValue(hPtr);
 
-        if (Tcl_FindHashEntry(&iclsPtr->heritage, (char*)fromIclsPtr)) {
+        if (ITCL_CLASS_ISA(iclsPtr, fromIclsPtr)) {
             entry = Tcl_FindHashEntry(&fromIclsPtr->resolveCmds,
                 (char *)imPtr->namePtr);
 